@@ -0,0 +1,326 @@
+# For licensing see accompanying LICENSE file.
+# Copyright (C) 2026 Apple Inc. All Rights Reserved.
+
+"""
+Stream Latency Benchmark
+
+Measures how long a streamed snapshot takes to travel from the native stream
+loop to the consumer's ``async for``, through the ctypes callback, the queue
+and the polling loop of the Python streaming path.
+
+The benchmark writes a trace of scripted streams that emit a snapshot every
+``1 / rate`` seconds and serves it with the replay backend (see
+:func:`apple_fm_sdk.replay_traffic`), so it needs neither the model nor the
+native library and runs the same way on macOS and on Linux CI. Each snapshot
+is timestamped where the backend hands it to the C callback, which is the
+point where the Swift stream loop would emit it, and again where the consumer
+receives it.
+
+For every combination of API, emit rate and concurrency it reports:
+
+* Delivery lag: time from emit to the consumer receiving the snapshot
+* Inter-chunk jitter: how far each gap between received snapshots differs
+  from the gap between their emits, as a histogram
+* Emit jitter: how far the gaps between emits deviate from ``1 / rate``, the
+  timing noise of the replay backend rather than of the streaming path
+* Dropped: snapshots emitted but never received
+
+Usage::
+
+    python benchmarks/stream_latency.py
+    python benchmarks/stream_latency.py --api response --rates 100 1000 --concurrency 1 8
+    python benchmarks/stream_latency.py --max-lag-p99 20 --max-jitter-p99 20 --json results.json
+
+With ``--max-lag-p99`` or ``--max-jitter-p99`` the benchmark exits with status
+1 if any scenario exceeds the limit, so it can gate changes to the streaming
+path.
+"""
+
+import argparse
+import asyncio
+import json
+import os
+import sys
+import tempfile
+import time
+from dataclasses import asdict, dataclass, field
+from typing import Dict, List, Optional, Sequence, Tuple
+
+# Upper edges of the histogram buckets, in milliseconds
+HISTOGRAM_EDGES_MS = [0.1, 0.5, 1, 2, 5, 10, 20, 50, 100, float("inf")]
+
+APIS = ("response", "events")
+
+
+@dataclass
+class ScenarioResult:
+    """Measurements of one API, emit rate and concurrency combination."""
+
+    api: str
+    rate: float
+    concurrency: int
+    chunks: int
+    received: int = 0
+    dropped: int = 0
+    lag_ms: Dict[str, float] = field(default_factory=dict)
+    jitter_ms: Dict[str, float] = field(default_factory=dict)
+    emit_jitter_ms: Dict[str, float] = field(default_factory=dict)
+    lag_histogram: List[int] = field(default_factory=list)
+    jitter_histogram: List[int] = field(default_factory=list)
+
+
+def _prompt(api: str, rate: float, concurrency: int, stream: int) -> str:
+    return f"stream latency {api} rate={rate:g} concurrency={concurrency} stream={stream}"
+
+
+def _pieces(stream: int, chunks: int) -> List[str]:
+    # Every piece is unique across streams, so a snapshot or delta identifies itself
+    return [f"s{stream}c{i} " for i in range(chunks)]
+
+
+def write_trace(path: str, apis: Sequence[str], rates: Sequence[float], levels: Sequence[int], chunks: int):
+    """Write the scripted streams of every scenario to a replay trace."""
+    with open(path, "w", encoding="utf-8") as f:
+        f.write(json.dumps({"format": "apple-fm-sdk-trace", "version": 1}) + "\n")
+        for api in apis:
+            for rate in rates:
+                for concurrency in levels:
+                    for stream in range(concurrency):
+                        text = ""
+                        snapshots = []
+                        for i, piece in enumerate(_pieces(stream, chunks)):
+                            text += piece
+                            snapshots.append([(i + 1) / rate, text])
+                        record = {
+                            "prompt": _prompt(api, rate, concurrency, stream),
+                            "schema": None,
+                            "status": 0,
+                            "output": text,
+                            "elapsed": chunks / rate,
+                            "snapshots": snapshots,
+                        }
+                        f.write(json.dumps(record) + "\n")
+
+
+def percentiles(values: Sequence[float]) -> Dict[str, float]:
+    """Nearest-rank percentiles of ``values``, in the unit given."""
+    if not values:
+        return {}
+    ordered = sorted(values)
+
+    def rank(p: float) -> float:
+        return ordered[min(len(ordered) - 1, max(0, round(p / 100 * len(ordered)) - 1))]
+
+    return {
+        "mean": sum(ordered) / len(ordered),
+        "p50": rank(50),
+        "p90": rank(90),
+        "p99": rank(99),
+        "max": ordered[-1],
+    }
+
+
+def histogram(values_ms: Sequence[float]) -> List[int]:
+    counts = [0] * len(HISTOGRAM_EDGES_MS)
+    for value in values_ms:
+        for i, edge in enumerate(HISTOGRAM_EDGES_MS):
+            if value <= edge:
+                counts[i] += 1
+                break
+    return counts
+
+
+def deviations_ms(times: Sequence[float], interval: float) -> List[float]:
+    """Absolute deviation of each gap between ``times`` from ``interval``, in ms."""
+    return [abs(b - a - interval) * 1000 for a, b in zip(times, times[1:])]
+
+
+class EmitClock:
+    """Timestamps snapshots where the replay backend hands them to the C callback."""
+
+    def __init__(self, lib):
+        self.lib = lib
+        self.emitted: Dict[str, float] = {}
+        self._originals = {}
+
+    def install(self):
+        emitted = self.emitted
+        for name in (
+            "FMLanguageModelSessionResponseStreamIterate",
+            "FMLanguageModelSessionResponseStreamIterateEvents",
+        ):
+            self._originals[name] = getattr(self.lib, name)
+
+        iterate = self._originals["FMLanguageModelSessionResponseStreamIterate"]
+        iterate_events = self._originals["FMLanguageModelSessionResponseStreamIterateEvents"]
+
+        def stamped_iterate(stream, user_info, callback):
+            def emit(status, data, length, info):
+                if status == 0 and data:
+                    emitted[bytes(data[:length]).decode("utf-8")] = time.perf_counter()
+                callback(status, data, length, info)
+
+            iterate(stream, user_info, emit)
+
+        def stamped_iterate_events(stream, tools, tool_count, user_info, callback):
+            def emit(status, event_type, data, length, info):
+                # Event type 0 is a text delta
+                if status == 0 and event_type == 0:
+                    emitted[bytes(data[:length]).decode("utf-8")] = time.perf_counter()
+                callback(status, event_type, data, length, info)
+
+            iterate_events(stream, tools, tool_count, user_info, emit)
+
+        self.lib.FMLanguageModelSessionResponseStreamIterate = stamped_iterate
+        self.lib.FMLanguageModelSessionResponseStreamIterateEvents = stamped_iterate_events
+
+    def uninstall(self):
+        for name, function in self._originals.items():
+            setattr(self.lib, name, function)
+
+
+async def _consume(fm, api: str, session, prompt: str) -> List[Tuple[float, str]]:
+    """Stream one response, returning (arrival time, snapshot or delta) pairs."""
+    arrivals = []
+    if api == "response":
+        async for text in session.stream_response(prompt):
+            arrivals.append((time.perf_counter(), text))
+    else:
+        async for event in session.stream_events(prompt):
+            if isinstance(event, fm.TextDelta):
+                arrivals.append((time.perf_counter(), event.text))
+    return arrivals
+
+
+async def run_scenario(fm, clock: EmitClock, api: str, rate: float, concurrency: int, chunks: int) -> ScenarioResult:
+    sessions = [fm.LanguageModelSession() for _ in range(concurrency)]
+    streams = await asyncio.gather(
+        *(
+            _consume(fm, api, session, _prompt(api, rate, concurrency, i))
+            for i, session in enumerate(sessions)
+        )
+    )
+
+    interval = 1 / rate
+    result = ScenarioResult(api=api, rate=rate, concurrency=concurrency, chunks=chunks)
+    lags, jitters, emit_jitters = [], [], []
+    for stream, arrivals in enumerate(streams):
+        keys = _pieces(stream, chunks)
+        if api == "response":
+            keys = ["".join(keys[: i + 1]) for i in range(chunks)]
+        emit_times = [clock.emitted[key] for key in keys if key in clock.emitted]
+        emit_jitters += deviations_ms(emit_times, interval)
+        stream_lags = [(arrived - clock.emitted[text]) * 1000 for arrived, text in arrivals]
+        lags += stream_lags
+        # A received gap minus the emitted gap is the change in lag
+        jitters += [abs(b - a) for a, b in zip(stream_lags, stream_lags[1:])]
+        result.received += len(arrivals)
+        result.dropped += chunks - len(arrivals)
+
+    result.lag_ms = percentiles(lags)
+    result.jitter_ms = percentiles(jitters)
+    result.emit_jitter_ms = percentiles(emit_jitters)
+    result.lag_histogram = histogram(lags)
+    result.jitter_histogram = histogram(jitters)
+    return result
+
+
+def _edge_label(edge: float) -> str:
+    return "   inf" if edge == float("inf") else f"{edge:6g}"
+
+
+def print_histogram(title: str, counts: Sequence[int]):
+    total = sum(counts) or 1
+    print(f"  {title}")
+    lower = "0"
+    for edge, count in zip(HISTOGRAM_EDGES_MS, counts):
+        bar = "#" * round(40 * count / total)
+        print(f"    {lower:>6} - {_edge_label(edge)} ms {count:7d} {bar}")
+        lower = f"{edge:g}"
+
+
+def print_result(result: ScenarioResult, histograms: bool):
+    lag, jitter, emit = result.lag_ms, result.jitter_ms, result.emit_jitter_ms
+    print(
+        f"{result.api:>8} {result.rate:>7g}/s x{result.concurrency:<3} "
+        f"lag p50 {lag.get('p50', 0):7.2f} p99 {lag.get('p99', 0):7.2f} max {lag.get('max', 0):7.2f} ms | "
+        f"jitter p50 {jitter.get('p50', 0):7.2f} p99 {jitter.get('p99', 0):7.2f} ms | "
+        f"emit jitter p99 {emit.get('p99', 0):6.2f} ms | dropped {result.dropped}"
+    )
+    if histograms:
+        print_histogram("delivery lag", result.lag_histogram)
+        print_histogram("inter-chunk jitter", result.jitter_histogram)
+
+
+def _gate(results: Sequence[ScenarioResult], max_lag: Optional[float], max_jitter: Optional[float]) -> List[str]:
+    failures = []
+    for result in results:
+        name = f"{result.api} {result.rate:g}/s x{result.concurrency}"
+        if max_lag is not None and result.lag_ms.get("p99", 0) > max_lag:
+            failures.append(f"{name}: lag p99 {result.lag_ms['p99']:.2f} ms > {max_lag:g} ms")
+        if max_jitter is not None and result.jitter_ms.get("p99", 0) > max_jitter:
+            failures.append(f"{name}: jitter p99 {result.jitter_ms['p99']:.2f} ms > {max_jitter:g} ms")
+    return failures
+
+
+async def run(args) -> List[ScenarioResult]:
+    # The trace must be in place before the package is imported
+    trace = tempfile.NamedTemporaryFile("w", suffix=".jsonl", delete=False)
+    trace.close()
+    write_trace(trace.name, args.api, args.rates, args.concurrency, args.chunks)
+    os.environ["APPLE_FM_SDK_REPLAY"] = trace.name
+    os.environ["APPLE_FM_SDK_REPLAY_SPEED"] = "1"
+    try:
+        import apple_fm_sdk as fm
+        from apple_fm_sdk import _ctypes_bindings as lib
+
+        clock = EmitClock(lib)
+        clock.install()
+        results = []
+        try:
+            for api in args.api:
+                for rate in args.rates:
+                    for concurrency in args.concurrency:
+                        result = await run_scenario(fm, clock, api, rate, concurrency, args.chunks)
+                        print_result(result, args.histograms)
+                        results.append(result)
+        finally:
+            clock.uninstall()
+        return results
+    finally:
+        os.unlink(trace.name)
+
+
+def main(argv: Optional[Sequence[str]] = None) -> int:
+    parser = argparse.ArgumentParser(description="Measure stream delivery lag and jitter.")
+    parser.add_argument("--api", nargs="+", choices=APIS, default=list(APIS), help="Streaming APIs to measure")
+    parser.add_argument("--rates", nargs="+", type=float, default=[20, 100, 500], help="Snapshots emitted per second")
+    parser.add_argument("--concurrency", nargs="+", type=int, default=[1, 4, 16], help="Streams running at the same time")
+    parser.add_argument("--chunks", type=int, default=50, help="Snapshots per stream")
+    parser.add_argument("--no-histograms", dest="histograms", action="store_false", help="Only print the summary lines")
+    parser.add_argument("--max-lag-p99", type=float, help="Fail if any scenario's p99 delivery lag exceeds this, in ms")
+    parser.add_argument("--max-jitter-p99", type=float, help="Fail if any scenario's p99 jitter exceeds this, in ms")
+    parser.add_argument("--json", help="Write the results to this file")
+    args = parser.parse_args(argv)
+    if any(rate <= 0 for rate in args.rates) or any(level < 1 for level in args.concurrency) or args.chunks < 2:
+        parser.error("rates must be positive, concurrency at least 1 and chunks at least 2")
+
+    print("=== Stream Latency Benchmark ===\n")
+    results = asyncio.run(run(args))
+
+    if args.json:
+        with open(args.json, "w", encoding="utf-8") as f:
+            json.dump(
+                {"histogram_edges_ms": HISTOGRAM_EDGES_MS[:-1], "results": [asdict(r) for r in results]},
+                f,
+                indent=2,
+            )
+
+    failures = _gate(results, args.max_lag_p99, args.max_jitter_p99)
+    for failure in failures:
+        print(f"FAIL {failure}")
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,304 @@
+# For licensing see accompanying LICENSE file.
+# Copyright (C) 2026 Apple Inc. All Rights Reserved.
+
+"""
+Transcript Entries Benchmark
+
+Compares :meth:`Transcript.entries` with :meth:`Transcript.to_dict` for the
+common job of picking entries out of a large transcript by role or tool name,
+and :meth:`TranscriptEntries.load` with decoding the same transcript exported
+as JSONL with the :mod:`json` module.
+
+The benchmark restores a synthetic transcript of ``--entries`` entries into a
+session with :meth:`LanguageModelSession.from_transcript` and serves it with
+the replay backend (see :func:`apple_fm_sdk.replay_traffic`), so it needs
+neither the model nor the native library. The replay backend stands in for
+the native layer: it encodes the transcript and, for ``entries()`` and
+``load()``, reports each entry's byte range, role, id and tool names. That
+native work is timed separately, and the Python side of each call is reported
+on its own, since that is the part the entry views are meant to save.
+
+Five workloads are measured for both APIs. For the file workloads the
+``to_dict`` variant decodes every line with ``json.loads``:
+
+* ``load``: fetch the transcript
+* ``filter role``: fetch, then collect the ids of every prompt
+* ``filter tool``: fetch, then read the text of every output of one tool
+* ``load file``: read the JSONL file
+* ``file tool``: read the JSONL file, then read the text of every output of
+  one tool
+
+Usage::
+
+    python benchmarks/transcript_entries.py
+    python benchmarks/transcript_entries.py --entries 20000 --repeat 10
+    python benchmarks/transcript_entries.py --check --json results.json
+
+With ``--check`` the benchmark exits with status 1 if ``entries()`` is not
+faster than ``to_dict()`` on the Python side of every workload.
+"""
+
+import argparse
+import asyncio
+import gc
+import json
+import os
+import sys
+import tempfile
+import time
+import uuid
+from typing import Any, Callable, Dict, List, Optional, Sequence
+
+TOOLS = ("getWeather", "searchDocuments", "lookupContact")
+
+
+def make_transcript(count: int, text_size: int) -> Dict[str, Any]:
+    """Build a transcript of ``count`` entries cycling through every role."""
+    filler = ("lorem ipsum dolor sit amet " * (text_size // 27 + 1))[:text_size]
+    entries: List[Dict[str, Any]] = [
+        {
+            "id": str(uuid.uuid4()),
+            "role": "instructions",
+            "contents": [{"type": "text", "id": str(uuid.uuid4()), "text": "You are a helpful assistant."}],
+            "tools": [
+                {"type": "function", "function": {"name": name, "description": f"The {name} tool."}}
+                for name in TOOLS
+            ],
+        }
+    ]
+    turn = 0
+    while len(entries) < count:
+        tool = TOOLS[turn % len(TOOLS)]
+        call_id = str(uuid.uuid4())
+        entries.append(
+            {
+                "id": str(uuid.uuid4()),
+                "role": "user",
+                "options": {},
+                "contents": [{"type": "text", "id": str(uuid.uuid4()), "text": f"Question {turn}: {filler}"}],
+            }
+        )
+        entries.append(
+            {
+                "id": str(uuid.uuid4()),
+                "role": "response",
+                "toolCalls": [{"name": tool, "arguments": json.dumps({"query": filler[:64]}), "id": call_id}],
+            }
+        )
+        entries.append(
+            {
+                "id": call_id,
+                "role": "tool",
+                "toolName": tool,
+                "toolCallID": call_id,
+                "contents": [{"type": "text", "id": str(uuid.uuid4()), "text": filler}],
+            }
+        )
+        entries.append(
+            {
+                "id": str(uuid.uuid4()),
+                "role": "response",
+                "assets": [],
+                "contents": [{"type": "text", "id": str(uuid.uuid4()), "text": f"Answer {turn}: {filler}"}],
+            }
+        )
+        turn += 1
+    return {
+        "version": 1,
+        "type": "FoundationModels.Transcript",
+        "transcript": {"entries": entries[:count]},
+    }
+
+
+class FetchClock:
+    """Accumulates the time spent in the transcript fetch and indexing of the bindings."""
+
+    NAMES = (
+        "FMLanguageModelSessionGetTranscriptJSONString",
+        "FMLanguageModelSessionGetTranscriptJSONStringWithIndex",
+        "FMTranscriptIndexJSON",
+    )
+
+    def __init__(self, lib):
+        self.lib = lib
+        self.seconds = 0.0
+        self._originals = {}
+
+    def install(self):
+        for name in self.NAMES:
+            original = self._originals[name] = getattr(self.lib, name)
+            setattr(self.lib, name, self._timed(original))
+
+    def uninstall(self):
+        for name, original in self._originals.items():
+            setattr(self.lib, name, original)
+
+    def _timed(self, function):
+        def timed(*args):
+            start = time.perf_counter()
+            try:
+                return function(*args)
+            finally:
+                self.seconds += time.perf_counter() - start
+
+        return timed
+
+
+def _tool_texts(entries, tool: str) -> List[str]:
+    return [
+        " ".join(content["text"] for content in entry["contents"])
+        for entry in entries
+        if entry["role"] == "tool" and entry.get("toolName") == tool
+    ]
+
+
+def workloads(fm, transcript, path: str, tool: str) -> Dict[str, Dict[str, Callable]]:
+    """The measured workloads, each as an ``entries()`` and a ``to_dict()`` variant."""
+
+    async def load_entries():
+        return len(await transcript.entries())
+
+    async def load_dict():
+        return len((await transcript.to_dict())["transcript"]["entries"])
+
+    async def role_entries():
+        return [entry.id for entry in (await transcript.entries()).filter(role="user")]
+
+    async def role_dict():
+        entries = (await transcript.to_dict())["transcript"]["entries"]
+        return [entry["id"] for entry in entries if entry["role"] == "user"]
+
+    async def tool_entries():
+        entries = await transcript.entries()
+        return [entry.text for entry in entries.filter(role="tool", tool_name=tool)]
+
+    async def tool_dict():
+        return _tool_texts((await transcript.to_dict())["transcript"]["entries"], tool)
+
+    def read_lines():
+        with open(path, "rb") as f:
+            return [json.loads(line) for line in f]
+
+    async def load_file_entries():
+        return len(fm.TranscriptEntries.load(path))
+
+    async def load_file_dict():
+        return len(read_lines())
+
+    async def file_tool_entries():
+        entries = fm.TranscriptEntries.load(path)
+        return [entry.text for entry in entries.filter(role="tool", tool_name=tool)]
+
+    async def file_tool_dict():
+        return _tool_texts(read_lines(), tool)
+
+    return {
+        "load": {"entries": load_entries, "to_dict": load_dict},
+        "filter role": {"entries": role_entries, "to_dict": role_dict},
+        "filter tool": {"entries": tool_entries, "to_dict": tool_dict},
+        "load file": {"entries": load_file_entries, "to_dict": load_file_dict},
+        "file tool": {"entries": file_tool_entries, "to_dict": file_tool_dict},
+    }
+
+
+async def measure(function, clock: FetchClock, repeat: int) -> Dict[str, float]:
+    """Best-of-``repeat`` total and Python-side time of one workload, in ms.
+
+    Like :mod:`timeit`, garbage collection is disabled while a run is timed,
+    so one workload's garbage is not collected during the next.
+    """
+    best_total = best_python = float("inf")
+    for _ in range(repeat):
+        gc.collect()
+        gc.disable()
+        try:
+            clock.seconds = 0.0
+            start = time.perf_counter()
+            await function()
+            total = time.perf_counter() - start
+        finally:
+            gc.enable()
+        best_total = min(best_total, total)
+        best_python = min(best_python, total - clock.seconds)
+    return {"total_ms": best_total * 1000, "python_ms": best_python * 1000}
+
+
+async def run(args) -> Dict[str, Any]:
+    # The replay backend must be selected before the package is imported
+    trace = tempfile.NamedTemporaryFile("w", suffix=".jsonl", delete=False)
+    trace.write(json.dumps({"format": "apple-fm-sdk-trace", "version": 1}) + "\n")
+    trace.close()
+    os.environ["APPLE_FM_SDK_REPLAY"] = trace.name
+    try:
+        import apple_fm_sdk as fm
+        from apple_fm_sdk import _ctypes_bindings as lib
+
+        document = make_transcript(args.entries, args.text_size)
+        size = len(json.dumps(document))
+        session = fm.LanguageModelSession.from_transcript(document)
+        print(f"{args.entries} entries, {size / 1e6:.1f} MB of JSON, best of {args.repeat}\n")
+
+        # The same transcript as written by Transcript.export_jsonl()
+        export = tempfile.NamedTemporaryFile("w", suffix=".jsonl", delete=False, encoding="utf-8")
+        with export:
+            for entry in document["transcript"]["entries"]:
+                export.write(json.dumps(entry) + "\n")
+
+        clock = FetchClock(lib)
+        clock.install()
+        results = {}
+        try:
+            for name, variants in workloads(fm, session.transcript, export.name, TOOLS[0]).items():
+                results[name] = {
+                    api: await measure(function, clock, args.repeat) for api, function in variants.items()
+                }
+        finally:
+            clock.uninstall()
+            os.unlink(export.name)
+        return {"entries": args.entries, "bytes": size, "results": results}
+    finally:
+        os.unlink(trace.name)
+
+
+def print_results(results: Dict[str, Dict[str, Dict[str, float]]]):
+    print(f"{'workload':<12} {'api':<8} {'total ms':>9} {'python ms':>10}")
+    for name, apis in results.items():
+        for api, timing in apis.items():
+            print(f"{name:<12} {api:<8} {timing['total_ms']:>9.2f} {timing['python_ms']:>10.2f}")
+        speedup = apis["to_dict"]["python_ms"] / max(apis["entries"]["python_ms"], 1e-9)
+        print(f"{'':<12} entries() is {speedup:.1f}x faster on the Python side\n")
+
+
+def main(argv: Optional[Sequence[str]] = None) -> int:
+    parser = argparse.ArgumentParser(description="Compare Transcript.entries() with Transcript.to_dict().")
+    parser.add_argument("--entries", type=int, default=5000, help="Entries in the synthetic transcript")
+    parser.add_argument("--text-size", type=int, default=400, help="Characters of text per entry")
+    parser.add_argument("--repeat", type=int, default=5, help="Runs per workload; the best is reported")
+    parser.add_argument("--check", action="store_true", help="Fail unless entries() beats to_dict() everywhere")
+    parser.add_argument("--json", help="Write the results to this file")
+    args = parser.parse_args(argv)
+    if args.entries < 1 or args.repeat < 1 or args.text_size < 0:
+        parser.error("entries and repeat must be at least 1 and text size not negative")
+
+    print("=== Transcript Entries Benchmark ===\n")
+    summary = asyncio.run(run(args))
+    print_results(summary["results"])
+
+    if args.json:
+        with open(args.json, "w", encoding="utf-8") as f:
+            json.dump(summary, f, indent=2)
+
+    if args.check:
+        failures = [
+            name
+            for name, apis in summary["results"].items()
+            if apis["entries"]["python_ms"] >= apis["to_dict"]["python_ms"]
+        ]
+        for name in failures:
+            print(f"FAIL {name}: entries() is not faster than to_dict()")
+        return 1 if failures else 0
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -16,10 +16,12 @@ The example shows:
 """
 
 import json
-from typing import Dict, List, Any
+from typing import Dict, List, Any, Sequence
 
+import apple_fm_sdk as fm
 
-def load_transcript(file_path: str) -> Dict[str, Any]:
+
+def load_transcript(file_path: str) -> fm.TranscriptEntries:
     """
     Load a transcript exported from a Swift app.
 
@@ -32,109 +34,65 @@ def load_transcript(file_path: str) -> Dict[str, Any]:
     try jsonData.write(to: URL(fileURLWithPath: "transcript.json"))
     ```
 
+    The file is indexed rather than parsed into dictionaries; each entry
+    is decoded only when one of its fields is read.
+
     Args:
-        file_path: Path to the transcript JSON file
+        file_path: Path to the transcript JSON file, or a ``.jsonl`` file
+            written by ``Transcript.export_jsonl``
 
     Returns:
-        Transcript dictionary with structure:
-        {
-            "version": 1,
-            "type": "FoundationModels.Transcript",
-            "transcript": {
-                "entries": [...]
-            }
-        }
+        Typed transcript entries
     """
-    with open(file_path, "r") as f:
-        return json.load(f)
+    return fm.TranscriptEntries.load(file_path)
 
 
-def extract_text_from_contents(contents: List[Dict[str, Any]]) -> str:
-    """
-    Extract text from a contents array.
-
-    Args:
-        contents: List of content objects
-
-    Returns:
-        Combined text from all text-type contents
-    """
-    text_parts = []
-    for content in contents:
-        if content.get("type") == "text":
-            text_parts.append(content.get("text", ""))
-        elif content.get("type") == "structure":
-            # For structured content, convert to string representation
-            structure = content.get("structure", {})
-            text_parts.append(json.dumps(structure.get("content", {})))
-    return " ".join(text_parts)
-
-
-def analyze_transcript(transcript: Dict[str, Any]) -> Dict[str, Any]:
+def analyze_transcript(entries: Sequence[fm.TranscriptEntry]) -> Dict[str, Any]:
     """
     Analyze a transcript and extract key metrics.
 
     Args:
-        transcript: Transcript dictionary from Swift app with structure:
-            {
-                "version": 1,
-                "transcript": {"entries": [...]},
-                "type": "FoundationModels.Transcript"
-            }
+        entries: Transcript entries, as returned by load_transcript()
 
     Returns:
         Analysis results dictionary
     """
-    entries = transcript.get("transcript", {}).get("entries", [])
+    instructions_entries = [e for e in entries if isinstance(e, fm.InstructionsEntry)]
+    user_entries = [e for e in entries if isinstance(e, fm.PromptEntry)]
+    response_entries = [e for e in entries if isinstance(e, fm.ResponseEntry)]
+    tool_call_entries = [e for e in entries if isinstance(e, fm.ToolCallsEntry)]
+    tool_entries = [e for e in entries if isinstance(e, fm.ToolOutputEntry)]
 
-    # Count entry types by role
-    instructions_entries = [e for e in entries if e.get("role") == "instructions"]
-    user_entries = [e for e in entries if e.get("role") == "user"]
-    response_entries = [e for e in entries if e.get("role") == "response"]
-    tool_entries = [e for e in entries if e.get("role") == "tool"]
+    # Tool calls are responses too; count them with the other response entries
+    response_count = len(response_entries) + len(tool_call_entries)
 
     # Calculate content lengths
-    total_user_chars = sum(
-        len(extract_text_from_contents(e.get("contents", []))) for e in user_entries
-    )
-    total_response_chars = sum(
-        len(extract_text_from_contents(e.get("contents", []))) for e in response_entries
-    )
-
-    # Extract tool calls from response entries
-    tool_calls = []
-    for entry in response_entries:
-        if "toolCalls" in entry:
-            tool_calls.extend(entry["toolCalls"])
+    total_user_chars = sum(len(e.text) for e in user_entries)
+    total_response_chars = sum(len(e.text) for e in response_entries)
 
-    # Extract available tools from instructions
-    available_tools = []
-    for entry in instructions_entries:
-        if "tools" in entry:
-            available_tools.extend(entry["tools"])
+    # Extract tool calls and available tools
+    tool_calls = [call for e in tool_call_entries for call in e.tool_calls]
+    available_tools = [tool for e in instructions_entries for tool in e.tools]
 
     # Check for structured output (responseFormat)
-    has_structured_output = any("responseFormat" in e for e in user_entries)
+    has_structured_output = any(e.response_format for e in user_entries)
 
     # Check for assets (model information)
-    assets = []
-    for entry in response_entries:
-        if "assets" in entry:
-            assets.extend(entry["assets"])
+    assets = [asset for e in response_entries for asset in e.assets]
 
     analysis = {
         "total_entries": len(entries),
         "instructions_entries": len(instructions_entries),
         "user_entries": len(user_entries),
-        "response_entries": len(response_entries),
+        "response_entries": response_count,
         "tool_entries": len(tool_entries),
         "total_user_chars": total_user_chars,
         "total_response_chars": total_response_chars,
         "avg_user_entry_length": total_user_chars / len(user_entries)
         if user_entries
         else 0,
-        "avg_response_entry_length": total_response_chars / len(response_entries)
-        if response_entries
+        "avg_response_entry_length": total_response_chars / response_count
+        if response_count
         else 0,
         "tool_calls_count": len(tool_calls),
         "has_tools": len(tool_calls) > 0,
@@ -146,18 +104,12 @@ def analyze_transcript(transcript: Dict[str, Any]) -> Dict[str, Any]:
     return analysis
 
 
-def print_transcript_summary(transcript: Dict[str, Any], analysis: Dict[str, Any]):
+def print_transcript_summary(analysis: Dict[str, Any]):
     """Print a formatted summary of the transcript."""
     print("=" * 60)
     print("TRANSCRIPT SUMMARY")
     print("=" * 60)
 
-    # Transcript metadata
-    version = transcript.get("version", "N/A")
-    transcript_type = transcript.get("type", "N/A")
-    print(f"\nVersion: {version}")
-    print(f"Type: {transcript_type}")
-
     # Entry statistics
     print("\nEntry Statistics:")
     print(f"  Total entries: {analysis['total_entries']}")
@@ -192,46 +144,37 @@ def print_transcript_summary(transcript: Dict[str, Any], analysis: Dict[str, Any
     print("=" * 60)
 
 
-def print_transcript_entries(transcript: Dict[str, Any], max_entries: int = 5):
+def print_transcript_entries(entries: Sequence[fm.TranscriptEntry], max_entries: int = 5):
     """Print the first few entries from the transcript."""
-    entries = transcript.get("transcript", {}).get("entries", [])
-
     print(f"\nFirst {min(max_entries, len(entries))} entries:")
     print("-" * 60)
 
     for i, entry in enumerate(entries[:max_entries], 1):
-        role = entry.get("role", "unknown")
-        entry_id = entry.get("id", "N/A")
-
-        print(f"\n[{i}] {role.upper()} (ID: {entry_id[:8]}...)")
+        print(f"\n[{i}] {entry.role.upper()} (ID: {entry.id[:8]}...)")
 
         # Show contents
-        if "contents" in entry:
-            contents = entry["contents"]
-            text = extract_text_from_contents(contents)
-            if len(text) > 100:
-                text = text[:100] + "..."
-            if text:
-                print(f"    Content: {text}")
+        text = entry.text
+        if len(text) > 100:
+            text = text[:100] + "..."
+        if text:
+            print(f"    Content: {text}")
 
         # Show tool calls if present
-        if "toolCalls" in entry:
-            for tool_call in entry["toolCalls"]:
-                tool_name = tool_call.get("name", "unknown")
-                print(f"    [Tool Call: {tool_name}]")
+        if isinstance(entry, fm.ToolCallsEntry):
+            for tool_call in entry.tool_calls:
+                print(f"    [Tool Call: {tool_call.name}]")
 
         # Show tool name if this is a tool response
-        if "toolName" in entry:
-            print(f"    [Tool Response: {entry['toolName']}]")
+        if isinstance(entry, fm.ToolOutputEntry):
+            print(f"    [Tool Response: {entry.tool_name}]")
 
         # Show available tools if present
-        if "tools" in entry:
-            tool_count = len(entry["tools"])
-            print(f"    [Available Tools: {tool_count}]")
+        if isinstance(entry, fm.InstructionsEntry) and entry.tools:
+            print(f"    [Available Tools: {len(entry.tools)}]")
 
         # Show response format if present
-        if "responseFormat" in entry:
-            format_type = entry["responseFormat"].get("type", "unknown")
+        if isinstance(entry, fm.PromptEntry) and entry.response_format:
+            format_type = entry.response_format.get("type", "unknown")
             print(f"    [Response Format: {format_type}]")
 
     if len(entries) > max_entries:
@@ -240,12 +183,14 @@ def print_transcript_entries(transcript: Dict[str, Any], max_entries: int = 5):
     print("-" * 60)
 
 
-def compare_transcripts(transcripts: List[Dict[str, Any]]) -> Dict[str, Any]:
+def compare_transcripts(
+    transcripts: List[Sequence[fm.TranscriptEntry]],
+) -> Dict[str, Any]:
     """
     Compare multiple transcripts and generate comparison metrics.
 
     Args:
-        transcripts: List of transcript dictionaries
+        transcripts: List of transcript entry sequences
 
     Returns:
         Comparison results
@@ -269,20 +214,20 @@ def compare_transcripts(transcripts: List[Dict[str, Any]]) -> Dict[str, Any]:
     return comparison
 
 
-def export_analysis_to_jsonl(transcripts: List[Dict[str, Any]], output_file: str):
+def export_analysis_to_jsonl(
+    transcripts: List[Sequence[fm.TranscriptEntry]], output_file: str
+):
     """
     Export transcript analyses to JSONL for further processing.
 
     Args:
-        transcripts: List of transcript dictionaries
+        transcripts: List of transcript entry sequences
         output_file: Path to output JSONL file
     """
     with open(output_file, "w") as f:
         for i, transcript in enumerate(transcripts, 1):
             analysis = analyze_transcript(transcript)
             analysis["transcript_id"] = i
-            analysis["version"] = transcript.get("version", 1)
-            analysis["type"] = transcript.get("type", "unknown")
             f.write(json.dumps(analysis) + "\n")
 
     print(f"\n✓ Exported {len(transcripts)} transcript analyses to {output_file}")
@@ -305,7 +250,7 @@ def main():
     analysis = analyze_transcript(transcript)
 
     # Print summary
-    print_transcript_summary(transcript, analysis)
+    print_transcript_summary(analysis)
 
     # Print entries
     print_transcript_entries(transcript)
@@ -318,9 +263,7 @@ def main():
     # Create a few more example transcripts by varying entry count
     transcripts = [transcript]
     for i in range(2, 4):
-        t = transcript.copy()
-        t["transcript"] = {"entries": transcript["transcript"]["entries"][: i + 1]}
-        transcripts.append(t)
+        transcripts.append(transcript[: i + 1])
 
     comparison = compare_transcripts(transcripts)
 
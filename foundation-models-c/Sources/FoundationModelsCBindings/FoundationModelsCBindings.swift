@@ -15,6 +15,27 @@ final class TaskBox {
   }
 }
 
+/// The session a request task runs for, as the address of its FMLanguageModelSessionRef.
+///
+/// Tool calls the framework makes while generating inherit it, which lets
+/// FMBridgedToolGetCallSession attribute a call to one session when sessions share a tool.
+enum RequestContext {
+  @TaskLocal static var session: UInt = 0
+}
+
+/// Starts a detached request task with `RequestContext.session` set to `session`.
+private func detachedRequestTask(
+  for session: LanguageModelSession,
+  _ operation: @escaping @Sendable () async -> Void
+) -> Task<(), Never> {
+  let address = UInt(bitPattern: Unmanaged.passUnretained(session).toOpaque())
+  return Task.detached {
+    await RequestContext.$session.withValue(address) {
+      await operation()
+    }
+  }
+}
+
 @_cdecl("FMSystemLanguageModelGetDefault")
 public func FMSystemLanguageModelGetDefault() -> FMSystemLanguageModelRef {
   let model = SystemLanguageModel.default
@@ -109,24 +130,68 @@ public func FMLanguageModelSessionCreateFromSystemLanguageModel(
     modelChoice = SystemLanguageModel.default
   }
 
-  // Convert the C array of tool refs to Swift array of Tool objects
-  var toolArray: [any Tool] = []
-  if let tools = tools, toolCount > 0 {
-    for i in 0..<Int(toolCount) {
-      let toolRef = tools[i]
-      let bridgedTool = Unmanaged<BridgedTool>.fromOpaque(toolRef).takeUnretainedValue()
-      toolArray.append(bridgedTool)
-    }
-  }
-
   let session = LanguageModelSession(
     model: modelChoice,
-    tools: toolArray,
+    tools: bridgedTools(tools, toolCount),
     instructions: instructions.map(String.init(cString:))
   )
   return FMLanguageModelSessionRef(Unmanaged.passRetained(session).toOpaque())
 }
 
+/// Creates a session that continues from a transcript previously returned by
+/// FMLanguageModelSessionGetTranscriptJSONString.
+///
+/// The instructions are taken from the transcript. `tools` must provide the tools named in
+/// the transcript's instructions entry for the model to keep calling them.
+///
+/// - Returns: The session, or NULL if the transcript cannot be decoded.
+@_cdecl("FMLanguageModelSessionCreateFromTranscriptJSON")
+public func FMLanguageModelSessionCreateFromTranscriptJSON(
+  model: UnsafePointer<FMSystemLanguageModelRef>?,
+  transcriptJSON: UnsafePointer<CChar>?,
+  transcriptLength: Int,
+  tools: UnsafeMutablePointer<FMBridgedToolRef>?,
+  toolCount: Int32,
+  outErrorCode: UnsafeMutablePointer<Int32>?,
+  outErrorDescription: UnsafeMutablePointer<UnsafePointer<CChar>?>?
+) -> FMLanguageModelSessionRef? {
+  let modelChoice: SystemLanguageModel
+  if let model = model {
+    modelChoice = Unmanaged<SystemLanguageModel>.fromOpaque(model).takeUnretainedValue()
+  } else {
+    modelChoice = SystemLanguageModel.default
+  }
+
+  let data =
+    transcriptJSON.map { Data(bytes: $0, count: transcriptLength) } ?? Data()
+  do {
+    let transcript = try JSONDecoder().decode(Transcript.self, from: data)
+    let session = LanguageModelSession(
+      model: modelChoice,
+      tools: bridgedTools(tools, toolCount),
+      transcript: transcript
+    )
+    return FMLanguageModelSessionRef(Unmanaged.passRetained(session).toOpaque())
+  } catch {
+    let debugDescription = "Invalid transcript: \(error.localizedDescription)"
+    debugDescription.withCString { cString in
+      outErrorCode?.pointee = StatusCode.decodingFailure.rawValue
+      outErrorDescription?.pointee = UnsafePointer(strdup(cString))
+    }
+    return nil
+  }
+}
+
+/// Converts a C array of tool refs to the Swift tools they wrap, without retaining them.
+private func bridgedTools(
+  _ tools: UnsafeMutablePointer<FMBridgedToolRef>?, _ toolCount: Int32
+) -> [any Tool] {
+  guard let tools = tools, toolCount > 0 else { return [] }
+  return (0..<Int(toolCount)).map { i in
+    Unmanaged<BridgedTool>.fromOpaque(tools[i]).takeUnretainedValue()
+  }
+}
+
 @_cdecl("FMLanguageModelSessionIsResponding")
 public func FMLanguageModelSessionIsResponding(session: FMLanguageModelSessionRef) -> Bool {
   let session = Unmanaged<LanguageModelSession>.fromOpaque(session).takeUnretainedValue()
@@ -226,18 +291,60 @@ private func formatErrorDescription(_ error: Error, function: String = #function
 
 // MARK: - Session response
 
+/// Decodes a length-delimited UTF-8 prompt.
+///
+/// Unlike `String(cString:)` this does not scan for a terminator, so prompts containing
+/// embedded NUL bytes are passed through intact. Invalid UTF-8 sequences are replaced
+/// with U+FFFD. The bytes are copied exactly once, into the returned Swift string, so the
+/// caller's buffer may be released as soon as the entry point returns.
+private func makePromptString(_ bytes: UnsafePointer<CChar>?, _ length: Int) -> String {
+  guard let bytes, length > 0 else {
+    return ""
+  }
+  return String(decoding: UnsafeRawBufferPointer(start: bytes, count: length), as: UTF8.self)
+}
+
 @_cdecl("FMLanguageModelSessionRespond")
 public func FMLanguageModelSessionRespond(
   session: FMLanguageModelSessionRef,
   prompt: UnsafePointer<CChar>,
   userInfo: UnsafeMutableRawPointer?,
   callback: FMLanguageModelSessionResponseCallback
+) -> FMTaskRef {
+  return startRespondTask(
+    session: session,
+    prompt: String(cString: prompt),
+    userInfo: userInfo,
+    callback: callback
+  )
+}
+
+@_cdecl("FMLanguageModelSessionRespondBytes")
+public func FMLanguageModelSessionRespondBytes(
+  session: FMLanguageModelSessionRef,
+  prompt: UnsafePointer<CChar>?,
+  promptLength: Int,
+  userInfo: UnsafeMutableRawPointer?,
+  callback: FMLanguageModelSessionResponseCallback
+) -> FMTaskRef {
+  return startRespondTask(
+    session: session,
+    prompt: makePromptString(prompt, promptLength),
+    userInfo: userInfo,
+    callback: callback
+  )
+}
+
+private func startRespondTask(
+  session: FMLanguageModelSessionRef,
+  prompt: String,
+  userInfo: UnsafeMutableRawPointer?,
+  callback: FMLanguageModelSessionResponseCallback
 ) -> FMTaskRef {
   let session = Unmanaged<LanguageModelSession>.fromOpaque(session).takeUnretainedValue()
   let unsafeSendableUserInfo = UnsafeSendableUserInfo(pointer: userInfo)
 
-  let prompt = String(cString: prompt)
-  let task = Task.detached {
+  let task = detachedRequestTask(for: session) {
     do {
       // Check cancellation at start
       try Task.checkCancellation()
@@ -292,6 +399,8 @@ private final class UnsafeSendableResponseStreamBox<Content: Generable>: @unchec
   let stream: LanguageModelSession.ResponseStream<Content>
   let session: LanguageModelSession
   var iterationTask: Task<Void, Never>?
+  /// Set before iteration starts; read by the iteration task.
+  var stopSequences: [String] = []
 
   init(stream: LanguageModelSession.ResponseStream<Content>, session: LanguageModelSession) {
     self.stream = stream
@@ -311,14 +420,64 @@ private final class UnsafeSendableResponseStreamBox<Content: Generable>: @unchec
 public func FMLanguageModelSessionStreamResponse(
   session: FMLanguageModelSessionRef,
   prompt: UnsafePointer<CChar>
+) -> FMLanguageModelSessionResponseStreamRef? {
+  return makeResponseStream(session: session, prompt: String(cString: prompt))
+}
+
+@_cdecl("FMLanguageModelSessionStreamResponseBytes")
+public func FMLanguageModelSessionStreamResponseBytes(
+  session: FMLanguageModelSessionRef,
+  prompt: UnsafePointer<CChar>?,
+  promptLength: Int
+) -> FMLanguageModelSessionResponseStreamRef? {
+  return makeResponseStream(session: session, prompt: makePromptString(prompt, promptLength))
+}
+
+private func makeResponseStream(
+  session: FMLanguageModelSessionRef,
+  prompt: String
 ) -> FMLanguageModelSessionResponseStreamRef? {
   let session = Unmanaged<LanguageModelSession>.fromOpaque(session).takeUnretainedValue()
-  let prompt = String(cString: prompt)
   let stream = session.streamResponse(to: prompt)
   let box = UnsafeSendableResponseStreamBox<String>(stream: stream, session: session)
   return FMLanguageModelSessionResponseStreamRef(Unmanaged.passRetained(box).toOpaque())
 }
 
+/// Ends the stream's response at the first occurrence of any of `sequences`.
+///
+/// Must be called before the stream is iterated. The text is cut before the stop sequence,
+/// the truncated text is delivered as the last snapshot, and generation stops.
+@_cdecl("FMLanguageModelSessionResponseStreamSetStopSequences")
+public func FMLanguageModelSessionResponseStreamSetStopSequences(
+  stream: FMLanguageModelSessionResponseStreamRef,
+  sequences: UnsafePointer<UnsafePointer<CChar>?>?,
+  lengths: UnsafePointer<Int>?,
+  count: Int
+) {
+  let streamBox = Unmanaged<UnsafeSendableResponseStreamBox<String>>.fromOpaque(stream)
+    .takeUnretainedValue()
+  guard let sequences, let lengths else {
+    streamBox.stopSequences = []
+    return
+  }
+  streamBox.stopSequences = (0..<count).compactMap { i in
+    sequences[i].map { makePromptString($0, lengths[i]) }
+  }
+}
+
+/// Cancels the stream's iteration and the generation behind it.
+///
+/// The iteration callback then reports a cancellation error, which callers that asked for the
+/// cancellation can ignore.
+@_cdecl("FMLanguageModelSessionResponseStreamCancel")
+public func FMLanguageModelSessionResponseStreamCancel(
+  stream: FMLanguageModelSessionResponseStreamRef
+) {
+  let streamBox = Unmanaged<UnsafeSendableResponseStreamBox<String>>.fromOpaque(stream)
+    .takeUnretainedValue()
+  streamBox.iterationTask?.cancel()
+}
+
 @_cdecl("FMLanguageModelSessionResponseStreamIterate")
 public func FMLanguageModelSessionResponseStreamIterate(
   stream: FMLanguageModelSessionResponseStreamRef,
@@ -331,15 +490,21 @@ public func FMLanguageModelSessionResponseStreamIterate(
 
   // Capture both the session and stream in the task closure to create strong references
   // This prevents them from being deallocated while the task is running
-  let task = Task.detached { [session = streamBox.session, stream = streamBox.stream] in
+  let task = detachedRequestTask(for: streamBox.session) {
+    [session = streamBox.session, stream = streamBox.stream, stops = streamBox.stopSequences] in
+    var matcher = StopSequenceMatcher(stops)
     do {
       // Check cancellation at start
       try Task.checkCancellation()
 
-      for try await snapshot in stream {
+      var snapshots = stream.makeAsyncIterator()
+      while let snapshot = try await snapshots.next() {
         // Check cancellation before each callback
         try Task.checkCancellation()
-        snapshot.content.withCString { [length = snapshot.content.utf8.count] cString in
+        var content = snapshot.content
+        let truncated = matcher?.truncate(content)
+        content = truncated ?? content
+        content.withCString { [length = content.utf8.count] cString in
           callback( /*status*/
             StatusCode.success.rawValue, /*content*/
             cString,
@@ -347,6 +512,10 @@ public func FMLanguageModelSessionResponseStreamIterate(
             unsafeSendableUserInfo.pointer
           )
         }
+        if truncated != nil {
+          await stopGenerating(&snapshots)
+          break
+        }
       }
 
       // Final callback to signal completion
@@ -395,6 +564,162 @@ public func FMLanguageModelSessionResponseStreamIterate(
   streamBox.iterationTask = task
 }
 
+@_cdecl("FMLanguageModelSessionResponseStreamIterateEvents")
+public func FMLanguageModelSessionResponseStreamIterateEvents(
+  stream: FMLanguageModelSessionResponseStreamRef,
+  tools: UnsafePointer<FMBridgedToolRef?>?,
+  toolCount: Int32,
+  userInfo: UnsafeMutableRawPointer?,
+  callback: FMLanguageModelSessionStreamEventCallback
+) {
+  let streamBox = Unmanaged<UnsafeSendableResponseStreamBox<String>>.fromOpaque(stream)
+    .takeUnretainedValue()
+  let bridgedTools = (0..<Int(max(toolCount, 0))).compactMap { index in
+    tools?[index].map { Unmanaged<BridgedTool>.fromOpaque($0).takeUnretainedValue() }
+  }
+  let sink = StreamEventSink(callback: callback, userInfo: userInfo)
+
+  let task = detachedRequestTask(for: streamBox.session) {
+    [session = streamBox.session, stream = streamBox.stream, stops = streamBox.stopSequences] in
+    let key = ObjectIdentifier(sink)
+    for tool in bridgedTools {
+      tool.eventSinks.withLock { $0[key] = sink }
+    }
+    defer {
+      for tool in bridgedTools {
+        tool.eventSinks.withLock { $0[key] = nil }
+      }
+    }
+
+    let clock = ContinuousClock()
+    let start = clock.now
+    var firstTextAt: ContinuousClock.Instant?
+    var text = ""
+    var snapshots = 0
+    var matcher = StopSequenceMatcher(stops)
+    var stopped = false
+    do {
+      try Task.checkCancellation()
+
+      var snapshots = stream.makeAsyncIterator()
+      while let snapshot = try await snapshots.next() {
+        try Task.checkCancellation()
+        var content = snapshot.content
+        if let truncated = matcher?.truncate(content) {
+          content = truncated
+          stopped = true
+        }
+        snapshots += 1
+        if content.hasPrefix(text) {
+          let delta = String(content.dropFirst(text.count))
+          if !delta.isEmpty {
+            firstTextAt = firstTextAt ?? clock.now
+            sink.emit(.textDelta, delta)
+          }
+        } else {
+          // The model revised earlier text; send the whole snapshot
+          sink.emit(.textReplaced, content)
+        }
+        text = content
+        if stopped {
+          await stopGenerating(&snapshots)
+          break
+        }
+      }
+
+      let toolStats = sink.toolStats.withLock { $0 }
+      func seconds(_ duration: Duration) -> Double {
+        Double(duration.components.seconds) + Double(duration.components.attoseconds) / 1e18
+      }
+      sink.emit(
+        .completed,
+        json: [
+          "text": text,
+          "durationSeconds": seconds(start.duration(to: clock.now)),
+          "timeToFirstTextSeconds": firstTextAt.map { seconds(start.duration(to: $0)) } ?? NSNull(),
+          "snapshots": snapshots,
+          "toolCalls": toolStats.calls,
+          "toolSeconds": Double(toolStats.micros) / 1e6,
+          "stopped": stopped,
+        ]
+      )
+    } catch is CancellationError {
+      sink.emit(.completed, "Stream cancelled", status: StatusCode.unknownError.rawValue)
+    } catch let error as LanguageModelSession.GenerationError {
+      sink.emit(
+        .completed,
+        error.localizedDescription,
+        status: mapGenerationErrorToStatusCode(error)
+      )
+    } catch {
+      sink.emit(.completed, formatErrorDescription(error), status: StatusCode.unknownError.rawValue)
+    }
+
+    // Keep the session and stream references alive until the task completes
+    _ = session
+    _ = stream
+  }
+
+  streamBox.iterationTask = task
+}
+
+/// Stops the generation behind a response stream that is being iterated by the current task.
+///
+/// Leaving the loop alone does not stop it: the stream is still referenced, and the framework
+/// keeps generating. Cancelling the task iterating the stream does, and the stream then ends,
+/// normally or with a CancellationError, once generation has stopped. The rest of the stream is
+/// consumed here, so the session is no longer responding when this returns.
+private func stopGenerating<Snapshots: AsyncIteratorProtocol>(_ snapshots: inout Snapshots) async {
+  withUnsafeCurrentTask { $0?.cancel() }
+  while (try? await snapshots.next()) != nil {}
+}
+
+/// Finds the earliest stop sequence in the snapshots of a streamed response.
+///
+/// Each snapshot holds the whole response so far. Only the bytes added since the previous
+/// snapshot are converted and searched, together with the last bytes before them, enough to
+/// catch a stop sequence that spans two snapshots. A snapshot that is shorter than the previous
+/// one, or whose bytes in that overlap differ, revised earlier text and is searched in full.
+private struct StopSequenceMatcher {
+  private let sequences: [[UInt8]]
+  private let overlap: Int
+  /// UTF-8 length of the previous snapshot, and its last `overlap` bytes
+  private var searched = 0
+  private var tail: [UInt8] = []
+
+  init?(_ sequences: [String]) {
+    let encoded = sequences.map { Array($0.utf8) }.filter { !$0.isEmpty }
+    guard let longest = encoded.map(\.count).max() else { return nil }
+    self.sequences = encoded
+    overlap = longest - 1
+  }
+
+  /// Returns the snapshot cut before the earliest stop sequence, or nil if none has appeared.
+  mutating func truncate(_ snapshot: String) -> String? {
+    let utf8 = snapshot.utf8
+    let count = utf8.count
+    var from = max(0, searched - overlap)
+    if count < searched || !utf8.dropFirst(from).prefix(searched - from).elementsEqual(tail) {
+      from = 0
+    }
+    let bytes = Array(utf8.dropFirst(from))
+    searched = count
+    tail = Array(utf8.suffix(overlap))
+
+    var cut: Int?
+    for sequence in sequences where bytes.count >= sequence.count {
+      for start in 0...(bytes.count - sequence.count) where start < (cut ?? Int.max) {
+        if bytes[start..<(start + sequence.count)].elementsEqual(sequence) {
+          cut = start
+          break
+        }
+      }
+    }
+    guard let cut else { return nil }
+    return String(decoding: utf8.prefix(from + cut), as: UTF8.self)
+  }
+}
+
 @_cdecl("FMLanguageModelSessionRespondWithSchema")
 public func FMLanguageModelSessionRespondWithSchema(
   session: FMLanguageModelSessionRef,
@@ -402,13 +727,46 @@ public func FMLanguageModelSessionRespondWithSchema(
   schema: FMGenerationSchemaRef,
   userInfo: UnsafeMutableRawPointer?,
   callback: FMLanguageModelSessionStructuredResponseCallback
+) -> FMTaskRef {
+  return startRespondWithSchemaTask(
+    session: session,
+    promptString: String(cString: prompt),
+    schema: schema,
+    userInfo: userInfo,
+    callback: callback
+  )
+}
+
+@_cdecl("FMLanguageModelSessionRespondBytesWithSchema")
+public func FMLanguageModelSessionRespondBytesWithSchema(
+  session: FMLanguageModelSessionRef,
+  prompt: UnsafePointer<CChar>?,
+  promptLength: Int,
+  schema: FMGenerationSchemaRef,
+  userInfo: UnsafeMutableRawPointer?,
+  callback: FMLanguageModelSessionStructuredResponseCallback
+) -> FMTaskRef {
+  return startRespondWithSchemaTask(
+    session: session,
+    promptString: makePromptString(prompt, promptLength),
+    schema: schema,
+    userInfo: userInfo,
+    callback: callback
+  )
+}
+
+private func startRespondWithSchemaTask(
+  session: FMLanguageModelSessionRef,
+  promptString: String,
+  schema: FMGenerationSchemaRef,
+  userInfo: UnsafeMutableRawPointer?,
+  callback: FMLanguageModelSessionStructuredResponseCallback
 ) -> FMTaskRef {
   let session = Unmanaged<LanguageModelSession>.fromOpaque(session).takeUnretainedValue()
-  let promptString = String(cString: prompt)
   let schemaBuilder = Unmanaged<GenerationSchemaBuilder>.fromOpaque(schema).takeUnretainedValue()
   let unsafeSendableUserInfo = UnsafeSendableUserInfo(pointer: userInfo)
 
-  let task = Task.detached {
+  let task = detachedRequestTask(for: session) {
     do {
       // Check cancellation at start
       try Task.checkCancellation()
@@ -465,13 +823,46 @@ public func FMLanguageModelSessionRespondWithSchemaFromJSON(
   jsonSchema: UnsafePointer<CChar>,
   userInfo: UnsafeMutableRawPointer?,
   callback: FMLanguageModelSessionStructuredResponseCallback
+) -> FMTaskRef {
+  return startRespondWithSchemaFromJSONTask(
+    session: session,
+    promptString: String(cString: prompt),
+    jsonSchema: jsonSchema,
+    userInfo: userInfo,
+    callback: callback
+  )
+}
+
+@_cdecl("FMLanguageModelSessionRespondBytesWithSchemaFromJSON")
+public func FMLanguageModelSessionRespondBytesWithSchemaFromJSON(
+  session: FMLanguageModelSessionRef,
+  prompt: UnsafePointer<CChar>?,
+  promptLength: Int,
+  jsonSchema: UnsafePointer<CChar>,
+  userInfo: UnsafeMutableRawPointer?,
+  callback: FMLanguageModelSessionStructuredResponseCallback
+) -> FMTaskRef {
+  return startRespondWithSchemaFromJSONTask(
+    session: session,
+    promptString: makePromptString(prompt, promptLength),
+    jsonSchema: jsonSchema,
+    userInfo: userInfo,
+    callback: callback
+  )
+}
+
+private func startRespondWithSchemaFromJSONTask(
+  session: FMLanguageModelSessionRef,
+  promptString: String,
+  jsonSchema: UnsafePointer<CChar>,
+  userInfo: UnsafeMutableRawPointer?,
+  callback: FMLanguageModelSessionStructuredResponseCallback
 ) -> FMTaskRef {
   let session = Unmanaged<LanguageModelSession>.fromOpaque(session).takeUnretainedValue()
-  let promptString = String(cString: prompt)
   let jsonSchemaString = String(cString: jsonSchema)
   let unsafeSendableUserInfo = UnsafeSendableUserInfo(pointer: userInfo)
 
-  let task = Task.detached {
+  let task = detachedRequestTask(for: session) {
     do {
       // Check cancellation at start
       try Task.checkCancellation()
@@ -523,6 +914,105 @@ public func FMLanguageModelSessionRespondWithSchemaFromJSON(
   return FMTaskRef(Unmanaged.passRetained(taskBox).toOpaque())
 }
 
+// MARK: - Pipelined requests
+
+/// One prompt of a pipelined request, with the schema to generate for, if any.
+private struct EnqueuedTurn: @unchecked Sendable {
+  let prompt: String
+  let schemaBuilder: GenerationSchemaBuilder?
+}
+
+/// Runs several prompts back-to-back on one session inside a single task.
+///
+/// `prompts[i]` is `promptLengths[i]` bytes of UTF-8 and is copied before the
+/// function returns. If `schemas` is non-NULL and `schemas[i]` is non-NULL, turn
+/// `i` uses guided generation and reports its result as a retained
+/// `FMGeneratedContentRef`; otherwise it reports text. `callback` is invoked once
+/// per turn, in order. After a turn fails, or the task is cancelled, no further
+/// turns are run, so the failing turn's callback is the last one.
+@_cdecl("FMLanguageModelSessionEnqueue")
+public func FMLanguageModelSessionEnqueue(
+  session: FMLanguageModelSessionRef,
+  prompts: UnsafePointer<UnsafePointer<CChar>?>,
+  promptLengths: UnsafePointer<Int>,
+  schemas: UnsafePointer<FMGenerationSchemaRef?>?,
+  count: Int,
+  userInfo: UnsafeMutableRawPointer?,
+  callback: FMLanguageModelSessionTurnCallback
+) -> FMTaskRef {
+  let session = Unmanaged<LanguageModelSession>.fromOpaque(session).takeUnretainedValue()
+  let unsafeSendableUserInfo = UnsafeSendableUserInfo(pointer: userInfo)
+  let turns = (0..<count).map { index in
+    EnqueuedTurn(
+      prompt: makePromptString(prompts[index], promptLengths[index]),
+      schemaBuilder: schemas?[index].map {
+        Unmanaged<GenerationSchemaBuilder>.fromOpaque($0).takeUnretainedValue()
+      }
+    )
+  }
+
+  let task = detachedRequestTask(for: session) {
+    for (index, turn) in turns.enumerated() {
+      do {
+        try Task.checkCancellation()
+        if let schemaBuilder = turn.schemaBuilder {
+          let schema = try schemaBuilder.buildSchema()
+          let response = try await session.respond(to: turn.prompt, schema: schema)
+          try Task.checkCancellation()
+          let contentWrapper = GeneratedContentWrapper(content: response.content)
+          let contentRef = FMGeneratedContentRef(
+            Unmanaged.passRetained(contentWrapper).toOpaque()
+          )
+          callback(
+            StatusCode.success.rawValue,
+            index,
+            nil,
+            0,
+            contentRef,
+            unsafeSendableUserInfo.pointer
+          )
+        } else {
+          let response = try await session.respond(to: turn.prompt)
+          try Task.checkCancellation()
+          callback(
+            StatusCode.success.rawValue,
+            index,
+            response.content,
+            response.content.utf8.count,
+            nil,
+            unsafeSendableUserInfo.pointer
+          )
+        }
+      } catch {
+        let statusCode: Int32
+        let debugDescription: String
+        switch error {
+        case is CancellationError:
+          statusCode = StatusCode.unknownError.rawValue
+          debugDescription = "Operation cancelled"
+        case let error as LanguageModelSession.GenerationError:
+          statusCode = mapGenerationErrorToStatusCode(error)
+          debugDescription = error.localizedDescription
+        default:
+          statusCode = StatusCode.unknownError.rawValue
+          debugDescription = formatErrorDescription(error)
+        }
+        callback(
+          statusCode,
+          index,
+          debugDescription,
+          debugDescription.utf8.count,
+          nil,
+          unsafeSendableUserInfo.pointer
+        )
+        return
+      }
+    }
+  }
+  let taskBox = TaskBox(task)
+  return FMTaskRef(Unmanaged.passRetained(taskBox).toOpaque())
+}
+
 // MARK: - Transcript
 
 /// Returns a JSON string representation of the session transcript.
@@ -574,51 +1064,456 @@ public func FMLanguageModelSessionGetTranscriptJSONString(
   }
 }
 
-// MARK: - Task management
-
-@_cdecl("FMTaskCancel")
-public func FMTaskCancel(_ task: FMTaskRef) {
-  Unmanaged<TaskBox>.fromOpaque(task).takeUnretainedValue().task.cancel()
+/// Thrown when a JSONL sink stops accepting data part-way through an export.
+private struct TranscriptExportError: Error, LocalizedError {
+  let message: String
+  var errorDescription: String? { message }
 }
 
-@_cdecl("FMRetain")
-public func FMRetain(_ object: UnsafeRawPointer) {
-  _ = Unmanaged<AnyObject>.fromOpaque(object).retain()
+/// Thrown when a buffer cannot be indexed as transcript JSON.
+private struct TranscriptIndexError: Error, LocalizedError {
+  let message: String
+  var errorDescription: String? { message }
 }
 
-@_cdecl("FMRelease")
-public func FMRelease(_ object: UnsafeRawPointer) {
-  Unmanaged<AnyObject>.fromOpaque(object).release()
+/// Returns the session transcript as JSON, like FMLanguageModelSessionGetTranscriptJSONString,
+/// together with an index of its entries in the format returned by FMTranscriptIndexJSON.
+///
+/// - Parameters:
+///   - session: The language model session
+///   - outIndex: Pointer to receive the index string
+///   - outErrorCode: Optional pointer to receive error code on failure
+///   - outErrorDescription: Optional pointer to receive error description on failure
+///
+/// - Returns: A C string containing JSON, or NULL on error
+///
+/// - Important: The returned string and the index are allocated with malloc and MUST be freed
+///              by calling FMFreeString() when no longer needed to prevent memory leaks.
+@_cdecl("FMLanguageModelSessionGetTranscriptJSONStringWithIndex")
+public func FMLanguageModelSessionGetTranscriptJSONStringWithIndex(
+  session: FMLanguageModelSessionRef,
+  outIndex: UnsafeMutablePointer<UnsafeMutablePointer<CChar>?>?,
+  outErrorCode: UnsafeMutablePointer<Int32>?,
+  outErrorDescription: UnsafeMutablePointer<UnsafePointer<CChar>?>?
+) -> UnsafeMutablePointer<CChar>? {
+  let session = Unmanaged<LanguageModelSession>.fromOpaque(session).takeUnretainedValue()
+
+  do {
+    let json = try JSONEncoder().encode(session.transcript)
+    let index = try json.withUnsafeBytes { buffer in
+      transcriptIndexJSON(try scanTranscriptEntries(in: buffer, jsonl: false), in: buffer)
+    }
+    outIndex?.pointee = mallocCString(index)
+    return mallocCString(Array(json))
+  } catch {
+    reportExportError(error, outErrorCode: outErrorCode, outErrorDescription: outErrorDescription)
+    return nil
+  }
 }
 
-/// Frees a string allocated by Foundation Models C API.
+/// Indexes transcript JSON without decoding it.
 ///
-/// Many C API functions return strings allocated with malloc (via strdup).
-/// These strings must be freed by calling this function when no longer needed
-/// to prevent memory leaks.
+/// `json` is `length` bytes holding either an encoded `Transcript`, as returned by
+/// FMLanguageModelSessionGetTranscriptJSONString, or, when `jsonl` is true, one entry object per
+/// line, as written by FMLanguageModelSessionExportTranscriptJSONL.
 ///
-/// - Parameter ptr: The string pointer to free (may be NULL, in which case this is a no-op)
+/// The index is a JSON array with one `[start, end, role, id, [toolNames]]` item per entry, in
+/// transcript order. `start` and `end` are the byte offsets of the entry's object in `json`;
+/// `role`, `id` and `toolNames` are the entry's `role`, `id`, `toolName` and `toolCalls[].name`
+/// fields, copied as they appear, so the caller can filter entries without decoding them.
 ///
-/// - Note: Only call this on strings returned by Foundation Models C API functions
-///         that explicitly document the need to free the returned string.
-@_cdecl("FMFreeString")
-public func FMFreeString(_ ptr: UnsafeMutablePointer<CChar>?) {
-  free(ptr)
+/// - Parameters:
+///   - json: The transcript bytes, which need not be NUL-terminated
+///   - length: Number of bytes in `json`
+///   - jsonl: Whether `json` holds one entry per line
+///   - outIndex: Pointer to receive the index string
+///   - outErrorCode: Optional pointer to receive error code on failure
+///   - outErrorDescription: Optional pointer to receive error description on failure
+///
+/// - Returns: The number of entries, or -1 if `json` is not transcript JSON
+///
+/// - Important: The index is allocated with malloc and MUST be freed by calling FMFreeString().
+///
+/// - Note: Only the structure needed to find the entries is checked. A malformed entry is
+///         reported when the caller decodes it.
+@_cdecl("FMTranscriptIndexJSON")
+public func FMTranscriptIndexJSON(
+  json: UnsafePointer<CChar>?,
+  length: Int,
+  jsonl: Bool,
+  outIndex: UnsafeMutablePointer<UnsafeMutablePointer<CChar>?>?,
+  outErrorCode: UnsafeMutablePointer<Int32>?,
+  outErrorDescription: UnsafeMutablePointer<UnsafePointer<CChar>?>?
+) -> Int {
+  let buffer = UnsafeRawBufferPointer(start: json, count: json == nil ? 0 : length)
+  do {
+    let entries = try scanTranscriptEntries(in: buffer, jsonl: jsonl)
+    guard let index = mallocCString(transcriptIndexJSON(entries, in: buffer)) else {
+      throw TranscriptIndexError(message: "Out of memory")
+    }
+    outIndex?.pointee = index
+    return entries.count
+  } catch {
+    reportExportError(error, outErrorCode: outErrorCode, outErrorDescription: outErrorDescription)
+    return -1
+  }
 }
 
-// MARK: - Schema creation
+/// An entry found by `scanTranscriptEntries`.
+///
+/// Every range indexes the scanned buffer. `role`, `id` and `toolNames` cover raw JSON string
+/// tokens, quotes and escapes included.
+private struct ScannedTranscriptEntry {
+  var span: Range<Int>
+  var role: Range<Int>? = nil
+  var id: Range<Int>? = nil
+  var toolNames: [Range<Int>] = []
+}
 
-@_cdecl("FMGenerationSchemaCreate")
-public func FMGenerationSchemaCreate(
-  name: UnsafePointer<CChar>,
-  description: UnsafePointer<CChar>?
-)
-  -> FMGenerationSchemaRef
+/// Finds the entry objects in transcript JSON in one pass over the bytes.
+///
+/// Entries are the objects in the `transcript.entries` array of an encoded `Transcript`, or the
+/// top-level objects of JSONL. Strings are skipped without being decoded.
+private func scanTranscriptEntries(in json: UnsafeRawBufferPointer, jsonl: Bool) throws
+  -> [ScannedTranscriptEntry]
 {
-  let descriptionString = description.map(String.init(cString:))
-  let nameString = String(cString: name)
+  let quote = UInt8(ascii: "\""), backslash = UInt8(ascii: "\\"), colon = UInt8(ascii: ":")
+  let openObject = UInt8(ascii: "{"), closeObject = UInt8(ascii: "}")
+  let openArray = UInt8(ascii: "["), closeArray = UInt8(ascii: "]")
 
-  // Create a mutable schema builder that can accumulate properties
+  func isWhitespace(_ byte: UInt8) -> Bool {
+    byte == 0x20 || byte == 0x09 || byte == 0x0A || byte == 0x0D
+  }
+
+  // Key ranges exclude the quotes
+  func isKey(_ key: Range<Int>?, _ name: StaticString) -> Bool {
+    guard let key else { return false }
+    let expected = UnsafeRawBufferPointer(start: name.utf8Start, count: name.utf8CodeUnitCount)
+    return json[key].elementsEqual(expected)
+  }
+
+  var entries: [ScannedTranscriptEntry] = []
+  var current = ScannedTranscriptEntry(span: 0..<0)
+  // The most recent key at each depth
+  var keys: [Range<Int>?] = [nil]
+  // Depth at which entry objects open: 0 for JSONL, 3 for {"transcript": {"entries": [...]}}
+  var entryDepth = jsonl ? 0 : -1
+  var depth = 0
+  var i = 0
+  while i < json.count {
+    let byte = json[i]
+    if byte == quote {
+      let start = i
+      i += 1
+      while i < json.count && json[i] != quote {
+        i += json[i] == backslash ? 2 : 1
+      }
+      guard i < json.count else {
+        throw TranscriptIndexError(message: "Unterminated string in transcript JSON")
+      }
+      i += 1
+      var next = i
+      while next < json.count && isWhitespace(json[next]) {
+        next += 1
+      }
+      if next < json.count && json[next] == colon {
+        keys[depth] = (start + 1)..<(i - 1)
+      } else if entryDepth >= 0 && depth == entryDepth + 1 {
+        if isKey(keys[depth], "role") {
+          current.role = start..<i
+        } else if isKey(keys[depth], "id") {
+          current.id = start..<i
+        } else if isKey(keys[depth], "toolName") {
+          current.toolNames.append(start..<i)
+        }
+      } else if entryDepth >= 0 && depth == entryDepth + 3 && isKey(keys[depth], "name")
+        && isKey(keys[entryDepth + 1], "toolCalls")
+      {
+        current.toolNames.append(start..<i)
+      }
+      continue
+    }
+    switch byte {
+    case openObject, openArray:
+      if depth == entryDepth && byte == openObject {
+        current = ScannedTranscriptEntry(span: i..<i)
+      } else if entryDepth < 0 && byte == openArray && depth == 2 && isKey(keys[2], "entries")
+        && isKey(keys[1], "transcript")
+      {
+        entryDepth = 3
+      }
+      depth += 1
+      if depth == keys.count {
+        keys.append(nil)
+      } else {
+        keys[depth] = nil
+      }
+    case closeObject, closeArray:
+      guard depth > 0 else {
+        throw TranscriptIndexError(message: "Unbalanced brackets in transcript JSON")
+      }
+      depth -= 1
+      if depth == entryDepth && byte == closeObject {
+        current.span = current.span.lowerBound..<(i + 1)
+        entries.append(current)
+      } else if depth < entryDepth {
+        return entries  // End of the entries array
+      }
+    default:
+      break
+    }
+    i += 1
+  }
+  guard entryDepth >= 0 else {
+    throw TranscriptIndexError(message: "Buffer does not contain transcript.entries")
+  }
+  guard depth == 0 else {
+    throw TranscriptIndexError(message: "Unexpected end of transcript JSON")
+  }
+  return entries
+}
+
+/// Serializes scanned entries as the index described at FMTranscriptIndexJSON.
+private func transcriptIndexJSON(
+  _ entries: [ScannedTranscriptEntry], in json: UnsafeRawBufferPointer
+) -> [UInt8] {
+  var index: [UInt8] = [UInt8(ascii: "[")]
+  func appendToken(_ token: Range<Int>?) {
+    if let token {
+      index.append(contentsOf: json[token])
+    } else {
+      index.append(contentsOf: "\"\"".utf8)
+    }
+  }
+  for (position, entry) in entries.enumerated() {
+    if position > 0 { index.append(UInt8(ascii: ",")) }
+    index.append(contentsOf: "[\(entry.span.lowerBound),\(entry.span.upperBound),".utf8)
+    appendToken(entry.role)
+    index.append(UInt8(ascii: ","))
+    appendToken(entry.id)
+    index.append(contentsOf: ",[".utf8)
+    for (number, name) in entry.toolNames.enumerated() {
+      if number > 0 { index.append(UInt8(ascii: ",")) }
+      appendToken(name)
+    }
+    index.append(contentsOf: "]]".utf8)
+  }
+  index.append(UInt8(ascii: "]"))
+  return index
+}
+
+/// Copies `bytes` into a NUL-terminated buffer allocated with malloc.
+private func mallocCString(_ bytes: [UInt8]) -> UnsafeMutablePointer<CChar>? {
+  guard let raw = malloc(bytes.count + 1) else { return nil }
+  bytes.withUnsafeBytes { source in
+    if let base = source.baseAddress {
+      raw.copyMemory(from: base, byteCount: source.count)
+    }
+  }
+  raw.storeBytes(of: 0, toByteOffset: bytes.count, as: UInt8.self)
+  return raw.assumingMemoryBound(to: CChar.self)
+}
+
+/// Encodes a single transcript entry as one line of JSON.
+///
+/// `Transcript.Entry` is only encodable as part of a `Transcript`, so the entry is wrapped in
+/// a one-entry transcript and the entry's bytes are copied back out of the envelope as encoded.
+/// Only one entry is ever held in memory at a time.
+private func encodeTranscriptEntryLine(_ entry: Transcript.Entry, encoder: JSONEncoder) throws
+  -> Data
+{
+  let envelope = try encoder.encode(Transcript(entries: [entry]))
+  let entries = try envelope.withUnsafeBytes { try scanTranscriptEntries(in: $0, jsonl: false) }
+  guard entries.count == 1 else {
+    throw TranscriptExportError(message: "Unexpected transcript encoding")
+  }
+  var line = envelope.subdata(in: entries[0].span)
+  line.append(UInt8(ascii: "\n"))
+  return line
+}
+
+/// Walks the session transcript and hands each encoded line to `sink`.
+///
+/// - Returns: The number of entries written.
+private func exportTranscriptJSONL(
+  session: FMLanguageModelSessionRef,
+  sink: (Data) throws -> Void
+) throws -> Int {
+  let session = Unmanaged<LanguageModelSession>.fromOpaque(session).takeUnretainedValue()
+  let encoder = JSONEncoder()
+  encoder.outputFormatting = [.withoutEscapingSlashes]
+  var count = 0
+  for entry in session.transcript {
+    try autoreleasepool {
+      try sink(try encodeTranscriptEntryLine(entry, encoder: encoder))
+    }
+    count += 1
+  }
+  return count
+}
+
+private func reportExportError(
+  _ error: Error,
+  outErrorCode: UnsafeMutablePointer<Int32>?,
+  outErrorDescription: UnsafeMutablePointer<UnsafePointer<CChar>?>?
+) {
+  let errorCode: Int32
+  let debugDescription: String
+  if let error = error as? LanguageModelSession.GenerationError {
+    errorCode = mapGenerationErrorToStatusCode(error)
+    debugDescription = error.localizedDescription
+  } else {
+    errorCode = StatusCode.unknownError.rawValue
+    debugDescription = error.localizedDescription
+  }
+  debugDescription.withCString { cString in
+    outErrorCode?.pointee = errorCode
+    outErrorDescription?.pointee = UnsafePointer(strdup(cString))
+  }
+}
+
+/// Writes the session transcript as newline-delimited JSON to a file descriptor.
+///
+/// Each transcript entry is encoded and written as it is visited, so memory use is bounded by
+/// the largest single entry rather than the whole transcript. The descriptor is not closed.
+///
+/// - Parameters:
+///   - session: The language model session
+///   - fileDescriptor: An open, writable file descriptor
+///   - outErrorCode: Optional pointer to receive error code on failure
+///   - outErrorDescription: Optional pointer to receive error description on failure
+///
+/// - Returns: The number of entries written, or -1 on error
+///
+/// - Note: On error, entries written before the failure remain in the file. If
+///         outErrorDescription is provided, it will contain an allocated string that must be
+///         freed with FMFreeString().
+@_cdecl("FMLanguageModelSessionExportTranscriptJSONLToFileDescriptor")
+public func FMLanguageModelSessionExportTranscriptJSONLToFileDescriptor(
+  session: FMLanguageModelSessionRef,
+  fileDescriptor: Int32,
+  outErrorCode: UnsafeMutablePointer<Int32>?,
+  outErrorDescription: UnsafeMutablePointer<UnsafePointer<CChar>?>?
+) -> Int {
+  do {
+    return try exportTranscriptJSONL(session: session) { line in
+      try line.withUnsafeBytes { (buffer: UnsafeRawBufferPointer) in
+        var offset = 0
+        while offset < buffer.count {
+          let written = write(fileDescriptor, buffer.baseAddress! + offset, buffer.count - offset)
+          if written < 0 {
+            if errno == EINTR { continue }
+            throw TranscriptExportError(
+              message: "Failed to write transcript: \(String(cString: strerror(errno)))")
+          }
+          offset += written
+        }
+      }
+    }
+  } catch {
+    reportExportError(error, outErrorCode: outErrorCode, outErrorDescription: outErrorDescription)
+    return -1
+  }
+}
+
+/// Writes the session transcript as newline-delimited JSON through a write callback.
+///
+/// The callback is invoked synchronously, once per entry, with a buffer holding exactly one
+/// JSON object followed by a newline. The buffer is only valid for the duration of the call.
+/// Returning `false` from the callback stops the export and reports an error.
+///
+/// - Parameters:
+///   - session: The language model session
+///   - userInfo: Opaque pointer passed back to every callback invocation
+///   - callback: Receives each encoded line
+///   - outErrorCode: Optional pointer to receive error code on failure
+///   - outErrorDescription: Optional pointer to receive error description on failure
+///
+/// - Returns: The number of entries written, or -1 on error
+@_cdecl("FMLanguageModelSessionExportTranscriptJSONL")
+public func FMLanguageModelSessionExportTranscriptJSONL(
+  session: FMLanguageModelSessionRef,
+  userInfo: UnsafeMutableRawPointer?,
+  callback: FMTranscriptWriteCallback,
+  outErrorCode: UnsafeMutablePointer<Int32>?,
+  outErrorDescription: UnsafeMutablePointer<UnsafePointer<CChar>?>?
+) -> Int {
+  do {
+    return try exportTranscriptJSONL(session: session) { line in
+      let accepted = line.withUnsafeBytes { (buffer: UnsafeRawBufferPointer) in
+        callback(buffer.baseAddress?.assumingMemoryBound(to: CChar.self), buffer.count, userInfo)
+      }
+      if !accepted {
+        throw TranscriptExportError(message: "Transcript export aborted by write callback")
+      }
+    }
+  } catch {
+    reportExportError(error, outErrorCode: outErrorCode, outErrorDescription: outErrorDescription)
+    return -1
+  }
+}
+
+// MARK: - Task management
+
+@_cdecl("FMTaskCancel")
+public func FMTaskCancel(_ task: FMTaskRef) {
+  Unmanaged<TaskBox>.fromOpaque(task).takeUnretainedValue().task.cancel()
+}
+
+@_cdecl("FMRetain")
+public func FMRetain(_ object: UnsafeRawPointer) {
+  _ = Unmanaged<AnyObject>.fromOpaque(object).retain()
+}
+
+@_cdecl("FMRelease")
+public func FMRelease(_ object: UnsafeRawPointer) {
+  Unmanaged<AnyObject>.fromOpaque(object).release()
+}
+
+/// Releases `count` objects in one call. NULL entries are skipped.
+///
+/// Used by the Python layer to release deferred references in bulk instead of
+/// crossing the FFI boundary once per object.
+@_cdecl("FMReleaseMany")
+public func FMReleaseMany(_ objects: UnsafePointer<UnsafeRawPointer?>?, _ count: Int) {
+  guard let objects, count > 0 else {
+    return
+  }
+  for object in UnsafeBufferPointer(start: objects, count: count) {
+    if let object {
+      Unmanaged<AnyObject>.fromOpaque(object).release()
+    }
+  }
+}
+
+/// Frees a string allocated by Foundation Models C API.
+///
+/// Many C API functions return strings allocated with malloc (via strdup).
+/// These strings must be freed by calling this function when no longer needed
+/// to prevent memory leaks.
+///
+/// - Parameter ptr: The string pointer to free (may be NULL, in which case this is a no-op)
+///
+/// - Note: Only call this on strings returned by Foundation Models C API functions
+///         that explicitly document the need to free the returned string.
+@_cdecl("FMFreeString")
+public func FMFreeString(_ ptr: UnsafeMutablePointer<CChar>?) {
+  free(ptr)
+}
+
+// MARK: - Schema creation
+
+@_cdecl("FMGenerationSchemaCreate")
+public func FMGenerationSchemaCreate(
+  name: UnsafePointer<CChar>,
+  description: UnsafePointer<CChar>?
+)
+  -> FMGenerationSchemaRef
+{
+  let descriptionString = description.map(String.init(cString:))
+  let nameString = String(cString: name)
+
+  // Create a mutable schema builder that can accumulate properties
   let builder = GenerationSchemaBuilder(name: nameString, description: descriptionString)
   return FMGenerationSchemaRef(Unmanaged.passRetained(builder).toOpaque())
 }
@@ -832,6 +1727,64 @@ public func FMGenerationSchemaGetJSONString(
   }
 }
 
+// MARK: - Schema validation
+
+/// Validates a batch of JSON documents against the guides of a generation schema.
+///
+/// The schema is compiled into a validation program on first use, and the
+/// program is reused until a property or reference schema is added. Documents
+/// are validated in parallel. `documents[i]` is `lengths[i]` bytes of UTF-8 JSON.
+///
+/// - Parameters:
+///   - schema: The generation schema
+///   - documents: The JSON documents to validate
+///   - lengths: The length in bytes of each document
+///   - count: The number of documents
+///   - outErrorCode: Optional pointer to receive error code on failure
+///   - outErrorDescription: Optional pointer to receive error description on failure
+///
+/// - Returns: A C string containing a JSON array with one entry per document,
+///   each an array of `{"path", "guide", "message"}` violations, or NULL on error
+///
+/// - Important: The returned string is allocated with malloc and MUST be freed
+///              by calling FMFreeString() when no longer needed to prevent memory leaks.
+@_cdecl("FMGenerationSchemaValidateJSONBatch")
+public func FMGenerationSchemaValidateJSONBatch(
+  schema: FMGenerationSchemaRef,
+  documents: UnsafePointer<UnsafePointer<CChar>?>,
+  lengths: UnsafePointer<Int>,
+  count: Int,
+  outErrorCode: UnsafeMutablePointer<Int32>?,
+  outErrorDescription: UnsafeMutablePointer<UnsafePointer<CChar>?>?
+) -> UnsafeMutablePointer<CChar>? {
+  do {
+    let builder = Unmanaged<GenerationSchemaBuilder>.fromOpaque(schema).takeUnretainedValue()
+    let program = try builder.validationProgram()
+    let data = (0..<count).map { index in
+      documents[index].map { Data(bytes: $0, count: lengths[index]) } ?? Data()
+    }
+
+    let results = Mutex<[[SchemaViolation]]>(Array(repeating: [], count: count))
+    DispatchQueue.concurrentPerform(iterations: count) { index in
+      let violations = program.validate(data[index])
+      results.withLock { $0[index] = violations }
+    }
+
+    let report = results.withLock { $0 }.map { $0.map(\.dictionary) }
+    let json = try JSONSerialization.data(withJSONObject: report)
+    return String(decoding: json, as: UTF8.self).withCString { cString in
+      return UnsafeMutablePointer(strdup(cString))
+    }
+  } catch {
+    let debugDescription = error.localizedDescription
+    debugDescription.withCString { cString in
+      outErrorCode?.pointee = StatusCode.invalidSchema.rawValue
+      outErrorDescription?.pointee = UnsafePointer(strdup(cString))
+    }
+    return nil
+  }
+}
+
 // MARK: - GeneratedContent functions
 
 @_cdecl("FMGeneratedContentCreateFromJSON")
@@ -946,6 +1899,185 @@ public func FMGeneratedContentIsComplete(content: FMGeneratedContentRef) -> Bool
   return wrapper.content.isComplete
 }
 
+// MARK: - Columnar extraction
+
+/// Column types understood by FMGeneratedContentBatchEncodeColumns.
+private enum ColumnKind: UInt8 {
+  case integer = 0
+  case double = 1
+  case boolean = 2
+  case string = 3
+  case json = 4
+}
+
+private struct ColumnEncodingError: Error {
+  let message: String
+}
+
+/// Encodes properties of a batch of GeneratedContent structures as columns.
+///
+/// For every column the buffer holds, in order:
+/// - A validity bitmap of `(count + 7) / 8` bytes, least significant bit first. A bit is
+///   clear when the property is missing or null for that row.
+/// - For integer, double and boolean columns: `count` Int64, Float64 or UInt8 values, with
+///   zero for invalid rows.
+/// - For string and json columns: `count + 1` Int64 offsets starting at zero, followed by
+///   the concatenated UTF-8 data. Json columns hold each value's JSON text.
+///
+/// All values are in the host's byte order.
+///
+/// - Parameters:
+///   - contents: The GeneratedContent values, one per row. Each must be a structure.
+///   - count: Number of rows
+///   - columnNames: Property name of each column
+///   - columnKinds: ColumnKind raw value of each column
+///   - columnCount: Number of columns
+///   - outBuffer: Receives the buffer on success
+///
+/// - Returns: The length of the buffer, or -1 on error.
+///
+/// - Important: The buffer is allocated with malloc and MUST be freed by calling
+///              FMFreeString() when no longer needed.
+@_cdecl("FMGeneratedContentBatchEncodeColumns")
+public func FMGeneratedContentBatchEncodeColumns(
+  contents: UnsafePointer<FMGeneratedContentRef?>,
+  count: Int,
+  columnNames: UnsafePointer<UnsafePointer<CChar>?>,
+  columnKinds: UnsafePointer<UInt8>,
+  columnCount: Int,
+  outBuffer: UnsafeMutablePointer<UnsafeMutablePointer<CChar>?>,
+  outErrorCode: UnsafeMutablePointer<Int32>?,
+  outErrorDescription: UnsafeMutablePointer<UnsafePointer<CChar>?>?
+) -> Int {
+  func fail(_ code: StatusCode, _ message: String) -> Int {
+    message.withCString { cString in
+      outErrorCode?.pointee = code.rawValue
+      outErrorDescription?.pointee = UnsafePointer(strdup(cString))
+    }
+    return -1
+  }
+
+  var columns: [(name: String, kind: ColumnKind)] = []
+  columns.reserveCapacity(columnCount)
+  for i in 0..<columnCount {
+    guard let name = columnNames[i], let kind = ColumnKind(rawValue: columnKinds[i]) else {
+      return fail(.invalidArgument, "Invalid column at index \(i)")
+    }
+    columns.append((String(cString: name), kind))
+  }
+
+  // Look up each row's properties once rather than once per column
+  var rows: [[String: GeneratedContent]] = []
+  rows.reserveCapacity(count)
+  for i in 0..<count {
+    guard let ref = contents[i] else {
+      return fail(.invalidArgument, "Row \(i) is NULL")
+    }
+    let wrapper = Unmanaged<GeneratedContentWrapper>.fromOpaque(ref).takeUnretainedValue()
+    guard case .structure(let properties, _) = wrapper.content.kind else {
+      return fail(.decodingFailure, "Row \(i) is not a structure")
+    }
+    rows.append(properties)
+  }
+
+  var buffer: [UInt8] = []
+  do {
+    for column in columns {
+      try encodeColumn(name: column.name, kind: column.kind, rows: rows, into: &buffer)
+    }
+  } catch let error as ColumnEncodingError {
+    return fail(.decodingFailure, error.message)
+  } catch {
+    return fail(.unknownError, error.localizedDescription)
+  }
+
+  guard let raw = malloc(max(buffer.count, 1)) else {
+    return fail(.unknownError, "Out of memory")
+  }
+  buffer.withUnsafeBytes { bytes in
+    if let base = bytes.baseAddress {
+      raw.copyMemory(from: base, byteCount: bytes.count)
+    }
+  }
+  outBuffer.pointee = raw.assumingMemoryBound(to: CChar.self)
+  return buffer.count
+}
+
+private func encodeColumn(
+  name: String,
+  kind: ColumnKind,
+  rows: [[String: GeneratedContent]],
+  into buffer: inout [UInt8]
+) throws {
+  var validity = [UInt8](repeating: 0, count: (rows.count + 7) / 8)
+  var present: [GeneratedContent?] = []
+  present.reserveCapacity(rows.count)
+  for (row, properties) in rows.enumerated() {
+    if let value = properties[name], !isNull(value) {
+      validity[row >> 3] |= UInt8(1) << UInt8(row & 7)
+      present.append(value)
+    } else {
+      present.append(nil)
+    }
+  }
+  buffer.append(contentsOf: validity)
+
+  func mismatch(_ row: Int, _ expected: String) -> ColumnEncodingError {
+    ColumnEncodingError(message: "Property '\(name)' in row \(row) is not \(expected)")
+  }
+
+  switch kind {
+  case .integer:
+    var values = [Int64](repeating: 0, count: rows.count)
+    for (row, value) in present.enumerated() {
+      guard let value else { continue }
+      guard case .number(let number) = value.kind, number.rounded() == number,
+        let integer = Int64(exactly: number)
+      else { throw mismatch(row, "an integer") }
+      values[row] = integer
+    }
+    values.withUnsafeBytes { buffer.append(contentsOf: $0) }
+  case .double:
+    var values = [Double](repeating: 0, count: rows.count)
+    for (row, value) in present.enumerated() {
+      guard let value else { continue }
+      guard case .number(let number) = value.kind else { throw mismatch(row, "a number") }
+      values[row] = number
+    }
+    values.withUnsafeBytes { buffer.append(contentsOf: $0) }
+  case .boolean:
+    var values = [UInt8](repeating: 0, count: rows.count)
+    for (row, value) in present.enumerated() {
+      guard let value else { continue }
+      guard case .bool(let flag) = value.kind else { throw mismatch(row, "a boolean") }
+      values[row] = flag ? 1 : 0
+    }
+    buffer.append(contentsOf: values)
+  case .string, .json:
+    var offsets = [Int64](repeating: 0, count: rows.count + 1)
+    var data: [UInt8] = []
+    for (row, value) in present.enumerated() {
+      if let value {
+        if kind == .json {
+          data.append(contentsOf: value.jsonString.utf8)
+        } else if case .string(let text) = value.kind {
+          data.append(contentsOf: text.utf8)
+        } else {
+          throw mismatch(row, "a string")
+        }
+      }
+      offsets[row + 1] = Int64(data.count)
+    }
+    offsets.withUnsafeBytes { buffer.append(contentsOf: $0) }
+    buffer.append(contentsOf: data)
+  }
+}
+
+private func isNull(_ content: GeneratedContent) -> Bool {
+  if case .null = content.kind { return true }
+  return false
+}
+
 // MARK: - Wrapper classes for C bindings
 
 private final class GenerationSchemaWrapper: @unchecked Sendable {
@@ -1133,6 +2265,7 @@ private final class GenerationSchemaBuilder: @unchecked Sendable {
   let name: String  // Needed for self-nested definitions
   private var properties: [PropertyInfo] = []
   private var referenceSchemas: [GenerationSchemaBuilder] = []
+  private let compiledProgram = Mutex<SchemaValidationProgram?>(nil)
 
   init(name: String, description: String?) {
     self.name = name
@@ -1141,10 +2274,27 @@ private final class GenerationSchemaBuilder: @unchecked Sendable {
 
   func addProperty(_ property: PropertyInfo) {
     properties.append(property)
+    compiledProgram.withLock { $0 = nil }
   }
 
   func addReferenceSchema(_ schema: GenerationSchemaBuilder) {
     referenceSchemas.append(schema)
+    compiledProgram.withLock { $0 = nil }
+  }
+
+  /// The validation program for this schema, compiled on first use.
+  func validationProgram() throws -> SchemaValidationProgram {
+    if let program = compiledProgram.withLock({ $0 }) {
+      return program
+    }
+    var objects: [String: [CompiledProperty]] = [:]
+    for reference in referenceSchemas {
+      objects[reference.name] = try reference.properties.map(CompiledProperty.init)
+    }
+    objects[name] = try properties.map(CompiledProperty.init)
+    let program = SchemaValidationProgram(rootName: name, objects: objects)
+    compiledProgram.withLock { $0 = program }
+    return program
   }
 
   func buildSchema() throws -> GenerationSchema {
@@ -1337,28 +2487,465 @@ private final class GenerationSchemaBuilder: @unchecked Sendable {
   }
 }
 
+// MARK: - Validation program
+
+/// The JSON type a property's value must have.
+private indirect enum ValueType: Sendable {
+  case string
+  case number
+  case integer
+  case boolean
+  case array(ValueType)
+  case reference(String)
+
+  init(typeName: String) {
+    switch typeName {
+    case "string", "":
+      self = .string
+    case "number", "float", "double":
+      self = .number
+    case "integer", "int":
+      self = .integer
+    case "boolean", "bool":
+      self = .boolean
+    case let typeName where typeName.starts(with: "array<"):
+      if let match = typeName.firstMatch(of: /array<(\w+)>/) {
+        self = .array(ValueType(typeName: String(match.1)))
+      } else {
+        self = .array(.string)
+      }
+    default:
+      self = .reference(typeName)
+    }
+  }
+
+  var name: String {
+    switch self {
+    case .string: "string"
+    case .number: "number"
+    case .integer: "integer"
+    case .boolean: "boolean"
+    case .array(let element): "array<\(element.name)>"
+    case .reference(let name): name
+    }
+  }
+}
+
+/// One guide, compiled into a check of a single value.
+private enum ValueCheck: @unchecked Sendable {
+  case anyOf(Set<String>)
+  case count(Int)
+  case minItems(Int)
+  case maxItems(Int)
+  case minimum(Double)
+  case maximum(Double)
+  /// Compiled with Swift `Regex`, the engine `GenerationGuide.pattern` constrains generation
+  /// with, so a value is valid exactly when generation could have produced it.
+  case regex(Regex<AnyRegexOutput>, pattern: String)
+}
+
+/// A property of a schema, with its guides split between the value itself
+/// and, for arrays, each of its elements.
+private struct CompiledProperty: @unchecked Sendable {
+  let name: String
+  let isOptional: Bool
+  let type: ValueType
+  let checks: [ValueCheck]
+  let elementChecks: [ValueCheck]
+
+  init(_ propertyInfo: PropertyInfo) throws {
+    name = propertyInfo.name
+    isOptional = propertyInfo.isOptional
+    type = ValueType(typeName: propertyInfo.typeName)
+
+    var checks: [ValueCheck] = []
+    var elementChecks: [ValueCheck] = []
+    for guide in propertyInfo.guides {
+      switch (guide, type) {
+      case (.element(let wrapped), _):
+        elementChecks += try Self.compile(wrapped)
+      case (.anyOf, .array), (.regex, .array), (.minimum, .array), (.maximum, .array),
+        (.range, .array):
+        // Mirrors resolveArrayStringGuides, which applies these to the elements
+        elementChecks += try Self.compile(guide)
+      default:
+        checks += try Self.compile(guide)
+      }
+    }
+    self.checks = checks
+    self.elementChecks = elementChecks
+  }
+
+  private static func compile(_ guide: PropertyGuide) throws -> [ValueCheck] {
+    switch guide {
+    case .anyOf(let choices):
+      return [.anyOf(Set(choices))]
+    case .count(let count):
+      return [.count(count)]
+    case .element(let wrapped):
+      return try compile(wrapped)
+    case .maxItems(let count):
+      return [.maxItems(count)]
+    case .minItems(let count):
+      return [.minItems(count)]
+    case .maximum(let maximum):
+      return [.maximum(maximum)]
+    case .minimum(let minimum):
+      return [.minimum(minimum)]
+    case .range(let minimum, let maximum):
+      return [.minimum(minimum), .maximum(maximum)]
+    case .regex(let pattern):
+      return [.regex(try Regex(pattern), pattern: pattern)]
+    }
+  }
+}
+
+/// A guide a document breaks, and where.
+private struct SchemaViolation: Sendable {
+  let path: String
+  let guide: String
+  let message: String
+
+  var dictionary: [String: Any] {
+    ["path": path, "guide": guide, "message": message]
+  }
+}
+
+/// A generation schema compiled for validating documents outside generation.
+///
+/// Immutable once built, so one program validates many documents in parallel.
+private final class SchemaValidationProgram: @unchecked Sendable {
+  let rootName: String
+  let objects: [String: [CompiledProperty]]
+
+  init(rootName: String, objects: [String: [CompiledProperty]]) {
+    self.rootName = rootName
+    self.objects = objects
+  }
+
+  func validate(_ document: Data) -> [SchemaViolation] {
+    let value: Any
+    do {
+      value = try JSONSerialization.jsonObject(with: document, options: [.fragmentsAllowed])
+    } catch {
+      return [SchemaViolation(path: "", guide: "json", message: "Invalid JSON: \(error.localizedDescription)")]
+    }
+    var violations: [SchemaViolation] = []
+    validateObject(value, name: rootName, path: "", into: &violations)
+    return violations
+  }
+
+  private func validateObject(
+    _ value: Any, name: String, path: String, into violations: inout [SchemaViolation]
+  ) {
+    guard let properties = objects[name] else { return }
+    guard let object = value as? [String: Any] else {
+      violations.append(SchemaViolation(path: path, guide: "type", message: "Expected an object of type \(name)"))
+      return
+    }
+    for property in properties {
+      let propertyPath = path.isEmpty ? property.name : "\(path).\(property.name)"
+      guard let propertyValue = object[property.name], !(propertyValue is NSNull) else {
+        if !property.isOptional {
+          violations.append(SchemaViolation(path: propertyPath, guide: "required", message: "Missing required property"))
+        }
+        continue
+      }
+      validateValue(
+        propertyValue, type: property.type, checks: property.checks,
+        elementChecks: property.elementChecks, path: propertyPath, into: &violations
+      )
+    }
+  }
+
+  private func validateValue(
+    _ value: Any, type: ValueType, checks: [ValueCheck], elementChecks: [ValueCheck],
+    path: String, into violations: inout [SchemaViolation]
+  ) {
+    switch type {
+    case .reference(let name):
+      validateObject(value, name: name, path: path, into: &violations)
+      return
+    case .array(let elementType):
+      guard let array = value as? [Any] else {
+        violations.append(SchemaViolation(path: path, guide: "type", message: "Expected \(type.name)"))
+        return
+      }
+      for check in checks {
+        apply(check, to: value, path: path, into: &violations)
+      }
+      for (index, element) in array.enumerated() {
+        validateValue(
+          element, type: elementType, checks: elementChecks, elementChecks: [],
+          path: "\(path)[\(index)]", into: &violations
+        )
+      }
+      return
+    case .string:
+      guard value is String else {
+        violations.append(SchemaViolation(path: path, guide: "type", message: "Expected string"))
+        return
+      }
+    case .boolean:
+      guard let number = value as? NSNumber, CFGetTypeID(number) == CFBooleanGetTypeID() else {
+        violations.append(SchemaViolation(path: path, guide: "type", message: "Expected boolean"))
+        return
+      }
+    case .number, .integer:
+      guard let number = value as? NSNumber, CFGetTypeID(number) != CFBooleanGetTypeID() else {
+        violations.append(SchemaViolation(path: path, guide: "type", message: "Expected \(type.name)"))
+        return
+      }
+      if case .integer = type, number.doubleValue.rounded() != number.doubleValue {
+        violations.append(SchemaViolation(path: path, guide: "type", message: "Expected integer"))
+        return
+      }
+    }
+    for check in checks {
+      apply(check, to: value, path: path, into: &violations)
+    }
+  }
+
+  private func apply(
+    _ check: ValueCheck, to value: Any, path: String, into violations: inout [SchemaViolation]
+  ) {
+    func violation(_ guide: String, _ message: String) {
+      violations.append(SchemaViolation(path: path, guide: guide, message: message))
+    }
+    switch check {
+    case .anyOf(let choices):
+      if let string = value as? String, !choices.contains(string) {
+        violation("anyOf", "\"\(string)\" is not one of the allowed choices")
+      }
+    case .count(let count):
+      if let array = value as? [Any], array.count != count {
+        violation("count", "Expected \(count) items, got \(array.count)")
+      }
+    case .minItems(let minimum):
+      if let array = value as? [Any], array.count < minimum {
+        violation("minItems", "Expected at least \(minimum) items, got \(array.count)")
+      }
+    case .maxItems(let maximum):
+      if let array = value as? [Any], array.count > maximum {
+        violation("maxItems", "Expected at most \(maximum) items, got \(array.count)")
+      }
+    case .minimum(let minimum):
+      if let number = value as? NSNumber, number.doubleValue < minimum {
+        violation("minimum", "\(number) is less than the minimum \(minimum)")
+      }
+    case .maximum(let maximum):
+      if let number = value as? NSNumber, number.doubleValue > maximum {
+        violation("maximum", "\(number) is greater than the maximum \(maximum)")
+      }
+    case .regex(let regex, let pattern):
+      // The whole value must match, trying every alternative, as during generation
+      if let string = value as? String, (try? regex.wholeMatch(in: string)) == nil {
+        violation("regex", "\"\(string)\" does not match /\(pattern)/")
+      }
+    }
+  }
+}
+
 // MARK: - Tool implementation
 
+enum BridgedToolError: Error, LocalizedError {
+  case timedOut(tool: String, seconds: Double)
+  case cancelled(tool: String)
+
+  var errorDescription: String? {
+    switch self {
+    case .timedOut(let tool, let seconds):
+      return "Tool '\(tool)' did not finish within \(seconds) seconds"
+    case .cancelled(let tool):
+      return "Tool '\(tool)' call was cancelled"
+    }
+  }
+}
+
+/// Log-linear latency histogram in microseconds, in the style of HdrHistogram.
+///
+/// Each power-of-two range is split into `subBuckets` equal buckets, so every
+/// recorded value is within 1/`subBuckets` of its bucket's lower bound.
+/// Histograms with the same layout can be merged by adding bucket counts.
+struct LatencyHistogram {
+  static let subBucketBits = 3
+  static let subBuckets = 1 << subBucketBits
+  static let bucketCount = subBuckets * 40
+
+  private(set) var counts = [UInt64](repeating: 0, count: bucketCount)
+
+  static func index(for micros: UInt64) -> Int {
+    guard micros >= UInt64(subBuckets) else {
+      return Int(micros)
+    }
+    let magnitude = 63 - micros.leadingZeroBitCount
+    let subBucket = Int(micros >> UInt64(magnitude - subBucketBits)) & (subBuckets - 1)
+    return min((magnitude - subBucketBits + 1) * subBuckets + subBucket, bucketCount - 1)
+  }
+
+  static func lowerBound(of index: Int) -> UInt64 {
+    guard index >= subBuckets else {
+      return UInt64(index)
+    }
+    let magnitude = index / subBuckets + subBucketBits - 1
+    let subBucket = UInt64(index % subBuckets)
+    return (UInt64(subBuckets) + subBucket) << UInt64(magnitude - subBucketBits)
+  }
+
+  mutating func record(micros: UInt64) {
+    counts[Self.index(for: micros)] += 1
+  }
+}
+
+enum ToolCallOutcome {
+  case success
+  case error
+  case timedOut
+  case cancelled
+}
+
+/// Per-tool call counters, serialized by `FMBridgedToolGetStatsJSONString`.
+struct ToolCallStats: Encodable {
+  var calls: UInt64 = 0
+  var errors: UInt64 = 0
+  var timeouts: UInt64 = 0
+  var cancellations: UInt64 = 0
+  var inFlight: Int = 0
+  var totalMicros: UInt64 = 0
+  var maxMicros: UInt64 = 0
+  var histogram = LatencyHistogram()
+
+  mutating func record(_ outcome: ToolCallOutcome, micros: UInt64) {
+    inFlight -= 1
+    calls += 1
+    switch outcome {
+    case .success: break
+    case .error: errors += 1
+    case .timedOut: timeouts += 1
+    case .cancelled: cancellations += 1
+    }
+    totalMicros += micros
+    maxMicros = max(maxMicros, micros)
+    histogram.record(micros: micros)
+  }
+
+  enum CodingKeys: String, CodingKey {
+    case calls, errors, timeouts, cancellations, inFlight, totalMicros, maxMicros, buckets
+  }
+
+  func encode(to encoder: any Encoder) throws {
+    var container = encoder.container(keyedBy: CodingKeys.self)
+    try container.encode(calls, forKey: .calls)
+    try container.encode(errors, forKey: .errors)
+    try container.encode(timeouts, forKey: .timeouts)
+    try container.encode(cancellations, forKey: .cancellations)
+    try container.encode(inFlight, forKey: .inFlight)
+    try container.encode(totalMicros, forKey: .totalMicros)
+    try container.encode(maxMicros, forKey: .maxMicros)
+    // Only non-empty buckets, as [lowerBoundMicros, count] pairs
+    let buckets = histogram.counts.indices.compactMap { index -> [UInt64]? in
+      let count = histogram.counts[index]
+      return count > 0 ? [LatencyHistogram.lowerBound(of: index), count] : nil
+    }
+    try container.encode(buckets, forKey: .buckets)
+  }
+}
+
+// MARK: - Stream events
+
+/// Event types delivered through `FMLanguageModelSessionStreamEventCallback`.
+enum StreamEventType: Int32 {
+  case textDelta = 0
+  case textReplaced = 1
+  case toolCallStarted = 2
+  case toolCallFinished = 3
+  case completed = 4
+}
+
+/// Delivers the typed events of one streamed turn to a foreign callback.
+///
+/// Tools report to every sink registered with them while a call is running, so
+/// tool events come from `BridgedTool.call` itself rather than from the transcript.
+final class StreamEventSink: @unchecked Sendable {
+  let callback: FMLanguageModelSessionStreamEventCallback
+  let userInfo: UnsafeMutableRawPointer?
+  let toolStats = Mutex<(calls: Int, micros: UInt64)>((0, 0))
+
+  init(callback: FMLanguageModelSessionStreamEventCallback, userInfo: UnsafeMutableRawPointer?) {
+    self.callback = callback
+    self.userInfo = userInfo
+  }
+
+  func emit(_ type: StreamEventType, _ payload: String, status: Int32 = 0) {
+    payload.withCString { cString in
+      callback(status, type.rawValue, cString, payload.utf8.count, userInfo)
+    }
+  }
+
+  func emit(_ type: StreamEventType, json object: [String: Any]) {
+    guard let data = try? JSONSerialization.data(withJSONObject: object) else {
+      return
+    }
+    emit(type, String(decoding: data, as: UTF8.self))
+  }
+}
+
 final class BridgedTool: Tool {
+  /// A tool call waiting for `FMBridgedToolFinishCall`.
+  struct PendingCall {
+    let continuation: CheckedContinuation<String, any Error>
+    let dispatchedAt: ContinuousClock.Instant
+    /// `RequestContext.session` of the request that made the call, or 0.
+    let session: UInt
+    var timeout: Task<Void, Never>?
+  }
+
+  /// Calls waiting to be handed to `foreignBatchCall` together.
+  struct CallBatch {
+    var calls: [(arguments: GeneratedContentWrapper, id: CUnsignedInt)] = []
+    var flush: Task<Void, Never>?
+  }
+
   let name: String
   let description: String
 
   let id: Atomic<CUnsignedInt> = Atomic(0)
 
-  let foreignCall: @convention(c) (FMGeneratedContentRef, CUnsignedInt) -> Void
-  let outputContinuation = Mutex<[CUnsignedInt: CheckedContinuation<String, any Error>]>([:])
+  let foreignCall: (@convention(c) (FMGeneratedContentRef, CUnsignedInt) -> Void)?
+  let foreignBatchCall:
+    (@convention(c) (UnsafePointer<FMGeneratedContentRef>, UnsafePointer<CUnsignedInt>, Int) -> Void)?
+  let batchWindow: Double
+  let maxBatchSize: Int
+  let batch = Mutex(CallBatch())
+  let foreignCancel: (@convention(c) (CUnsignedInt) -> Void)?
+  let timeout: Double?
+  let pendingCalls = Mutex<[CUnsignedInt: PendingCall]>([:])
+  let stats = Mutex(ToolCallStats())
+  let eventSinks = Mutex<[ObjectIdentifier: StreamEventSink]>([:])
   let parameters: GenerationSchema
 
   init(
     name: String,
     description: String,
     parameters: GenerationSchema,
-    foreignCall: @convention(c) (FMGeneratedContentRef, CUnsignedInt) -> Void
+    foreignCall: (@convention(c) (FMGeneratedContentRef, CUnsignedInt) -> Void)?,
+    foreignBatchCall: (
+      @convention(c) (UnsafePointer<FMGeneratedContentRef>, UnsafePointer<CUnsignedInt>, Int) -> Void
+    )? = nil,
+    batchWindow: Double = 0,
+    maxBatchSize: Int = 1,
+    foreignCancel: (@convention(c) (CUnsignedInt) -> Void)? = nil,
+    timeout: Double? = nil
   ) {
     self.name = name
     self.description = description
     self.parameters = parameters
     self.foreignCall = foreignCall
+    self.foreignBatchCall = foreignBatchCall
+    self.batchWindow = batchWindow
+    self.maxBatchSize = maxBatchSize
+    self.foreignCancel = foreignCancel
+    self.timeout = timeout
   }
 
   func nextID() -> CUnsignedInt {
@@ -1368,11 +2955,163 @@ final class BridgedTool: Tool {
   func call(arguments: GeneratedContent) async throws -> String {
     let arguments = GeneratedContentWrapper(content: arguments)
     let id = nextID()
-    foreignCall(FMGeneratedContentRef(Unmanaged.passRetained(arguments).toOpaque()), id)
-    return try await withCheckedThrowingContinuation { continuation in
-      outputContinuation.withLock {
-        $0[id] = continuation
+    let session = RequestContext.session
+    return try await withTaskCancellationHandler {
+      try await withCheckedThrowingContinuation { continuation in
+        // Register before handing the call to the foreign side so a fast
+        // FMBridgedToolFinishCall cannot arrive before the continuation exists.
+        stats.withLock { $0.inFlight += 1 }
+        pendingCalls.withLock {
+          $0[id] = PendingCall(
+            continuation: continuation,
+            dispatchedAt: .now,
+            session: session,
+            timeout: nil
+          )
+        }
+        if Task.isCancelled {
+          // The cancellation handler may have run before registration.
+          resumeCall(id, with: .failure(CancellationError()), outcome: .cancelled)
+          return
+        }
+        if let timeout {
+          let timer = Task { [weak self] in
+            try? await Task.sleep(for: .seconds(timeout))
+            guard !Task.isCancelled, let self else { return }
+            self.abandonCall(
+              id,
+              error: BridgedToolError.timedOut(tool: self.name, seconds: timeout),
+              outcome: .timedOut
+            )
+          }
+          pendingCalls.withLock {
+            $0[id]?.timeout = timer
+          }
+        }
+        let sinks = eventSinks.withLock { Array($0.values) }
+        if !sinks.isEmpty {
+          let argumentsObject =
+            (try? JSONSerialization.jsonObject(with: Data(arguments.content.jsonString.utf8)))
+            ?? [String: Any]()
+          for sink in sinks {
+            sink.emit(
+              .toolCallStarted,
+              json: ["callId": id, "name": name, "arguments": argumentsObject]
+            )
+          }
+        }
+        dispatch(arguments, id)
+      }
+    } onCancel: {
+      abandonCall(id, error: CancellationError(), outcome: .cancelled)
+    }
+  }
+
+  /// Hands a call to the foreign side, on its own or in the next batch.
+  ///
+  /// A batch is delivered `batchWindow` seconds after its first call, or as soon as it holds
+  /// `maxBatchSize` calls, so calls the model makes in the same step arrive together.
+  private func dispatch(_ arguments: GeneratedContentWrapper, _ id: CUnsignedInt) {
+    guard foreignBatchCall != nil else {
+      foreignCall?(FMGeneratedContentRef(Unmanaged.passRetained(arguments).toOpaque()), id)
+      return
+    }
+    let full = batch.withLock { batch -> Bool in
+      batch.calls.append((arguments, id))
+      if batch.calls.count >= maxBatchSize {
+        return true
+      }
+      if batch.flush == nil {
+        batch.flush = Task { [weak self, window = batchWindow] in
+          try? await Task.sleep(for: .seconds(window))
+          guard !Task.isCancelled else { return }
+          self?.flushBatch()
+        }
+      }
+      return false
+    }
+    if full {
+      flushBatch()
+    }
+  }
+
+  /// Delivers the queued calls to `foreignBatchCall` in one invocation.
+  func flushBatch() {
+    let queued = batch.withLock { batch in
+      batch.flush?.cancel()
+      batch.flush = nil
+      let calls = batch.calls
+      batch.calls.removeAll()
+      return calls
+    }
+    // Calls that timed out or were cancelled while queued are not delivered
+    let calls = pendingCalls.withLock { pending in queued.filter { pending[$0.id] != nil } }
+    guard let foreignBatchCall, !calls.isEmpty else {
+      return
+    }
+    let contents = calls.map {
+      FMGeneratedContentRef(Unmanaged.passRetained($0.arguments).toOpaque())
+    }
+    let ids = calls.map(\.id)
+    contents.withUnsafeBufferPointer { contents in
+      ids.withUnsafeBufferPointer { ids in
+        foreignBatchCall(contents.baseAddress!, ids.baseAddress!, calls.count)
+      }
+    }
+  }
+
+  /// Resumes a pending call and records its latency. Returns `false` if the
+  /// call already finished, timed out, or was cancelled.
+  @discardableResult
+  func resumeCall(
+    _ id: CUnsignedInt,
+    with result: Result<String, any Error>,
+    outcome: ToolCallOutcome
+  ) -> Bool {
+    guard let pending = pendingCalls.withLock({ $0.removeValue(forKey: id) }) else {
+      return false
+    }
+    let elapsed = pending.dispatchedAt.duration(to: .now).components
+    let micros = UInt64(max(0, elapsed.seconds)) * 1_000_000
+      + UInt64(max(0, elapsed.attoseconds)) / 1_000_000_000_000
+    stats.withLock { $0.record(outcome, micros: micros) }
+    pending.timeout?.cancel()
+    notifyCallFinished(id, outcome: outcome, micros: micros)
+    pending.continuation.resume(with: result)
+    return true
+  }
+
+  private func notifyCallFinished(_ id: CUnsignedInt, outcome: ToolCallOutcome, micros: UInt64) {
+    let sinks = eventSinks.withLock { Array($0.values) }
+    guard !sinks.isEmpty else {
+      return
+    }
+    let outcomeName: String
+    switch outcome {
+    case .success: outcomeName = "success"
+    case .error: outcomeName = "error"
+    case .timedOut: outcomeName = "timeout"
+    case .cancelled: outcomeName = "cancelled"
+    }
+    for sink in sinks {
+      sink.toolStats.withLock {
+        $0.calls += 1
+        $0.micros += micros
       }
+      sink.emit(
+        .toolCallFinished,
+        json: [
+          "callId": id, "name": name, "durationSeconds": Double(micros) / 1e6,
+          "outcome": outcomeName,
+        ]
+      )
+    }
+  }
+
+  /// Fails a pending call natively and tells the foreign side to stop working on it.
+  func abandonCall(_ id: CUnsignedInt, error: any Error, outcome: ToolCallOutcome) {
+    if resumeCall(id, with: .failure(error), outcome: outcome) {
+      foreignCancel?(id)
     }
   }
 }
@@ -1386,16 +3125,114 @@ public func FMBridgedToolCreate(
   outErrorCode: UnsafeMutablePointer<Int32>?,
   outErrorDescription: UnsafeMutablePointer<UnsafePointer<CChar>?>?
 ) -> FMBridgedToolRef? {
-  do {
-    let schemaBuilder = Unmanaged<GenerationSchemaBuilder>.fromOpaque(parameters)
-      .takeUnretainedValue()
-    let schema = try schemaBuilder.buildSchema()
-    let bridgedTool = BridgedTool(
+  return FMBridgedToolCreateWithTimeout(
+    name: name,
+    description: description,
+    parameters: parameters,
+    callable: callable,
+    cancel: nil,
+    timeoutSeconds: 0,
+    outErrorCode: outErrorCode,
+    outErrorDescription: outErrorDescription
+  )
+}
+
+@_cdecl("FMBridgedToolCreateWithTimeout")
+public func FMBridgedToolCreateWithTimeout(
+  name: UnsafePointer<CChar>,
+  description: UnsafePointer<CChar>,
+  parameters: FMGenerationSchemaRef,
+  callable: @convention(c) (FMGeneratedContentRef, CUnsignedInt) -> Void,
+  cancel: (@convention(c) (CUnsignedInt) -> Void)?,
+  timeoutSeconds: Double,
+  outErrorCode: UnsafeMutablePointer<Int32>?,
+  outErrorDescription: UnsafeMutablePointer<UnsafePointer<CChar>?>?
+) -> FMBridgedToolRef? {
+  return makeBridgedTool(
+    parameters: parameters,
+    timeoutSeconds: timeoutSeconds,
+    outErrorCode: outErrorCode,
+    outErrorDescription: outErrorDescription
+  ) { schema in
+    BridgedTool(
+      name: String(cString: name),
+      description: String(cString: description),
+      parameters: schema,
+      foreignCall: callable,
+      foreignCancel: cancel,
+      timeout: timeoutSeconds > 0 ? timeoutSeconds : nil
+    )
+  }
+}
+
+/// Like `FMBridgedToolCreateWithTimeout`, but calls are delivered to `callable` in batches.
+///
+/// A batch holds the calls made within `batchWindowSeconds` of its first call, up to
+/// `maxBatchSize`. Results are returned with `FMBridgedToolFinishCalls`, or one at a time
+/// with `FMBridgedToolFinishCall` and `FMBridgedToolFailCall`.
+@_cdecl("FMBridgedToolCreateBatched")
+public func FMBridgedToolCreateBatched(
+  name: UnsafePointer<CChar>,
+  description: UnsafePointer<CChar>,
+  parameters: FMGenerationSchemaRef,
+  callable: @convention(c) (UnsafePointer<FMGeneratedContentRef>, UnsafePointer<CUnsignedInt>, Int) ->
+    Void,
+  cancel: (@convention(c) (CUnsignedInt) -> Void)?,
+  timeoutSeconds: Double,
+  batchWindowSeconds: Double,
+  maxBatchSize: Int,
+  outErrorCode: UnsafeMutablePointer<Int32>?,
+  outErrorDescription: UnsafeMutablePointer<UnsafePointer<CChar>?>?
+) -> FMBridgedToolRef? {
+  guard batchWindowSeconds.isFinite, batchWindowSeconds >= 0, maxBatchSize > 0 else {
+    let message =
+      "Tool batch window must be a finite, non-negative number of seconds and batch size positive"
+    message.withCString { cString in
+      outErrorCode?.pointee = StatusCode.invalidArgument.rawValue
+      outErrorDescription?.pointee = UnsafePointer(strdup(cString))
+    }
+    return nil
+  }
+  return makeBridgedTool(
+    parameters: parameters,
+    timeoutSeconds: timeoutSeconds,
+    outErrorCode: outErrorCode,
+    outErrorDescription: outErrorDescription
+  ) { schema in
+    BridgedTool(
       name: String(cString: name),
       description: String(cString: description),
       parameters: schema,
-      foreignCall: callable
+      foreignCall: nil,
+      foreignBatchCall: callable,
+      batchWindow: batchWindowSeconds,
+      maxBatchSize: maxBatchSize,
+      foreignCancel: cancel,
+      timeout: timeoutSeconds > 0 ? timeoutSeconds : nil
     )
+  }
+}
+
+private func makeBridgedTool(
+  parameters: FMGenerationSchemaRef,
+  timeoutSeconds: Double,
+  outErrorCode: UnsafeMutablePointer<Int32>?,
+  outErrorDescription: UnsafeMutablePointer<UnsafePointer<CChar>?>?,
+  _ make: (GenerationSchema) -> BridgedTool
+) -> FMBridgedToolRef? {
+  guard timeoutSeconds.isFinite, timeoutSeconds >= 0 else {
+    let message = "Tool timeout must be a finite, non-negative number of seconds"
+    message.withCString { cString in
+      outErrorCode?.pointee = StatusCode.invalidArgument.rawValue
+      outErrorDescription?.pointee = UnsafePointer(strdup(cString))
+    }
+    return nil
+  }
+  do {
+    let schemaBuilder = Unmanaged<GenerationSchemaBuilder>.fromOpaque(parameters)
+      .takeUnretainedValue()
+    let schema = try schemaBuilder.buildSchema()
+    let bridgedTool = make(schema)
     return FMBridgedToolRef(Unmanaged.passRetained(bridgedTool).toOpaque())
   } catch let error as LanguageModelSession.GenerationError {
     // Map specific generation errors to error codes
@@ -1424,10 +3261,81 @@ public func FMBridgedToolFinishCall(
   output: UnsafePointer<CChar>
 ) {
   let bridgedTool = Unmanaged<BridgedTool>.fromOpaque(tool).takeUnretainedValue()
-  bridgedTool.outputContinuation.withLock {
-    if let continuation = $0[callId] {
-      continuation.resume(returning: String(cString: output))
-      $0.removeValue(forKey: callId)
+  // Late results for calls that already timed out or were cancelled are dropped.
+  bridgedTool.resumeCall(callId, with: .success(String(cString: output)), outcome: .success)
+}
+
+@_cdecl("FMBridgedToolFailCall")
+public func FMBridgedToolFailCall(
+  tool: FMBridgedToolRef,
+  callId: CUnsignedInt,
+  output: UnsafePointer<CChar>
+) {
+  let bridgedTool = Unmanaged<BridgedTool>.fromOpaque(tool).takeUnretainedValue()
+  // The message is still returned to the model as the tool's output so it can
+  // adapt its response; only the call's recorded outcome differs.
+  bridgedTool.resumeCall(callId, with: .success(String(cString: output)), outcome: .error)
+}
+
+/// Finishes several calls at once, typically the calls of one batch.
+///
+/// `outputs[i]` is the result of call `callIds[i]`; calls whose `failed[i]` is true are
+/// recorded as failed, like `FMBridgedToolFailCall`. Null outputs are skipped.
+@_cdecl("FMBridgedToolFinishCalls")
+public func FMBridgedToolFinishCalls(
+  tool: FMBridgedToolRef,
+  callIds: UnsafePointer<CUnsignedInt>,
+  outputs: UnsafePointer<UnsafePointer<CChar>?>,
+  failed: UnsafePointer<Bool>?,
+  count: Int
+) {
+  let bridgedTool = Unmanaged<BridgedTool>.fromOpaque(tool).takeUnretainedValue()
+  for index in 0..<count {
+    guard let output = outputs[index] else {
+      continue
     }
+    bridgedTool.resumeCall(
+      callIds[index],
+      with: .success(String(cString: output)),
+      outcome: failed?[index] == true ? .error : .success
+    )
+  }
+}
+
+/// Returns the session whose request made a pending call, or NULL if the call is no longer
+/// pending or was not made while a request of this library was running.
+///
+/// Meant for the tool's call callback, while the call is still pending. Sessions may share a
+/// tool, so this is how a call is attributed to exactly one of them.
+@_cdecl("FMBridgedToolGetCallSession")
+public func FMBridgedToolGetCallSession(
+  tool: FMBridgedToolRef,
+  callId: CUnsignedInt
+) -> FMLanguageModelSessionRef? {
+  let bridgedTool = Unmanaged<BridgedTool>.fromOpaque(tool).takeUnretainedValue()
+  let session = bridgedTool.pendingCalls.withLock { $0[callId]?.session } ?? 0
+  return FMLanguageModelSessionRef(bitPattern: session)
+}
+
+@_cdecl("FMBridgedToolGetStatsJSONString")
+public func FMBridgedToolGetStatsJSONString(
+  tool: FMBridgedToolRef
+) -> UnsafeMutablePointer<CChar>? {
+  let bridgedTool = Unmanaged<BridgedTool>.fromOpaque(tool).takeUnretainedValue()
+  let stats = bridgedTool.stats.withLock { $0 }
+  guard let data = try? JSONEncoder().encode(stats) else {
+    return nil
+  }
+  return String(decoding: data, as: UTF8.self).withCString { cString in
+    return UnsafeMutablePointer(strdup(cString))
+  }
+}
+
+@_cdecl("FMBridgedToolResetStats")
+public func FMBridgedToolResetStats(tool: FMBridgedToolRef) {
+  let bridgedTool = Unmanaged<BridgedTool>.fromOpaque(tool).takeUnretainedValue()
+  bridgedTool.stats.withLock {
+    // Calls still in flight keep being tracked
+    $0 = ToolCallStats(inFlight: $0.inFlight)
   }
 }
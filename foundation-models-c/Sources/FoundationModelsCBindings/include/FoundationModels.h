@@ -21,7 +21,24 @@ typedef const void *FMBridgedToolRef;
 
 // Callbacks
 typedef void (*_Nonnull FMLanguageModelSessionResponseCallback)(int status, const char *_Nullable content, size_t length, void *_Nullable userInfo) __attribute__((swift_attr("@Sendable")));
+typedef bool (*_Nonnull FMTranscriptWriteCallback)(const char *_Nullable data, size_t length, void *_Nullable userInfo);
 typedef void (*_Nonnull FMLanguageModelSessionStructuredResponseCallback)(int status, FMGeneratedContentRef _Nullable content, void *_Nullable userInfo) __attribute__((swift_attr("@Sendable")));
+// Typed stream events. For text events `payload` is UTF-8 text; for tool and completion events it
+// is a JSON object. A non-zero `status` reports a failure, with the description in `payload`, and
+// like FMStreamEventCompleted it is the last event of the stream.
+typedef enum
+{
+  FMStreamEventTextDelta = 0,
+  FMStreamEventTextReplaced = 1,
+  FMStreamEventToolCallStarted = 2,
+  FMStreamEventToolCallFinished = 3,
+  FMStreamEventCompleted = 4
+} FMStreamEventType;
+typedef void (*_Nonnull FMLanguageModelSessionStreamEventCallback)(int status, int eventType, const char *_Nullable payload, size_t length, void *_Nullable userInfo) __attribute__((swift_attr("@Sendable")));
+// Per-turn callback of FMLanguageModelSessionEnqueue. On success, text turns report `content` and
+// `length`, and structured turns report a retained `structuredContent` that the receiver must release.
+// On failure, `content` holds the error description.
+typedef void (*_Nonnull FMLanguageModelSessionTurnCallback)(int status, size_t turnIndex, const char *_Nullable content, size_t length, FMGeneratedContentRef _Nullable structuredContent, void *_Nullable userInfo) __attribute__((swift_attr("@Sendable")));
 
 // Availability enum
 typedef enum
@@ -52,14 +69,49 @@ FMSystemLanguageModelRef _Nonnull FMSystemLanguageModelCreate(FMSystemLanguageMo
 bool FMSystemLanguageModelIsAvailable(FMSystemLanguageModelRef _Nonnull ref, FMSystemLanguageModelUnavailableReason *_Nullable unavailableReason);
 FMLanguageModelSessionRef _Nonnull FMLanguageModelSessionCreateDefault();
 FMLanguageModelSessionRef _Nonnull FMLanguageModelSessionCreateFromSystemLanguageModel(FMSystemLanguageModelRef _Nullable model, const char *_Nullable instructions, FMBridgedToolRef _Nullable *_Nullable tools, int toolCount);
+// Creates a session that continues from `transcriptLength` bytes of transcript JSON, as returned by
+// FMLanguageModelSessionGetTranscriptJSONString. Returns NULL if the transcript cannot be decoded.
+FMLanguageModelSessionRef _Nullable FMLanguageModelSessionCreateFromTranscriptJSON(FMSystemLanguageModelRef _Nullable model, const char *_Nullable transcriptJSON, size_t transcriptLength, FMBridgedToolRef _Nullable *_Nullable tools, int toolCount, int *_Nullable outErrorCode, char *_Nullable *_Nullable outErrorDescription);
 bool FMLanguageModelSessionIsResponding(FMLanguageModelSessionRef _Nonnull session);
 void FMLanguageModelSessionReset(FMLanguageModelSessionRef _Nonnull session);
 FMTaskRef FMLanguageModelSessionRespond(FMLanguageModelSessionRef _Nonnull session, const char *_Nonnull prompt, void *_Nullable userInfo, FMLanguageModelSessionResponseCallback callback);
 FMLanguageModelSessionResponseStreamRef _Nonnull FMLanguageModelSessionStreamResponse(FMLanguageModelSessionRef _Nonnull session, const char *_Nonnull prompt);
+// Ends the response at the first of `count` stop sequences (each `lengths[i]` bytes of UTF-8). Must be
+// called before the stream is iterated. The last snapshot is the text before the stop sequence.
+void FMLanguageModelSessionResponseStreamSetStopSequences(FMLanguageModelSessionResponseStreamRef _Nonnull stream, const char *_Nullable const *_Nullable sequences, const size_t *_Nullable lengths, size_t count);
+// Cancels the stream's iteration and generation. The iteration callback then reports cancellation.
+void FMLanguageModelSessionResponseStreamCancel(FMLanguageModelSessionResponseStreamRef _Nonnull stream);
 void FMLanguageModelSessionResponseStreamIterate(FMLanguageModelSessionResponseStreamRef _Nonnull stream, void *_Nullable userInfo, FMLanguageModelSessionResponseCallback callback);
+// Like FMLanguageModelSessionResponseStreamIterate, but reports text deltas, calls to any of `tools`
+// and a final completion event with timing metrics through one callback.
+void FMLanguageModelSessionResponseStreamIterateEvents(FMLanguageModelSessionResponseStreamRef _Nonnull stream, FMBridgedToolRef _Nullable const *_Nullable tools, int toolCount, void *_Nullable userInfo, FMLanguageModelSessionStreamEventCallback callback);
+
+// Length-delimited prompt variants. The prompt is `promptLength` bytes of UTF-8 and is not
+// required to be NUL-terminated; embedded NUL bytes are preserved. The bytes are copied before
+// the function returns, so the caller may release the buffer immediately afterwards.
+FMTaskRef FMLanguageModelSessionRespondBytes(FMLanguageModelSessionRef _Nonnull session, const char *_Nullable prompt, size_t promptLength, void *_Nullable userInfo, FMLanguageModelSessionResponseCallback callback);
+FMLanguageModelSessionResponseStreamRef _Nonnull FMLanguageModelSessionStreamResponseBytes(FMLanguageModelSessionRef _Nonnull session, const char *_Nullable prompt, size_t promptLength);
+
+// Pipelined requests. Runs `count` prompts back-to-back on the session in a single task, invoking
+// `callback` once per turn in order. `schemas` may be NULL, and `schemas[i]` may be NULL for a text
+// turn. Prompts are copied before the function returns. The first failing turn ends the pipeline.
+FMTaskRef FMLanguageModelSessionEnqueue(FMLanguageModelSessionRef _Nonnull session, const char *_Nullable const *_Nonnull prompts, const size_t *_Nonnull promptLengths, FMGenerationSchemaRef _Nullable const *_Nullable schemas, size_t count, void *_Nullable userInfo, FMLanguageModelSessionTurnCallback callback);
 
 // Transcript functions
 char *_Nullable FMLanguageModelSessionGetTranscriptJSONString(FMLanguageModelSessionRef _Nonnull session, int *_Nullable outErrorCode, char *_Nullable *_Nullable outErrorDescription);
+// Like FMLanguageModelSessionGetTranscriptJSONString, and also returns in `outIndex` the index of the
+// returned string described at FMTranscriptIndexJSON. Free both strings with FMFreeString.
+char *_Nullable FMLanguageModelSessionGetTranscriptJSONStringWithIndex(FMLanguageModelSessionRef _Nonnull session, char *_Nullable *_Nullable outIndex, int *_Nullable outErrorCode, char *_Nullable *_Nullable outErrorDescription);
+// Indexes `length` bytes of transcript JSON, or of JSONL when `jsonl` is true, without decoding it.
+// `outIndex` receives a JSON array with one [start, end, role, id, [toolNames]] item per entry, where
+// start and end are byte offsets of the entry object in `json`; free it with FMFreeString. Returns
+// the number of entries, or -1 on error.
+ptrdiff_t FMTranscriptIndexJSON(const char *_Nullable json, size_t length, bool jsonl, char *_Nullable *_Nullable outIndex, int *_Nullable outErrorCode, char *_Nullable *_Nullable outErrorDescription);
+
+// Streaming JSONL export. Entries are encoded and written one at a time, one JSON object per
+// line. Both return the number of entries written, or -1 on error.
+ptrdiff_t FMLanguageModelSessionExportTranscriptJSONLToFileDescriptor(FMLanguageModelSessionRef _Nonnull session, int fileDescriptor, int *_Nullable outErrorCode, char *_Nullable *_Nullable outErrorDescription);
+ptrdiff_t FMLanguageModelSessionExportTranscriptJSONL(FMLanguageModelSessionRef _Nonnull session, void *_Nullable userInfo, FMTranscriptWriteCallback callback, int *_Nullable outErrorCode, char *_Nullable *_Nullable outErrorDescription);
 
 // GenerationSchema functions
 FMGenerationSchemaRef _Nonnull FMGenerationSchemaCreate(const char *_Nonnull name, const char *_Nullable description);
@@ -75,25 +127,59 @@ void FMGenerationSchemaPropertyAddRegex(FMGenerationSchemaPropertyRef _Nonnull p
 void FMGenerationSchemaAddProperty(FMGenerationSchemaRef _Nonnull schema, FMGenerationSchemaPropertyRef _Nonnull property);
 void FMGenerationSchemaAddReferenceSchema(FMGenerationSchemaRef _Nonnull schema, FMGenerationSchemaRef _Nonnull referenceSchema);
 char *_Nullable FMGenerationSchemaGetJSONString(FMGenerationSchemaRef _Nonnull schema, int *_Nullable outErrorCode, char *_Nullable *_Nullable outErrorDescription);
+// Validates documents[i] (lengths[i] bytes of JSON) against the schema's guides.
+// Returns a JSON array holding one array of {"path", "guide", "message"} violations per document.
+char *_Nullable FMGenerationSchemaValidateJSONBatch(FMGenerationSchemaRef _Nonnull schema, const char *_Nullable const *_Nonnull documents, const size_t *_Nonnull lengths, size_t count, int *_Nullable outErrorCode, char *_Nullable *_Nullable outErrorDescription);
 
 // GeneratedContent functions
 FMGeneratedContentRef _Nullable FMGeneratedContentCreateFromJSON(const char *_Nonnull jsonString, int *_Nullable outErrorCode, char *_Nullable *_Nullable outErrorDescription);
 char *_Nullable FMGeneratedContentGetJSONString(FMGeneratedContentRef _Nonnull content);
 char *_Nullable FMGeneratedContentGetPropertyValue(FMGeneratedContentRef _Nonnull content, const char *_Nonnull propertyName, int *_Nullable outErrorCode, char *_Nullable *_Nullable outErrorDescription);
 bool FMGeneratedContentIsComplete(FMGeneratedContentRef _Nonnull content);
+// Encodes properties of `count` structures as columns into one buffer: per column a validity bitmap,
+// then fixed-width values (kind 0: int64, 1: double, 2: uint8 bool) or int64 offsets followed by
+// UTF-8 data (kind 3: string, 4: JSON text). Returns the buffer length, or -1 on error. Free the
+// buffer with FMFreeString.
+ptrdiff_t FMGeneratedContentBatchEncodeColumns(const FMGeneratedContentRef _Nullable *_Nonnull contents, size_t count, const char *_Nullable const *_Nonnull columnNames, const uint8_t *_Nonnull columnKinds, size_t columnCount, char *_Nullable *_Nonnull outBuffer, int *_Nullable outErrorCode, char *_Nullable *_Nullable outErrorDescription);
 
 // Structured generation session functions
 FMTaskRef FMLanguageModelSessionRespondWithSchema(FMLanguageModelSessionRef _Nonnull session, const char *_Nonnull prompt, FMGenerationSchemaRef _Nonnull schema, void *_Nullable userInfo, FMLanguageModelSessionStructuredResponseCallback callback);
 FMTaskRef FMLanguageModelSessionRespondWithSchemaFromJSON(FMLanguageModelSessionRef _Nonnull session, const char *_Nonnull prompt, const char *_Nonnull schemaJSONString, void *_Nullable userInfo, FMLanguageModelSessionStructuredResponseCallback callback);
+FMTaskRef FMLanguageModelSessionRespondBytesWithSchema(FMLanguageModelSessionRef _Nonnull session, const char *_Nullable prompt, size_t promptLength, FMGenerationSchemaRef _Nonnull schema, void *_Nullable userInfo, FMLanguageModelSessionStructuredResponseCallback callback);
+FMTaskRef FMLanguageModelSessionRespondBytesWithSchemaFromJSON(FMLanguageModelSessionRef _Nonnull session, const char *_Nullable prompt, size_t promptLength, const char *_Nonnull schemaJSONString, void *_Nullable userInfo, FMLanguageModelSessionStructuredResponseCallback callback);
 
 // Tool functions
 FMBridgedToolRef _Nullable FMBridgedToolCreate(const char *_Nonnull name, const char *_Nonnull description, FMGenerationSchemaRef _Nonnull parameters, void (*_Nonnull callable)(FMGeneratedContentRef _Nonnull, unsigned int), int *_Nullable outErrorCode, char *_Nullable *_Nullable outErrorDescription) __attribute__((swift_attr("@Sendable")));
+// Like FMBridgedToolCreate, with native call timeouts. A call that has not been finished within
+// `timeoutSeconds` (0 disables the timeout), or whose calling task is cancelled, fails with an
+// error and `cancel` is invoked with its call id. FMBridgedToolFinishCall is a no-op for such calls.
+FMBridgedToolRef _Nullable FMBridgedToolCreateWithTimeout(const char *_Nonnull name, const char *_Nonnull description, FMGenerationSchemaRef _Nonnull parameters, void (*_Nonnull callable)(FMGeneratedContentRef _Nonnull, unsigned int), void (*_Nullable cancel)(unsigned int), double timeoutSeconds, int *_Nullable outErrorCode, char *_Nullable *_Nullable outErrorDescription) __attribute__((swift_attr("@Sendable")));
+// Like FMBridgedToolCreateWithTimeout, but calls are delivered in batches: `callable` receives the
+// arguments and ids of every call made within `batchWindowSeconds` of the first, up to `maxBatchSize`.
+FMBridgedToolRef _Nullable FMBridgedToolCreateBatched(const char *_Nonnull name, const char *_Nonnull description, FMGenerationSchemaRef _Nonnull parameters, void (*_Nonnull callable)(FMGeneratedContentRef _Nonnull const *_Nonnull, const unsigned int *_Nonnull, size_t), void (*_Nullable cancel)(unsigned int), double timeoutSeconds, double batchWindowSeconds, size_t maxBatchSize, int *_Nullable outErrorCode, char *_Nullable *_Nullable outErrorDescription) __attribute__((swift_attr("@Sendable")));
 void FMBridgedToolFinishCall(FMBridgedToolRef _Nonnull tool, unsigned int callId, const char *_Nonnull output);
+// Finishes `count` calls at once. Calls whose `failed` flag is set are recorded as failed. Null outputs are skipped.
+void FMBridgedToolFinishCalls(FMBridgedToolRef _Nonnull tool, const unsigned int *_Nonnull callIds, const char *_Nullable const *_Nonnull outputs, const bool *_Nullable failed, size_t count);
+// Like FMBridgedToolFinishCall, but records the call as failed. `output` is still returned to the
+// model as the tool's result.
+void FMBridgedToolFailCall(FMBridgedToolRef _Nonnull tool, unsigned int callId, const char *_Nonnull output);
+
+// Returns the session whose request made the pending call `callId`, or NULL if the call is no longer
+// pending. Sessions may share a tool; this attributes a call to one of them from the call callback.
+FMLanguageModelSessionRef _Nullable FMBridgedToolGetCallSession(FMBridgedToolRef _Nonnull tool, unsigned int callId);
+
+// Call telemetry. Returns a JSON object with call, error, timeout and cancellation counts, the
+// number of calls in flight, and a log-linear latency histogram in microseconds measured from
+// dispatch to the tool until its call finishes. Free the result with FMFreeString.
+char *_Nullable FMBridgedToolGetStatsJSONString(FMBridgedToolRef _Nonnull tool);
+void FMBridgedToolResetStats(FMBridgedToolRef _Nonnull tool);
 
 void FMTaskCancel(FMTaskRef task);
 
 void FMRetain(const void *_Nonnull object);
 void FMRelease(const void *_Nonnull object);
+// Releases `count` objects in one call; NULL entries are skipped.
+void FMReleaseMany(const void *_Nullable const *_Nullable objects, size_t count);
 void FMFreeString(char *_Nullable str);
 
 #endif /* FoundationModels_h */
@@ -5,6 +5,17 @@
 Foundation Models SDK for Python package initialization.
 """
 
+import os as _os
+
+if _os.environ.get("APPLE_FM_SDK_REPLAY"):
+    # Serve the bindings from a recorded trace before any module imports them
+    from . import _replay_bindings
+
+    _replay_bindings._install_as_bindings(
+        _os.environ["APPLE_FM_SDK_REPLAY"],
+        float(_os.environ.get("APPLE_FM_SDK_REPLAY_SPEED", "1.0")),
+    )
+
 from .core import (
     SystemLanguageModel,
     SystemLanguageModelUseCase,
@@ -39,7 +50,7 @@ from .generable import (
     Generable,
 )
 
-from .generation_schema import GenerationSchema
+from .generation_schema import GenerationSchema, SchemaViolation
 
 from .generable_utils import generable
 
@@ -47,6 +58,64 @@ from .generation_guide import GenerationGuide, GuideType, guide
 
 from .tool import Tool
 
+from .tool_stats import ToolStats, tool_stats, reset_tool_stats
+
+from .c_helpers import scope
+
+from .traffic import TrafficRecorder, record_traffic, replay_traffic
+
+from . import tagging
+
+from .stream_events import (
+    StreamEvent,
+    TextDelta,
+    ToolCallStarted,
+    ToolCallFinished,
+    Completed,
+    StreamMetrics,
+)
+
+from .transcript_entries import (
+    TranscriptEntries,
+    TranscriptEntry,
+    InstructionsEntry,
+    PromptEntry,
+    ResponseEntry,
+    ToolCallsEntry,
+    ToolOutputEntry,
+    ToolCall,
+)
+
+from .broadcast import BroadcastStream, StreamSubscription
+
+from .transcript_archive import TranscriptArchive, ArchiveStats
+
+from .result_batch import ResultBatch, Column, ColumnType
+
+from .session_manager import (
+    SessionManager,
+    SessionManagerStats,
+    TranscriptStore,
+    InMemoryTranscriptStore,
+)
+
+from .scheduler import (
+    FairScheduler,
+    TenantStats,
+    set_scheduler,
+    get_scheduler,
+    tenant,
+)
+
+from .pipeline import (
+    SessionPool,
+    PipelineProgress,
+    map_reduce,
+    map_reduce_stream,
+    chunk_text,
+    estimate_tokens,
+)
+
 __version__ = "0.1.0"
 __all__ = [
     "SystemLanguageModel",
@@ -55,6 +124,21 @@ __all__ = [
     "SystemLanguageModelGuardrails",
     "SystemLanguageModelUnavailableReason",
     "Tool",
+    "ToolStats",
+    "tool_stats",
+    "reset_tool_stats",
+    "scope",
+    "record_traffic",
+    "replay_traffic",
+    "TrafficRecorder",
+    "StreamEvent",
+    "TextDelta",
+    "ToolCallStarted",
+    "ToolCallFinished",
+    "Completed",
+    "StreamMetrics",
+    "BroadcastStream",
+    "StreamSubscription",
     "FoundationModelsError",
     "GenerationError",
     "ExceededContextWindowSizeError",
@@ -72,6 +156,7 @@ __all__ = [
     "generable",
     "guide",
     "GenerationSchema",
+    "SchemaViolation",
     "GeneratedContent",
     "GenerationGuide",
     "GuideType",
@@ -79,4 +164,33 @@ __all__ = [
     "ConvertibleFromGeneratedContent",
     "ConvertibleToGeneratedContent",
     "Generable",
+    "TranscriptEntries",
+    "TranscriptEntry",
+    "InstructionsEntry",
+    "PromptEntry",
+    "ResponseEntry",
+    "ToolCallsEntry",
+    "ToolOutputEntry",
+    "ToolCall",
+    "TranscriptArchive",
+    "ArchiveStats",
+    "ResultBatch",
+    "Column",
+    "ColumnType",
+    "SessionManager",
+    "SessionManagerStats",
+    "TranscriptStore",
+    "InMemoryTranscriptStore",
+    "FairScheduler",
+    "TenantStats",
+    "set_scheduler",
+    "get_scheduler",
+    "tenant",
+    "SessionPool",
+    "PipelineProgress",
+    "map_reduce",
+    "map_reduce_stream",
+    "chunk_text",
+    "estimate_tokens",
+    "tagging",
 ]
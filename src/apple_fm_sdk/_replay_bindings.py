@@ -0,0 +1,1162 @@
+# For licensing see accompanying LICENSE file.
+# Copyright (C) 2026 Apple Inc. All Rights Reserved.
+
+"""
+Pure-Python implementation of the FoundationModels.h functions that serves
+requests from a recorded traffic trace.
+
+The backend is either patched into the real bindings module by
+:func:`apple_fm_sdk.traffic.replay_traffic`, or, when ``APPLE_FM_SDK_REPLAY``
+is set, installed in place of ``_ctypes_bindings`` before the package imports
+it, so the SDK runs without the native library.
+
+Objects created by the backend are identified by small integer handles below
+4 GiB, which no native pointer on macOS can take. Handles the backend does not
+know are passed through to the native functions when those are available.
+"""
+
+import ctypes
+import itertools
+import json
+import os
+import re
+import sys
+import threading
+import time
+from array import array
+from collections import deque
+from typing import Any, Callable, Deque, Dict, List, Optional, Tuple
+
+from .traffic import _json_schema_key, _load_trace, _schema_key_from_json
+
+_UNKNOWN_ERROR = 255
+_CONCURRENT_REQUESTS = 8
+_NATIVE_POINTER_FLOOR = 1 << 32
+_TOOL_CALL_TIMEOUT = 30.0
+
+
+# A JSON string (with escapes) or a structural bracket, for the FMTranscriptIndexJSON stand-in
+_JSON_TOKEN = re.compile(rb'"[^"\\]*(?:\\.[^"\\]*)*"|[{}\[\]]')
+_KEY_SEPARATOR = re.compile(rb"\s*:")
+
+
+def _index_transcript(buffer: bytes, jsonl: bool) -> List[list]:
+    """Index transcript JSON the way FMTranscriptIndexJSON does, in pure Python."""
+    # Depth at which entry objects open: 0 for JSONL, 3 for
+    # {"transcript": {"entries": [ ... ]}}. Unknown until "entries" is seen.
+    entry_depth = 0 if jsonl else -1
+    depth = 0
+    keys: List[Optional[bytes]] = [None]
+    index: List[list] = []
+    current: list = []
+    for match in _JSON_TOKEN.finditer(buffer):
+        token = match.group()
+        if token[0] == ord('"'):
+            if _KEY_SEPARATOR.match(buffer, match.end()):
+                keys[depth] = token
+            elif entry_depth >= 0 and depth == entry_depth + 1:
+                key = keys[depth]
+                if key == b'"role"':
+                    current[2] = json.loads(token)
+                elif key == b'"id"':
+                    current[3] = json.loads(token)
+                elif key == b'"toolName"':
+                    current[4].append(json.loads(token))
+            elif (
+                entry_depth >= 0
+                and depth == entry_depth + 3
+                and keys[depth] == b'"name"'
+                and keys[entry_depth + 1] == b'"toolCalls"'
+            ):
+                current[4].append(json.loads(token))
+            continue
+        if token in (b"{", b"["):
+            if depth == entry_depth and token == b"{":
+                current = [match.start(), 0, "", "", []]
+            elif (
+                entry_depth < 0
+                and token == b"["
+                and depth == 2
+                and keys[2] == b'"entries"'
+                and keys[1] == b'"transcript"'
+            ):
+                entry_depth = 3
+            depth += 1
+            if depth == len(keys):
+                keys.append(None)
+            keys[depth] = None
+            continue
+        if depth == 0:
+            raise ValueError("Unbalanced brackets in transcript JSON")
+        depth -= 1
+        if depth == entry_depth and token == b"}":
+            current[1] = match.end()
+            index.append(current)
+        elif depth < entry_depth:
+            return index  # End of the entries array
+    if entry_depth < 0:
+        raise ValueError("Buffer does not contain transcript.entries")
+    if depth:
+        raise ValueError("Unexpected end of transcript JSON")
+    return index
+
+
+class String(ctypes.Union):
+    """Mirror of the ctypesgen ``String`` wrapper for ``char *`` values."""
+
+    _fields_ = [("raw", ctypes.POINTER(ctypes.c_char)), ("data", ctypes.c_char_p)]
+
+    def __init__(self, obj=b""):
+        if isinstance(obj, bytes):
+            self._buffer = obj
+            self.data = obj
+        else:
+            self.raw = obj
+
+    def __len__(self):
+        return self.data and len(self.data) or 0
+
+    def __getitem__(self, index):
+        return String(self.data[index])
+
+    def __str__(self):
+        return self.data.decode("utf-8")
+
+    @classmethod
+    def from_param(cls, obj):
+        if obj is None or obj == 0:
+            return cls(ctypes.POINTER(ctypes.c_char)())
+        if isinstance(obj, (String, ctypes.c_char_p, ctypes.POINTER(ctypes.c_char))):
+            return obj
+        if isinstance(obj, bytes):
+            return cls(obj)
+        if isinstance(obj, str):
+            return cls(obj.encode("utf-8"))
+        if isinstance(obj, int):
+            return cls(ctypes.cast(obj, ctypes.POINTER(ctypes.c_char)))
+        raise TypeError(f"Cannot convert {type(obj).__name__} to String")
+
+
+FMGeneratedContentRef = ctypes.c_void_p
+FMLanguageModelSessionResponseCallback = ctypes.CFUNCTYPE(
+    None, ctypes.c_int, String, ctypes.c_size_t, ctypes.c_void_p
+)
+FMLanguageModelSessionStructuredResponseCallback = ctypes.CFUNCTYPE(
+    None, ctypes.c_int, ctypes.c_void_p, ctypes.c_void_p
+)
+FMLanguageModelSessionStreamEventCallback = ctypes.CFUNCTYPE(
+    None, ctypes.c_int, ctypes.c_int, String, ctypes.c_size_t, ctypes.c_void_p
+)
+FMLanguageModelSessionTurnCallback = ctypes.CFUNCTYPE(
+    None,
+    ctypes.c_int,
+    ctypes.c_size_t,
+    String,
+    ctypes.c_size_t,
+    ctypes.c_void_p,
+    ctypes.c_void_p,
+)
+FMTranscriptWriteCallback = ctypes.CFUNCTYPE(
+    ctypes.c_bool, String, ctypes.c_size_t, ctypes.c_void_p
+)
+
+
+def _addr(value) -> int:
+    if value is None:
+        return 0
+    if isinstance(value, ctypes.c_void_p):
+        return value.value or 0
+    if isinstance(value, ctypes._Pointer):
+        return ctypes.cast(value, ctypes.c_void_p).value or 0
+    return int(value)
+
+
+def _bytes(value, length: Optional[int] = None) -> bytes:
+    """Read a ``char *`` argument as passed by the SDK."""
+    if value is None:
+        return b""
+    if isinstance(value, str):
+        value = value.encode("utf-8")
+    if isinstance(value, (bytes, bytearray)):
+        return bytes(value if length is None else value[:length])
+    if isinstance(value, String):
+        value = value.raw
+    if length is None:
+        return ctypes.string_at(value)
+    return ctypes.string_at(value, length) if length else b""
+
+
+class _Task:
+    __slots__ = ("cancelled",)
+
+    def __init__(self):
+        self.cancelled = False
+
+
+class _Session:
+    def __init__(self, instructions: Optional[str], tools: List[int]):
+        self.tools = tools
+        self.responding = 0
+        self.entries: List[Dict[str, Any]] = []
+        if instructions:
+            self.entries.append(_entry("instructions", instructions))
+
+
+class _Stream:
+    def __init__(self, session: int, prompt: bytes):
+        self.session = session
+        self.prompt = prompt
+        self.task = _Task()
+        self.stops: List[str] = []
+        self.stopped = False
+
+    def truncate(self, text: str) -> Optional[str]:
+        """Return ``text`` cut before the earliest stop sequence, or None."""
+        cuts = [i for i in (text.find(stop) for stop in self.stops) if i >= 0]
+        return text[: min(cuts)] if cuts else None
+
+
+class _Schema:
+    def __init__(self, name: str, description: Optional[str]):
+        self.name = name
+        self.description = description
+        self.properties: List["_Property"] = []
+        self.references: List["_Schema"] = []
+
+    def to_dict(self) -> Dict[str, Any]:
+        schema: Dict[str, Any] = {
+            "title": self.name,
+            "type": "object",
+            "properties": {p.name: p.to_dict() for p in self.properties},
+            "required": [p.name for p in self.properties if not p.optional],
+        }
+        if self.description:
+            schema["description"] = self.description
+        if self.references:
+            schema["$defs"] = {r.name: r.to_dict() for r in self.references}
+        return schema
+
+
+class _Property:
+    def __init__(self, name: str, description: Optional[str], type_name: str, optional: bool):
+        self.name = name
+        self.description = description
+        self.type_name = type_name
+        self.optional = optional
+        self.guides: Dict[str, Any] = {}
+
+    def to_dict(self) -> Dict[str, Any]:
+        prop: Dict[str, Any] = {"type": self.type_name, **self.guides}
+        if self.description:
+            prop["description"] = self.description
+        return prop
+
+
+class _Content:
+    def __init__(self, value: Any):
+        self.value = value
+
+
+class _Tool:
+    def __init__(self, name: str, callable_, cancel, timeout: float, batched: bool = False):
+        self.name = name
+        self.callable = callable_
+        self.batched = batched
+        self.cancel = cancel
+        self.timeout = timeout
+        self.next_call_id = itertools.count(1)
+        self.results: Dict[int, Tuple[str, bool]] = {}
+        # Session handle of each pending call
+        self.sessions: Dict[int, int] = {}
+        self.finished = threading.Condition()
+        self.calls = 0
+        self.errors = 0
+        self.timeouts = 0
+        self.cancellations = 0
+        self.in_flight = 0
+        self.total_micros = 0
+        self.max_micros = 0
+
+
+_ARRAY_TYPE = re.compile(r"array<(\w+)>")
+_ELEMENT_GUIDES = ("enum", "pattern", "minimum", "maximum")
+
+
+def _validate_document(objects: Dict[str, _Schema], root: str, document: bytes) -> List[Dict[str, str]]:
+    """Check a document against a schema's types and guides, like the native validator."""
+    violations: List[Dict[str, str]] = []
+
+    def report(path, guide, message):
+        violations.append({"path": path, "guide": guide, "message": message})
+
+    def check_guides(value, guides, path):
+        if "enum" in guides and isinstance(value, str) and value not in guides["enum"]:
+            report(path, "anyOf", f'"{value}" is not one of the allowed choices')
+        # re.fullmatch stands in for Swift's Regex.wholeMatch: both try every
+        # alternative for a whole-string match, but Python's . and classes match
+        # code points where Swift matches grapheme clusters
+        if "pattern" in guides and isinstance(value, str) and not re.fullmatch(guides["pattern"], value):
+            report(path, "regex", f'"{value}" does not match /{guides["pattern"]}/')
+        if isinstance(value, (int, float)) and not isinstance(value, bool):
+            if "minimum" in guides and value < guides["minimum"]:
+                report(path, "minimum", f"{value} is less than the minimum {guides['minimum']}")
+            if "maximum" in guides and value > guides["maximum"]:
+                report(path, "maximum", f"{value} is greater than the maximum {guides['maximum']}")
+        if isinstance(value, list):
+            for guide, fails in (
+                ("count", lambda n: len(value) != n),
+                ("minItems", lambda n: len(value) < n),
+                ("maxItems", lambda n: len(value) > n),
+            ):
+                if guide in guides and fails(guides[guide]):
+                    report(path, guide, f"Expected {guide} {guides[guide]}, got {len(value)} items")
+
+    def check_value(value, type_name, guides, path):
+        match = _ARRAY_TYPE.fullmatch(type_name)
+        if type_name.startswith("array<"):
+            if not isinstance(value, list):
+                return report(path, "type", f"Expected {type_name}")
+            element_guides = {k[len("items."):]: v for k, v in guides.items() if k.startswith("items.")}
+            element_guides.update({k: v for k, v in guides.items() if k in _ELEMENT_GUIDES})
+            check_guides(value, {k: v for k, v in guides.items() if k not in _ELEMENT_GUIDES}, path)
+            for index, element in enumerate(value):
+                check_value(element, match.group(1) if match else "string", element_guides, f"{path}[{index}]")
+            return
+        if type_name in ("string", ""):
+            if not isinstance(value, str):
+                return report(path, "type", "Expected string")
+        elif type_name in ("boolean", "bool"):
+            if not isinstance(value, bool):
+                return report(path, "type", "Expected boolean")
+        elif type_name in ("number", "float", "double", "integer", "int"):
+            if isinstance(value, bool) or not isinstance(value, (int, float)):
+                return report(path, "type", f"Expected {type_name}")
+            if type_name in ("integer", "int") and value != int(value):
+                return report(path, "type", "Expected integer")
+        else:
+            return check_object(value, type_name, path)
+        check_guides(value, guides, path)
+
+    def check_object(value, name, path):
+        schema = objects.get(name)
+        if schema is None:
+            return
+        if not isinstance(value, dict):
+            return report(path, "type", f"Expected an object of type {name}")
+        for prop in schema.properties:
+            prop_path = f"{path}.{prop.name}" if path else prop.name
+            if value.get(prop.name) is None:
+                if not prop.optional:
+                    report(prop_path, "required", "Missing required property")
+                continue
+            check_value(value[prop.name], prop.type_name, prop.guides, prop_path)
+
+    try:
+        parsed = json.loads(document)
+    except ValueError as e:
+        return [{"path": "", "guide": "json", "message": f"Invalid JSON: {e}"}]
+    check_object(parsed, root, "")
+    return violations
+
+
+def _encode_columns(rows: List[Any], columns: List[Tuple[str, int]]) -> bytes:
+    """Pure-Python FMGeneratedContentBatchEncodeColumns, with the same layout."""
+    out = bytearray()
+    for name, kind in columns:
+        bitmap = bytearray((len(rows) + 7) // 8)
+        present = []
+        for row, properties in enumerate(rows):
+            value = properties.get(name)
+            if value is not None:
+                bitmap[row >> 3] |= 1 << (row & 7)
+            present.append(value)
+        out += bitmap
+
+        def mismatch(row: int, expected: str) -> ValueError:
+            return ValueError(f"Property '{name}' in row {row} is not {expected}")
+
+        if kind in (0, 1, 2):
+            values = array("qdB"[kind], bytes(len(rows) * (8 if kind < 2 else 1)))
+            for row, value in enumerate(present):
+                if value is None:
+                    continue
+                if kind == 2:
+                    if not isinstance(value, bool):
+                        raise mismatch(row, "a boolean")
+                elif isinstance(value, bool) or not isinstance(value, (int, float)):
+                    raise mismatch(row, "an integer" if kind == 0 else "a number")
+                elif kind == 0 and value != int(value):
+                    raise mismatch(row, "an integer")
+                values[row] = int(value) if kind != 1 else float(value)
+            out += values.tobytes()
+        else:
+            offsets = array("q", [0])
+            data = bytearray()
+            for row, value in enumerate(present):
+                if value is not None:
+                    if kind == 4:
+                        data += json.dumps(value).encode("utf-8")
+                    elif isinstance(value, str):
+                        data += value.encode("utf-8")
+                    else:
+                        raise mismatch(row, "a string")
+                offsets.append(len(data))
+            out += offsets.tobytes() + data
+    return bytes(out)
+
+
+def _entry(role: str, text: str) -> Dict[str, Any]:
+    entry: Dict[str, Any] = {
+        "id": os.urandom(8).hex(),
+        "role": role,
+        "contents": [{"type": "text", "text": text, "id": os.urandom(8).hex()}],
+    }
+    if role == "response":
+        entry["assets"] = []
+    return entry
+
+
+class _ReplayBackend:
+    """Implements the C API on top of a list of recorded requests."""
+
+    def __init__(self, records: List[Dict[str, Any]], speed: float = 1.0):
+        if speed < 0:
+            raise ValueError(f"Replay speed must not be negative, got {speed}")
+        self.speed = speed
+        self.originals: Dict[str, Callable] = {}
+        self._lock = threading.Lock()
+        self._objects: Dict[int, Any] = {}
+        self._refcounts: Dict[int, int] = {}
+        self._next_handle = itertools.count(0x10000, 0x10)
+        self._error_strings: Dict[int, Any] = {}
+        self._records: Dict[Tuple[str, Optional[str]], Deque[Dict[str, Any]]] = {}
+        self._last: Dict[Tuple[str, Optional[str]], Dict[str, Any]] = {}
+        for record in records:
+            key = (record["prompt"], record.get("schema"))
+            self._records.setdefault(key, deque()).append(record)
+
+    def functions(self) -> Dict[str, Callable]:
+        """The C functions implemented by the backend, by name."""
+        return {
+            name: getattr(self, name)
+            for name in dir(type(self))
+            if name.startswith("FM") and callable(getattr(self, name))
+        }
+
+    # MARK: Object handles
+
+    def _new(self, obj) -> int:
+        with self._lock:
+            handle = next(self._next_handle)
+            self._objects[handle] = obj
+            self._refcounts[handle] = 1
+        return handle
+
+    def _get(self, handle):
+        return self._objects[_addr(handle)]
+
+    def _owns(self, handle) -> bool:
+        return _addr(handle) in self._objects
+
+    def _native(self, name: str, *args):
+        original = self.originals.get(name)
+        if original is None:
+            raise KeyError(f"{name} called with an object that is not part of the replay")
+        return original(*args)
+
+    def _take(self, prompt: bytes, schema: Optional[str]) -> Optional[Dict[str, Any]]:
+        key = (prompt.decode("utf-8", errors="replace"), schema)
+        with self._lock:
+            queue = self._records.get(key)
+            if queue:
+                self._last[key] = queue.popleft()
+            return self._last.get(key)
+
+    def _schema_key(self, schema) -> str:
+        if self._owns(schema):
+            return "schema:" + self._get(schema).name
+        error_code = ctypes.c_int32()
+        error_description = ctypes.POINTER(ctypes.c_char)()
+        json_str = self._native(
+            "FMGenerationSchemaGetJSONString",
+            schema,
+            ctypes.byref(error_code),
+            ctypes.byref(error_description),
+        )
+        return _schema_key_from_json(str(json_str))
+
+    def _set_error(self, out_code, out_description, code: int, message: str):
+        if out_code is not None:
+            out_code._obj.value = code
+        if out_description is not None:
+            buffer = ctypes.create_string_buffer(message.encode("utf-8"))
+            pointer = ctypes.cast(buffer, ctypes.POINTER(ctypes.c_char))
+            with self._lock:
+                self._error_strings[_addr(pointer)] = buffer
+            ctypes.pointer(out_description._obj)[0] = pointer
+
+    # MARK: Timing
+
+    def _wait_until(self, start: float, offset: float, task: Optional[_Task] = None):
+        if self.speed == 0:
+            return
+        deadline = start + offset / self.speed
+        while True:
+            remaining = deadline - time.monotonic()
+            if remaining <= 0 or (task is not None and task.cancelled):
+                return
+            time.sleep(min(remaining, 0.05))
+
+    def _run(self, target, *args):
+        threading.Thread(target=target, args=args, daemon=True).start()
+
+    # MARK: Replayed requests
+
+    def _replay_tool_call(self, session_handle, call: Dict[str, Any], task: _Task, on_event=None):
+        session = self._get(session_handle)
+        tool_handle = next(
+            (t for t in session.tools if self._owns(t) and self._get(t).name == call["name"]),
+            None,
+        )
+        if tool_handle is None:
+            return 0.0
+        tool = self._get(tool_handle)
+        call_id = next(tool.next_call_id)
+        if on_event:
+            on_event(2, {"callId": call_id, "name": tool.name, "arguments": call.get("arguments", {})})
+        started = time.monotonic()
+        content = self._new(_Content(call.get("arguments", {})))
+        with tool.finished:
+            tool.sessions[call_id] = _addr(session_handle)
+        with self._lock:
+            tool.in_flight += 1
+        if tool.batched:
+            # Recorded calls are replayed one after another, so each is a batch of one
+            tool.callable((ctypes.c_void_p * 1)(content), (ctypes.c_uint * 1)(call_id), 1)
+        else:
+            tool.callable(content, call_id)
+        deadline = started + (tool.timeout or _TOOL_CALL_TIMEOUT)
+        with tool.finished:
+            # Like the native bridge, cancelling the request abandons the pending call
+            while call_id not in tool.results and not task.cancelled:
+                remaining = deadline - time.monotonic()
+                if remaining <= 0:
+                    break
+                tool.finished.wait(min(remaining, 0.05))
+            result = tool.results.pop(call_id, None)
+            del tool.sessions[call_id]
+        duration = time.monotonic() - started
+        if result is not None:
+            outcome = "error" if result[1] else "success"
+        else:
+            outcome = "cancelled" if task.cancelled else "timeout"
+            if tool.cancel:
+                tool.cancel(call_id)
+        micros = int(duration * 1e6)
+        with self._lock:
+            tool.in_flight -= 1
+            tool.calls += 1
+            tool.errors += outcome == "error"
+            tool.timeouts += outcome == "timeout"
+            tool.cancellations += outcome == "cancelled"
+            tool.total_micros += micros
+            tool.max_micros = max(tool.max_micros, micros)
+        if on_event:
+            on_event(3, {"callId": call_id, "name": tool.name, "durationSeconds": duration, "outcome": outcome})
+        return duration
+
+    def _serve(self, session_handle, prompt: bytes, schema: Optional[str], task: _Task, on_snapshot=None, on_event=None, stream=None):
+        """Replay one request. Returns ``(status, output_or_error)``.
+
+        A ``stream`` with stop sequences ends the response at the first one.
+        Like the framework, a session serves one request at a time.
+        """
+        session = self._get(session_handle)
+        with self._lock:
+            if session.responding:
+                return _CONCURRENT_REQUESTS, "The session is already responding to a request"
+            session.responding += 1
+        record = self._take(prompt, schema)
+        if record is None:
+            with self._lock:
+                session.responding -= 1
+            preview = prompt[:80].decode("utf-8", errors="replace")
+            return _UNKNOWN_ERROR, f"No recorded response for prompt {preview!r}"
+
+        start = time.monotonic()
+        stopped = None
+        try:
+            steps = [(call["at"], "tool", call) for call in record.get("tools", [])]
+            steps += [(at, "snapshot", text) for at, text in record.get("snapshots", [])]
+            for at, kind, value in sorted(steps, key=lambda step: step[0]):
+                self._wait_until(start, at, task)
+                if task.cancelled:
+                    break
+                if kind == "tool":
+                    self._replay_tool_call(session_handle, value, task, on_event)
+                    continue
+                if stream is not None:
+                    stopped = stream.truncate(value)
+                if on_snapshot:
+                    on_snapshot(value if stopped is None else stopped)
+                if stopped is not None:
+                    break
+            if stopped is None:
+                self._wait_until(start, record.get("elapsed", 0.0), task)
+        finally:
+            with self._lock:
+                session.responding -= 1
+
+        if task.cancelled:
+            return _UNKNOWN_ERROR, "Operation cancelled"
+        status = record.get("status", 0)
+        if status and stopped is None:
+            return status, record.get("error", "")
+        output = record.get("output") if stopped is None else stopped
+        if stream is not None and stopped is None and isinstance(output, str):
+            stopped = stream.truncate(output)
+            if stopped is not None:
+                output = stopped
+        if stream is not None:
+            stream.stopped = stopped is not None
+        session.entries.append(_entry("user", prompt.decode("utf-8", errors="replace")))
+        session.entries.append(
+            _entry("response", output if isinstance(output, str) else json.dumps(output))
+        )
+        return 0, output
+
+    # MARK: Memory
+
+    def FMRetain(self, obj):
+        if not self._owns(obj):
+            return self._native("FMRetain", obj)
+        with self._lock:
+            self._refcounts[_addr(obj)] += 1
+
+    def FMRelease(self, obj):
+        handle = _addr(obj)
+        if handle not in self._objects:
+            return self._native("FMRelease", obj)
+        with self._lock:
+            self._refcounts[handle] -= 1
+            if self._refcounts[handle] == 0:
+                del self._refcounts[handle]
+                obj = self._objects.pop(handle)
+                if isinstance(obj, _Stream):
+                    # Like the native stream box, releasing the stream cancels it
+                    obj.task.cancelled = True
+
+    def FMReleaseMany(self, objects, count):
+        foreign = []
+        for i in range(count):
+            if not objects[i]:
+                continue
+            if self._owns(objects[i]):
+                self.FMRelease(objects[i])
+            else:
+                foreign.append(objects[i])
+        if foreign:
+            self._native("FMReleaseMany", (ctypes.c_void_p * len(foreign))(*foreign), len(foreign))
+
+    def FMFreeString(self, string):
+        with self._lock:
+            if self._error_strings.pop(_addr(string), None) is not None:
+                return
+        if string:
+            return self._native("FMFreeString", string)
+
+    def FMTaskCancel(self, task):
+        if not self._owns(task):
+            return self._native("FMTaskCancel", task)
+        self._get(task).cancelled = True
+
+    # MARK: Models and sessions
+
+    def FMSystemLanguageModelGetDefault(self):
+        return self._new(object())
+
+    def FMSystemLanguageModelCreate(self, use_case, guardrails):
+        return self._new(object())
+
+    def FMSystemLanguageModelIsAvailable(self, model, reason):
+        return True
+
+    def FMLanguageModelSessionCreateDefault(self):
+        return self._new(_Session(None, []))
+
+    def FMLanguageModelSessionCreateFromSystemLanguageModel(self, model, instructions, tools, tool_count):
+        text = _bytes(instructions).decode("utf-8") if instructions else None
+        tool_handles = [_addr(tools[i]) for i in range(tool_count)] if tools else []
+        return self._new(_Session(text, tool_handles))
+
+    def FMLanguageModelSessionCreateFromTranscriptJSON(
+        self, model, transcript, length, tools, tool_count, out_code, out_description
+    ):
+        try:
+            entries = json.loads(_bytes(transcript, length))["transcript"]["entries"]
+        except (ValueError, KeyError, TypeError) as e:
+            self._set_error(out_code, out_description, 6, f"Invalid transcript: {e}")
+            return None
+        tool_handles = [_addr(tools[i]) for i in range(tool_count)] if tools else []
+        session = _Session(None, tool_handles)
+        session.entries = list(entries)
+        return self._new(session)
+
+    def FMLanguageModelSessionIsResponding(self, session):
+        return self._get(session).responding > 0
+
+    def FMLanguageModelSessionReset(self, session):
+        pass
+
+    # MARK: Text requests
+
+    def FMLanguageModelSessionRespondBytes(self, session, prompt, length, user_info, callback):
+        task = _Task()
+        text = _bytes(prompt, length)
+
+        def run():
+            status, output = self._serve(session, text, None, task)
+            data = (output if isinstance(output, str) else json.dumps(output)).encode("utf-8")
+            callback(status, data, len(data), user_info)
+
+        self._run(run)
+        return self._new(task)
+
+    def FMLanguageModelSessionRespond(self, session, prompt, user_info, callback):
+        data = _bytes(prompt)
+        return self.FMLanguageModelSessionRespondBytes(session, data, len(data), user_info, callback)
+
+    def FMLanguageModelSessionEnqueue(self, session, prompts, lengths, schemas, count, user_info, callback):
+        task = _Task()
+        turns = [
+            (
+                _bytes(prompts[i], lengths[i]),
+                self._schema_key(schemas[i]) if schemas and schemas[i] else None,
+            )
+            for i in range(count)
+        ]
+
+        def run():
+            for index, (prompt, schema) in enumerate(turns):
+                status, output = self._serve(session, prompt, schema, task)
+                if status:
+                    data = output.encode("utf-8")
+                    callback(status, index, data, len(data), None, user_info)
+                    return
+                if schema is None:
+                    data = output.encode("utf-8")
+                    callback(0, index, data, len(data), None, user_info)
+                else:
+                    callback(0, index, None, 0, self._new(_Content(output)), user_info)
+
+        self._run(run)
+        return self._new(task)
+
+    # MARK: Structured requests
+
+    def _respond_structured(self, session, prompt: bytes, schema: str, user_info, callback):
+        task = _Task()
+
+        def run():
+            status, output = self._serve(session, prompt, schema, task)
+            content = self._new(_Content(output if status == 0 else {"error": output}))
+            callback(status, content, user_info)
+
+        self._run(run)
+        return self._new(task)
+
+    def FMLanguageModelSessionRespondBytesWithSchema(self, session, prompt, length, schema, user_info, callback):
+        return self._respond_structured(
+            session, _bytes(prompt, length), self._schema_key(schema), user_info, callback
+        )
+
+    def FMLanguageModelSessionRespondWithSchema(self, session, prompt, schema, user_info, callback):
+        data = _bytes(prompt)
+        return self.FMLanguageModelSessionRespondBytesWithSchema(session, data, len(data), schema, user_info, callback)
+
+    def FMLanguageModelSessionRespondBytesWithSchemaFromJSON(self, session, prompt, length, schema_json, user_info, callback):
+        return self._respond_structured(
+            session, _bytes(prompt, length), _json_schema_key(_bytes(schema_json)), user_info, callback
+        )
+
+    def FMLanguageModelSessionRespondWithSchemaFromJSON(self, session, prompt, schema_json, user_info, callback):
+        data = _bytes(prompt)
+        return self.FMLanguageModelSessionRespondBytesWithSchemaFromJSON(session, data, len(data), schema_json, user_info, callback)
+
+    # MARK: Streams
+
+    def FMLanguageModelSessionStreamResponseBytes(self, session, prompt, length):
+        return self._new(_Stream(_addr(session), _bytes(prompt, length)))
+
+    def FMLanguageModelSessionStreamResponse(self, session, prompt):
+        data = _bytes(prompt)
+        return self.FMLanguageModelSessionStreamResponseBytes(session, data, len(data))
+
+    def FMLanguageModelSessionResponseStreamSetStopSequences(self, stream_handle, sequences, lengths, count):
+        stream = self._get(stream_handle)
+        stream.stops = [
+            _bytes(sequences[i], lengths[i]).decode("utf-8", errors="replace")
+            for i in range(count)
+            if sequences[i] and lengths[i]
+        ]
+
+    def FMLanguageModelSessionResponseStreamCancel(self, stream_handle):
+        self._get(stream_handle).task.cancelled = True
+
+    def _iterate(self, stream_handle, run):
+        self._run(run, self._get(stream_handle))
+
+    def FMLanguageModelSessionResponseStreamIterate(self, stream_handle, user_info, callback):
+        def run(stream):
+            def on_snapshot(text):
+                data = text.encode("utf-8")
+                callback(0, data, len(data), user_info)
+
+            status, output = self._serve(stream.session, stream.prompt, None, stream.task, on_snapshot, stream=stream)
+            if status:
+                data = output.encode("utf-8")
+                callback(status, data, len(data), user_info)
+            else:
+                callback(0, None, 0, user_info)
+
+        self._iterate(stream_handle, run)
+
+    def FMLanguageModelSessionResponseStreamIterateEvents(self, stream_handle, tools, tool_count, user_info, callback):
+        def emit(event_type, payload, status=0):
+            data = (payload if isinstance(payload, str) else json.dumps(payload)).encode("utf-8")
+            callback(status, event_type, data, len(data), user_info)
+
+        def run(stream):
+            start = time.monotonic()
+            state = {"text": "", "first": None, "snapshots": 0, "calls": 0, "seconds": 0.0}
+
+            def on_snapshot(text):
+                state["snapshots"] += 1
+                if text.startswith(state["text"]):
+                    delta = text[len(state["text"]):]
+                    if delta:
+                        state["first"] = state["first"] or time.monotonic() - start
+                        emit(0, delta)
+                else:
+                    emit(1, text)
+                state["text"] = text
+
+            def on_event(event_type, payload):
+                if event_type == 3:
+                    state["calls"] += 1
+                    state["seconds"] += payload["durationSeconds"]
+                emit(event_type, payload)
+
+            status, output = self._serve(
+                stream.session, stream.prompt, None, stream.task, on_snapshot, on_event, stream=stream
+            )
+            if status:
+                emit(4, output, status=status)
+                return
+            if output != state["text"]:
+                on_snapshot(output)
+            emit(4, {
+                "text": output,
+                "durationSeconds": time.monotonic() - start,
+                "timeToFirstTextSeconds": state["first"],
+                "snapshots": state["snapshots"],
+                "toolCalls": state["calls"],
+                "toolSeconds": state["seconds"],
+                "stopped": stream.stopped,
+            })
+
+        self._iterate(stream_handle, run)
+
+    # MARK: Transcripts
+
+    def _transcript_lines(self, session) -> List[bytes]:
+        return [json.dumps(entry).encode("utf-8") + b"\n" for entry in self._get(session).entries]
+
+    def FMLanguageModelSessionGetTranscriptJSONString(self, session, out_code, out_description):
+        transcript = {
+            "version": 1,
+            "type": "FoundationModels.Transcript",
+            "transcript": {"entries": self._get(session).entries},
+        }
+        return String(json.dumps(transcript).encode("utf-8"))
+
+    def FMLanguageModelSessionGetTranscriptJSONStringWithIndex(self, session, out_index, out_code, out_description):
+        head = b'{"version": 1, "type": "FoundationModels.Transcript", "transcript": {"entries": ['
+        parts = [head]
+        offset = len(head)
+        index = []
+        for entry in self._get(session).entries:
+            if len(parts) > 1:
+                parts.append(b", ")
+                offset += 2
+            raw = json.dumps(entry).encode("utf-8")
+            names = [entry["toolName"]] if "toolName" in entry else [
+                call.get("name") for call in entry.get("toolCalls", [])
+            ]
+            index.append([offset, offset + len(raw), entry.get("role", ""), entry.get("id", ""), names])
+            parts.append(raw)
+            offset += len(raw)
+        parts.append(b"]}}")
+        buffer = ctypes.create_string_buffer(json.dumps(index).encode("utf-8"))
+        pointer = ctypes.cast(buffer, ctypes.POINTER(ctypes.c_char))
+        with self._lock:
+            # Freed through FMFreeString like an error description
+            self._error_strings[_addr(pointer)] = buffer
+        ctypes.pointer(out_index._obj)[0] = pointer
+        return String(b"".join(parts))
+
+    def FMTranscriptIndexJSON(self, data, length, jsonl, out_index, out_code, out_description):
+        if "FMTranscriptIndexJSON" in self.originals:
+            return self._native("FMTranscriptIndexJSON", data, length, jsonl, out_index, out_code, out_description)
+        try:
+            index = _index_transcript(_bytes(data, length), bool(jsonl))
+        except ValueError as e:
+            self._set_error(out_code, out_description, _UNKNOWN_ERROR, str(e))
+            return -1
+        buffer = ctypes.create_string_buffer(json.dumps(index).encode("utf-8"))
+        pointer = ctypes.cast(buffer, ctypes.POINTER(ctypes.c_char))
+        with self._lock:
+            # Freed through FMFreeString like an error description
+            self._error_strings[_addr(pointer)] = buffer
+        ctypes.pointer(out_index._obj)[0] = pointer
+        return len(index)
+
+    def FMLanguageModelSessionExportTranscriptJSONLToFileDescriptor(self, session, fd, out_code, out_description):
+        lines = self._transcript_lines(session)
+        for line in lines:
+            os.write(fd, line)
+        return len(lines)
+
+    def FMLanguageModelSessionExportTranscriptJSONL(self, session, user_info, callback, out_code, out_description):
+        lines = self._transcript_lines(session)
+        for line in lines:
+            if not callback(line, len(line), user_info):
+                self._set_error(out_code, out_description, _UNKNOWN_ERROR, "Transcript export aborted by write callback")
+                return -1
+        return len(lines)
+
+    # MARK: Schemas
+
+    def FMGenerationSchemaCreate(self, name, description):
+        return self._new(_Schema(_bytes(name).decode("utf-8"), _bytes(description).decode("utf-8") if description else None))
+
+    def FMGenerationSchemaPropertyCreate(self, name, description, type_name, optional):
+        return self._new(_Property(
+            _bytes(name).decode("utf-8"),
+            _bytes(description).decode("utf-8") if description else None,
+            _bytes(type_name).decode("utf-8"),
+            bool(optional),
+        ))
+
+    def _guide(self, prop, key: str, value, wrapped=False):
+        self._get(prop).guides[("items." if wrapped else "") + key] = value
+
+    def FMGenerationSchemaPropertyAddAnyOfGuide(self, prop, choices, count, wrapped):
+        self._guide(prop, "enum", [_bytes(choices[i]).decode("utf-8") for i in range(count)], wrapped)
+
+    def FMGenerationSchemaPropertyAddCountGuide(self, prop, count, wrapped):
+        self._guide(prop, "count", count, wrapped)
+
+    def FMGenerationSchemaPropertyAddMaximumGuide(self, prop, maximum, wrapped):
+        self._guide(prop, "maximum", maximum, wrapped)
+
+    def FMGenerationSchemaPropertyAddMinimumGuide(self, prop, minimum, wrapped):
+        self._guide(prop, "minimum", minimum, wrapped)
+
+    def FMGenerationSchemaPropertyAddMinItemsGuide(self, prop, min_items, wrapped=False):
+        # Like the native function, item-count guides always apply to the array
+        self._guide(prop, "minItems", min_items)
+
+    def FMGenerationSchemaPropertyAddMaxItemsGuide(self, prop, max_items, wrapped=False):
+        self._guide(prop, "maxItems", max_items)
+
+    def FMGenerationSchemaPropertyAddRangeGuide(self, prop, minimum, maximum, wrapped):
+        self._guide(prop, "minimum", minimum, wrapped)
+        self._guide(prop, "maximum", maximum, wrapped)
+
+    def FMGenerationSchemaPropertyAddRegex(self, prop, pattern, wrapped):
+        self._guide(prop, "pattern", _bytes(pattern).decode("utf-8"), wrapped)
+
+    def FMGenerationSchemaAddProperty(self, schema, prop):
+        self._get(schema).properties.append(self._get(prop))
+
+    def FMGenerationSchemaAddReferenceSchema(self, schema, reference):
+        self._get(schema).references.append(self._get(reference))
+
+    def FMGenerationSchemaGetJSONString(self, schema, out_code, out_description):
+        if not self._owns(schema):
+            return self._native("FMGenerationSchemaGetJSONString", schema, out_code, out_description)
+        return String(json.dumps(self._get(schema).to_dict()).encode("utf-8"))
+
+    def FMGenerationSchemaValidateJSONBatch(self, schema, documents, lengths, count, out_code, out_description):
+        if not self._owns(schema):
+            return self._native(
+                "FMGenerationSchemaValidateJSONBatch", schema, documents, lengths, count, out_code, out_description
+            )
+        root = self._get(schema)
+        objects = {reference.name: reference for reference in root.references}
+        objects[root.name] = root
+        report = [
+            _validate_document(objects, root.name, _bytes(documents[i], lengths[i]))
+            for i in range(count)
+        ]
+        return String(json.dumps(report).encode("utf-8"))
+
+    # MARK: Generated content
+
+    def FMGeneratedContentCreateFromJSON(self, json_string, out_code, out_description):
+        try:
+            value = json.loads(_bytes(json_string))
+        except ValueError as e:
+            # Matches the native decoding failure status
+            self._set_error(out_code, out_description, 7, f"Invalid JSON: {e}")
+            return None
+        if out_code is not None:
+            out_code._obj.value = 0
+        return self._new(_Content(value))
+
+    def FMGeneratedContentBatchEncodeColumns(
+        self, contents, count, names, kinds, column_count, out_buffer, out_code, out_description
+    ):
+        if count and not self._owns(contents[0]):
+            return self._native(
+                "FMGeneratedContentBatchEncodeColumns",
+                contents, count, names, kinds, column_count, out_buffer, out_code, out_description,
+            )
+        rows = [self._get(contents[i]).value for i in range(count)]
+        columns = [(_bytes(names[i]).decode("utf-8"), kinds[i]) for i in range(column_count)]
+        try:
+            if not all(isinstance(row, dict) for row in rows):
+                raise ValueError("Row is not a structure")
+            data = _encode_columns(rows, columns)
+        except ValueError as e:
+            self._set_error(out_code, out_description, 6, str(e))
+            return -1
+        buffer = ctypes.create_string_buffer(data, max(len(data), 1))
+        pointer = ctypes.cast(buffer, ctypes.POINTER(ctypes.c_char))
+        with self._lock:
+            # Freed through FMFreeString like an error description
+            self._error_strings[_addr(pointer)] = buffer
+        ctypes.pointer(out_buffer._obj)[0] = pointer
+        return len(data)
+
+    def FMGeneratedContentGetJSONString(self, content):
+        if not self._owns(content):
+            return self._native("FMGeneratedContentGetJSONString", content)
+        return String(json.dumps(self._get(content).value).encode("utf-8"))
+
+    def FMGeneratedContentGetPropertyValue(self, content, name, out_code, out_description):
+        value = self._get(content).value.get(_bytes(name).decode("utf-8"))
+        return String(json.dumps(value).encode("utf-8"))
+
+    def FMGeneratedContentIsComplete(self, content):
+        if not self._owns(content):
+            return self._native("FMGeneratedContentIsComplete", content)
+        return True
+
+    # MARK: Tools
+
+    def FMBridgedToolCreateWithTimeout(self, name, description, parameters, callable_, cancel, timeout, out_code, out_description):
+        return self._new(_Tool(_bytes(name).decode("utf-8"), callable_, cancel, timeout))
+
+    def FMBridgedToolCreate(self, name, description, parameters, callable_, out_code, out_description):
+        return self.FMBridgedToolCreateWithTimeout(name, description, parameters, callable_, None, 0.0, out_code, out_description)
+
+    def FMBridgedToolCreateBatched(
+        self, name, description, parameters, callable_, cancel, timeout, window, size, out_code, out_description
+    ):
+        return self._new(_Tool(_bytes(name).decode("utf-8"), callable_, cancel, timeout, batched=True))
+
+    def _finish_tool_call(self, tool_handle, call_id, output, failed: bool):
+        tool = self._get(tool_handle)
+        with tool.finished:
+            # Calls that timed out or were cancelled are no longer pending
+            if call_id not in tool.sessions:
+                return
+            tool.results[call_id] = (_bytes(output).decode("utf-8", errors="replace"), failed)
+            tool.finished.notify_all()
+
+    def FMBridgedToolFinishCall(self, tool, call_id, output):
+        if not self._owns(tool):
+            return self._native("FMBridgedToolFinishCall", tool, call_id, output)
+        self._finish_tool_call(tool, call_id, output, failed=False)
+
+    def FMBridgedToolFailCall(self, tool, call_id, output):
+        if not self._owns(tool):
+            return self._native("FMBridgedToolFailCall", tool, call_id, output)
+        self._finish_tool_call(tool, call_id, output, failed=True)
+
+    def FMBridgedToolFinishCalls(self, tool, call_ids, outputs, failed, count):
+        if not self._owns(tool):
+            return self._native("FMBridgedToolFinishCalls", tool, call_ids, outputs, failed, count)
+        for i in range(count):
+            if outputs[i] is not None:
+                self._finish_tool_call(tool, call_ids[i], outputs[i], failed=bool(failed and failed[i]))
+
+    def FMBridgedToolGetCallSession(self, tool_handle, call_id):
+        if not self._owns(tool_handle):
+            return self._native("FMBridgedToolGetCallSession", tool_handle, call_id)
+        tool = self._get(tool_handle)
+        with tool.finished:
+            return tool.sessions.get(call_id)
+
+    def FMBridgedToolGetStatsJSONString(self, tool_handle):
+        if not self._owns(tool_handle):
+            return self._native("FMBridgedToolGetStatsJSONString", tool_handle)
+        tool = self._get(tool_handle)
+        stats = {
+            "calls": tool.calls,
+            "errors": tool.errors,
+            "timeouts": tool.timeouts,
+            "cancellations": tool.cancellations,
+            "inFlight": tool.in_flight,
+            "totalMicros": tool.total_micros,
+            "maxMicros": tool.max_micros,
+            "buckets": [],
+        }
+        return String(json.dumps(stats).encode("utf-8"))
+
+    def FMBridgedToolResetStats(self, tool_handle):
+        if not self._owns(tool_handle):
+            return self._native("FMBridgedToolResetStats", tool_handle)
+        tool = self._get(tool_handle)
+        # Like the native stats, calls in flight are still counted after a reset
+        tool.calls = tool.errors = tool.timeouts = tool.cancellations = 0
+        tool.total_micros = tool.max_micros = 0
+
+
+def _guard_memory_functions(lib) -> None:
+    """Make the native memory functions ignore replay handles.
+
+    Objects created during a replay may be released after it ends, once the
+    native functions are back in place.
+    """
+    if getattr(lib, "_replay_guarded", False):
+        return
+    retain, release, release_many = lib.FMRetain, lib.FMRelease, lib.FMReleaseMany
+
+    def guarded_retain(obj):
+        if _addr(obj) >= _NATIVE_POINTER_FLOOR:
+            retain(obj)
+
+    def guarded_release(obj):
+        if _addr(obj) >= _NATIVE_POINTER_FLOOR:
+            release(obj)
+
+    def guarded_release_many(objects, count):
+        native = [objects[i] for i in range(count) if _addr(objects[i]) >= _NATIVE_POINTER_FLOOR]
+        if native:
+            release_many((ctypes.c_void_p * len(native))(*native), len(native))
+
+    lib.FMRetain, lib.FMRelease, lib.FMReleaseMany = guarded_retain, guarded_release, guarded_release_many
+    lib._replay_guarded = True
+
+
+def _install_as_bindings(path: str, speed: float) -> None:
+    """Serve the package's bindings from a trace instead of the native library."""
+    backend = _ReplayBackend(_load_trace(path), speed)
+    module = sys.modules[__name__]
+    for name, function in backend.functions().items():
+        setattr(module, name, function)
+    package = __name__.rpartition(".")[0]
+    sys.modules[package + "._ctypes_bindings"] = module
@@ -0,0 +1,240 @@
+# For licensing see accompanying LICENSE file.
+# Copyright (C) 2026 Apple Inc. All Rights Reserved.
+
+"""
+Fan-out of one streamed response to many subscribers.
+
+Several observers often watch the same generation: clients showing the
+response, a logger, a moderation hook. Giving each its own
+:meth:`~apple_fm_sdk.LanguageModelSession.stream_response` would generate the
+same turn several times. A :class:`BroadcastStream` is backed by one native
+stream iteration and shares its snapshots with every
+:class:`StreamSubscription`.
+
+Each snapshot holds the whole response so far, so a subscriber never needs
+the snapshots it missed:
+
+* A subscriber that joins late starts at the latest snapshot
+* A subscriber that falls behind skips to the latest snapshot when it asks
+  for the next one, rather than working through a backlog
+* The stream never waits for subscribers, so a slow subscriber cannot stall
+  the others or the generation
+
+Example:
+    ::
+
+        import asyncio
+        import apple_fm_sdk as fm
+
+        session = fm.LanguageModelSession()
+        broadcast = session.broadcast_response("Write a haiku about rivers")
+
+        async def show(subscription):
+            async for text in subscription:
+                print(text)
+
+        await asyncio.gather(
+            show(broadcast.subscribe()),
+            show(broadcast.subscribe()),
+        )
+        print(await broadcast.result())
+"""
+
+import asyncio
+from typing import Callable, Optional
+
+from .c_helpers import _unregister_handle
+from .errors import GenerationErrorCode, _status_code_to_exception
+
+try:
+    from . import _ctypes_bindings as lib
+except ImportError:
+    raise ImportError(
+        "Foundation Models C bindings not found. Please ensure _foundationmodels_ctypes.py is available."
+    )
+
+
+class StreamSubscription:
+    """One subscriber's cursor into a :class:`BroadcastStream`.
+
+    Iterate the subscription with ``async for`` to receive snapshots of the
+    response. Each snapshot is the latest one at the time it is received.
+    Iteration ends when the response is complete. If the stream failed, the
+    error is raised after the last snapshot.
+
+    :ivar position: Number of the last snapshot received, counting from 1,
+        or 0 before the first
+    :vartype position: int
+    :ivar received: Number of snapshots this subscriber received
+    :vartype received: int
+    """
+
+    def __init__(self, stream: "BroadcastStream"):
+        self._stream = stream
+        self.position = 0
+        self.received = 0
+
+    @property
+    def skipped(self) -> int:
+        """Number of snapshots this subscriber did not receive because newer ones had arrived.
+
+        :rtype: int
+        """
+        return self.position - self.received
+
+    def __aiter__(self) -> "StreamSubscription":
+        return self
+
+    async def __anext__(self) -> str:
+        stream = self._stream
+        while True:
+            if stream._version > self.position:
+                self.position = stream._version
+                self.received += 1
+                return stream._text
+            if stream._finished:
+                if stream._error is not None:
+                    raise stream._error
+                raise StopAsyncIteration
+            await stream._changed.wait()
+
+
+class BroadcastStream:
+    """Shares one streamed response with any number of subscribers.
+
+    Create broadcast streams with
+    :meth:`~apple_fm_sdk.LanguageModelSession.broadcast_response`. The
+    response is generated from the moment the broadcast stream is created,
+    and runs to completion whether or not anyone is subscribed. Snapshots are
+    handed from the native callback thread straight to the event loop, where
+    subscribers wait for them.
+
+    Example:
+        Late joiners catch up to the latest snapshot::
+
+            broadcast = session.broadcast_response("Explain tides")
+            await asyncio.sleep(1.0)
+
+            async for text in broadcast.subscribe():
+                print(text)  # First snapshot is everything generated so far
+
+    Note:
+        - Subscriptions are not tied to each other; cancelling one
+          subscriber's task does not affect the stream or other subscribers
+        - Use :meth:`aclose` to stop the generation for every subscriber
+    """
+
+    def __init__(self, loop: asyncio.AbstractEventLoop):
+        self.loop = loop
+        self._stream_ptr = None
+        self._handle = None
+        self._text = ""
+        self._version = 0
+        self._finished = False
+        self._error: Optional[BaseException] = None
+        self._changed = asyncio.Event()
+        # Set when a scheduler admits the stream: the task waiting for
+        # admission, and the function that gives the slot back
+        self._admission: Optional[asyncio.Task] = None
+        self._release: Optional[Callable[[], None]] = None
+
+    @property
+    def text(self) -> str:
+        """The latest snapshot, or an empty string before the first.
+
+        :rtype: str
+        """
+        return self._text
+
+    @property
+    def snapshots(self) -> int:
+        """Number of snapshots received from the stream so far.
+
+        :rtype: int
+        """
+        return self._version
+
+    @property
+    def done(self) -> bool:
+        """Whether the stream has ended, successfully or not.
+
+        :rtype: bool
+        """
+        return self._finished
+
+    def subscribe(self) -> StreamSubscription:
+        """Create a subscriber's cursor, starting at the latest snapshot.
+
+        A subscription created after the stream has ended receives the final
+        snapshot once.
+
+        :return: A new subscription
+        :rtype: StreamSubscription
+        """
+        return StreamSubscription(self)
+
+    async def result(self) -> str:
+        """Wait for the stream to end and return the final text.
+
+        :return: The complete response
+        :rtype: str
+        :raises FoundationModelsError: If the stream failed
+        """
+        while not self._finished:
+            await self._changed.wait()
+        if self._error is not None:
+            raise self._error
+        return self._text
+
+    async def aclose(self):
+        """Stop generating. Subscribers end after the snapshots already received."""
+        if self._stream_ptr is not None and not self._finished:
+            lib.FMLanguageModelSessionResponseStreamCancel(self._stream_ptr)
+        if self._admission is not None and not self._admission.done():
+            self._admission.cancel()
+        self._finish(None)
+
+    async def __aenter__(self) -> "BroadcastStream":
+        return self
+
+    async def __aexit__(self, exc_type, exc, tb):
+        await self.aclose()
+
+    def _attach(self, stream_ptr, handle):
+        self._stream_ptr = stream_ptr
+        self._handle = handle
+
+    def _deliver(self, status: int, text: Optional[str]):
+        """Handle one callback of the native iteration, on the event loop."""
+        if self._finished:
+            return
+        if status != GenerationErrorCode.SUCCESS:
+            self._finish(_status_code_to_exception(status, debug_description=text))
+        elif text is None:
+            self._finish(None)
+        else:
+            self._text = text
+            self._version += 1
+            self._notify()
+
+    def _finish(self, error: Optional[BaseException]):
+        if self._finished:
+            return
+        self._finished = True
+        self._error = error
+        # Later callbacks, such as the cancellation error, find no handle
+        if self._handle is not None:
+            _unregister_handle(self._handle)
+            self._handle = None
+        if self._stream_ptr is not None:
+            lib.FMRelease(self._stream_ptr)
+            self._stream_ptr = None
+        if self._release is not None:
+            self._release()
+            self._release = None
+        self._notify()
+
+    def _notify(self):
+        # Wake everyone waiting now; later waiters wait on a fresh event
+        self._changed.set()
+        self._changed = asyncio.Event()
@@ -37,10 +37,16 @@ Callback Safety:
 """
 
 import asyncio
+import atexit
+import collections
+import contextlib
+import contextvars
+import sys
 import threading
+import time
 import queue
 import logging
-from typing import Optional
+from typing import Any, Iterator, List, Optional, Tuple
 
 from .errors import (
     FoundationModelsError,
@@ -170,6 +176,215 @@ def _get_error_string(error_code, error_desc):
     return err_code, err_desc
 
 
+class _Py_buffer(ctypes.Structure):
+    """ctypes mirror of CPython's ``Py_buffer`` struct (stable since Python 3.3)."""
+
+    _fields_ = [
+        ("buf", ctypes.c_void_p),
+        ("obj", ctypes.py_object),
+        ("len", ctypes.c_ssize_t),
+        ("itemsize", ctypes.c_ssize_t),
+        ("readonly", ctypes.c_int),
+        ("ndim", ctypes.c_int),
+        ("format", ctypes.c_char_p),
+        ("shape", ctypes.POINTER(ctypes.c_ssize_t)),
+        ("strides", ctypes.POINTER(ctypes.c_ssize_t)),
+        ("suboffsets", ctypes.POINTER(ctypes.c_ssize_t)),
+        ("internal", ctypes.c_void_p),
+    ]
+
+
+_PyBUF_SIMPLE = 0
+_PyObject_GetBuffer = ctypes.pythonapi.PyObject_GetBuffer
+_PyObject_GetBuffer.argtypes = [ctypes.py_object, ctypes.POINTER(_Py_buffer), ctypes.c_int]
+_PyObject_GetBuffer.restype = ctypes.c_int
+_PyBuffer_Release = ctypes.pythonapi.PyBuffer_Release
+_PyBuffer_Release.argtypes = [ctypes.POINTER(_Py_buffer)]
+_PyBuffer_Release.restype = None
+
+
+@contextlib.contextmanager
+def _borrowed_bytes(data) -> Iterator[Tuple[ctypes._Pointer, int]]:
+    """
+    Borrow a ``(pointer, length)`` pair for text or a buffer-protocol object.
+
+    ``str`` values are encoded to UTF-8. Any contiguous buffer-protocol object
+    (``bytes``, ``bytearray``, ``memoryview``, ``mmap``, ``array.array``) is
+    exported in place through ``PyObject_GetBuffer`` so that no Python-side copy
+    is made, including for read-only buffers such as ``bytes`` or a read-only
+    ``mmap``. Non-contiguous views fall back to a single copy.
+
+    The pointer is only valid inside the ``with`` block. Length-delimited C entry
+    points copy the bytes before returning, so the block only needs to span the
+    native call itself.
+
+    :param data: The text or bytes-like object to borrow
+    :type data: Union[str, bytes, bytearray, memoryview]
+    :raises TypeError: If ``data`` is neither ``str`` nor a bytes-like object
+    """
+    if isinstance(data, str):
+        data = data.encode("utf-8")
+
+    view = _Py_buffer()
+    try:
+        _PyObject_GetBuffer(data, ctypes.byref(view), _PyBUF_SIMPLE)
+    except BufferError:
+        # Non-contiguous memoryview slices cannot be exported as a flat buffer
+        data = memoryview(data).tobytes()
+        _PyObject_GetBuffer(data, ctypes.byref(view), _PyBUF_SIMPLE)
+    except TypeError:
+        raise TypeError(
+            f"Prompt must be a str or a bytes-like object, not {type(data).__name__}"
+        ) from None
+
+    try:
+        yield ctypes.cast(view.buf, ctypes.POINTER(ctypes.c_char)), view.len
+    finally:
+        _PyBuffer_Release(ctypes.byref(view))
+
+
+# Pointers of garbage-collected objects waiting for FMReleaseMany. ``__del__``
+# only appends, and drainers only pop until the deque is empty, so neither needs
+# a lock: a lock taken in ``__del__`` could deadlock if the collector runs while
+# its owner holds it. Several drainers may run at once (the background thread,
+# scope exits, session managers, atexit); each releases the pointers it popped.
+_pending_releases: "collections.deque[int]" = collections.deque()
+_RELEASE_INTERVAL = 0.05  # seconds between background drains
+_release_thread: Optional[threading.Thread] = None
+_release_thread_lock = threading.Lock()
+
+# The innermost active scope() as (owner, objects created in it), or None
+# outside scopes. Tasks created inside a scope inherit the variable, so objects
+# are only tracked when created by the owner that entered the scope.
+_current_scope: contextvars.ContextVar[
+    Optional[Tuple[Any, List["_ManagedObject"]]]
+] = contextvars.ContextVar("apple_fm_sdk_scope", default=None)
+
+
+def _release_many(ptrs) -> None:
+    """Release a sequence of pointers with a single FFI call."""
+    if ptrs:
+        lib.FMReleaseMany((ctypes.c_void_p * len(ptrs))(*ptrs), len(ptrs))
+
+
+def _take_pending_releases() -> List[int]:
+    """Pop every queued pointer, tolerating other drainers popping concurrently."""
+    ptrs = []
+    while True:
+        try:
+            ptrs.append(_pending_releases.popleft())
+        except IndexError:
+            return ptrs
+
+
+def _drain_releases() -> None:
+    """Release every pointer queued by ``_ManagedObject.__del__`` so far."""
+    _release_many(_take_pending_releases())
+
+
+def _scope_owner() -> Any:
+    """The task running the caller, or its thread outside a running loop."""
+    try:
+        task = asyncio.current_task()
+    except RuntimeError:
+        task = None
+    return task if task is not None else threading.get_ident()
+
+
+def _scope_objects() -> Optional[List["_ManagedObject"]]:
+    """Objects list of the active scope, if the caller owns it."""
+    active = _current_scope.get()
+    if active is None or active[0] != _scope_owner():
+        return None
+    return active[1]
+
+
+def _release_loop() -> None:
+    while True:
+        time.sleep(_RELEASE_INTERVAL)
+        try:
+            _drain_releases()
+        except Exception as error:
+            logger.error(f"Error releasing deferred C pointers: {error}")
+
+
+def _ensure_release_thread() -> None:
+    global _release_thread
+    with _release_thread_lock:
+        if _release_thread is None:
+            _release_thread = threading.Thread(
+                target=_release_loop, name="apple_fm_sdk-release", daemon=True
+            )
+            _release_thread.start()
+
+
+atexit.register(_drain_releases)
+
+
+@contextlib.contextmanager
+def scope() -> Iterator[None]:
+    """Release the native references created inside the block in one call.
+
+    Objects that wrap native references (sessions, generated content, schemas,
+    tools) normally release them when they are garbage collected, batched by a
+    background thread. Inside ``scope()``, every such object created in the
+    block is kept alive until the block exits. The references of those that
+    are no longer used anywhere else are then released, together with any
+    already queued for release, with a single native call.
+
+    Objects that are still referenced when the block exits are left alone and
+    stay valid: results returned or stored outside the block, cached schemas,
+    or a tool given to a longer-lived session. They are released when garbage
+    collected, like objects created outside a scope. So are objects that only
+    a reference cycle keeps alive.
+
+    Scopes can be nested; each releases only the objects created directly
+    inside it. Objects created by other threads, or by tasks started inside
+    the block, are not tracked by the scope.
+
+    Example:
+        ::
+
+            import apple_fm_sdk as fm
+
+            results = []
+            with fm.scope():
+                for document in documents:
+                    session = fm.LanguageModelSession()
+                    content = await session.respond(document, schema=schema)
+                    results.append(content.to_json())
+            # The sessions and contents of earlier iterations are released here
+    """
+    objects: List[_ManagedObject] = []
+    token = _current_scope.set((_scope_owner(), objects))
+    try:
+        yield
+    finally:
+        _current_scope.reset(token)
+        ptrs = []
+        while objects:
+            obj = objects.pop()
+            # Referenced only by ``obj`` and getrefcount's argument: nothing
+            # else can use the object, so its reference can go now
+            if obj._ptr and sys.getrefcount(obj) <= 2:
+                ptrs.append(obj._ptr)
+                obj._ptr = None
+        ptrs.extend(_take_pending_releases())
+        _release_many(ptrs)
+
+
+def _adopt_into_scope(obj):
+    """Track an object created on a native callback thread in the caller's scope().
+
+    Callback threads do not share the awaiting coroutine's context, so results
+    they create are handed to the active scope when the coroutine receives them.
+    """
+    objects = _scope_objects()
+    if objects is not None and isinstance(obj, _ManagedObject):
+        objects.append(obj)
+    return obj
+
+
 class _ManagedObject:
     """
     Base class for Python objects that wrap C/Swift pointers requiring memory management.
@@ -204,10 +419,13 @@ class _ManagedObject:
         already retained when passed from Swift to Python.
 
     .. note::
-        The ``__del__`` method automatically releases the pointer when the
-        Python object is garbage collected.
+        The ``__del__`` method queues the pointer when the Python object is
+        garbage collected, and a background thread releases queued pointers in
+        bulk. Objects created inside :func:`scope` are released when it exits.
     """
 
+    __slots__ = ("_ptr", "__weakref__")
+
     def __init__(self, ptr):
         """
         Initialize a managed object with a C pointer.
@@ -219,6 +437,12 @@ class _ManagedObject:
         if not ptr:
             raise FoundationModelsError("Failed to create object")
         self._ptr = ptr
+        if _release_thread is None:
+            # Started here rather than in __del__, which may run at shutdown
+            _ensure_release_thread()
+        objects = _scope_objects()
+        if objects is not None:
+            objects.append(self)
 
     def _retain(self):
         """
@@ -260,10 +484,13 @@ class _ManagedObject:
         Destructor that releases the managed pointer.
 
         This method is called automatically by Python's garbage collector when
-        the object is being destroyed. It ensures the C pointer is properly
-        released to prevent memory leaks.
+        the object is being destroyed. Rather than crossing into native code for
+        every object, it queues the pointer for a bulk ``FMReleaseMany`` call,
+        so collecting a large batch of objects stays cheap.
         """
-        self._release()
+        ptr = getattr(self, "_ptr", None)
+        if ptr:
+            _pending_releases.append(ptr)
 
 
 # Use the callback type from ctypes bindings instead of redefining it
@@ -394,6 +621,139 @@ def _session_structured_callback(status, content_ptr, future_handle):
             )
 
 
+class _TurnBatch:
+    """Collects the per-turn results of a pipelined ``FMLanguageModelSessionEnqueue`` request.
+
+    The future resolves with the list of results once the last turn completes, or
+    with the exception of the first turn that fails.
+    """
+
+    __slots__ = ("future", "results")
+
+    def __init__(self, future: asyncio.Future, count: int):
+        self.future = future
+        self.results = [None] * count
+
+
+@lib.FMLanguageModelSessionTurnCallback
+def _session_turn_callback(
+    status, turn_index, content, length, structured_ptr, batch_handle
+):
+    """ctypes callback function, invoked once per turn of a pipelined request."""
+    from .generable import GeneratedContent  # Import here to avoid circular import
+
+    def _set_future_result(future: asyncio.Future, result):
+        if not future.done():
+            future.set_result(result)
+
+    def _set_future_exception(future: asyncio.Future, e):
+        if not future.done():
+            future.set_exception(e)
+
+    structured_owned = False
+    try:
+        batch = _safe_from_handle(batch_handle)
+        if batch is None or batch.future.done():
+            # Batch is gone, cancelled, or already failed
+            return
+        future = batch.future
+
+        if content and length > 0:
+            content_str = bytes(content[:length].data).decode("utf-8")
+        else:
+            content_str = None
+
+        if status != GenerationErrorCode.SUCCESS:
+            error = _status_code_to_exception(status, debug_description=content_str)
+            future.get_loop().call_soon_threadsafe(_set_future_exception, future, error)
+            return
+
+        if structured_ptr:
+            batch.results[turn_index] = GeneratedContent(_ptr=structured_ptr)
+            structured_owned = True
+        else:
+            batch.results[turn_index] = content_str
+
+        if turn_index == len(batch.results) - 1:
+            future.get_loop().call_soon_threadsafe(
+                _set_future_result, future, batch.results
+            )
+
+    except Exception as e:
+        try:
+            batch = _safe_from_handle(batch_handle)
+            if batch is not None and not batch.future.done():
+                batch.future.get_loop().call_soon_threadsafe(
+                    _set_future_exception, batch.future, e
+                )
+        except Exception as error:
+            logger.error(f"Unhandled Exception in turn callback cleanup: {error}")
+    finally:
+        if structured_ptr and not structured_owned:
+            try:
+                lib.FMRelease(structured_ptr)
+            except Exception as cleanup_error:
+                logger.error(
+                    f"Error releasing C pointer during turn cleanup: {cleanup_error}"
+                )
+
+
+class _StreamEventChannel:
+    """Hands typed stream events from the native callback thread to an event loop.
+
+    Each item put on ``queue`` is a ``(status, event_type, payload)`` tuple; the
+    consumer turns it into a stream event or an exception.
+    """
+
+    __slots__ = ("loop", "queue")
+
+    def __init__(self, loop: asyncio.AbstractEventLoop):
+        self.loop = loop
+        self.queue: asyncio.Queue = asyncio.Queue()
+
+
+@lib.FMLanguageModelSessionStreamEventCallback
+def _session_stream_event_callback(
+    status, event_type, payload, length, channel_handle
+):
+    """ctypes callback function, invoked once per typed stream event."""
+    try:
+        channel = _safe_from_handle(channel_handle)
+        if channel is None or channel.loop.is_closed():
+            # The consumer stopped listening
+            return
+
+        if payload and length > 0:
+            payload_str = bytes(payload[:length].data).decode("utf-8")
+        else:
+            payload_str = ""
+
+        channel.loop.call_soon_threadsafe(
+            channel.queue.put_nowait, (status, event_type, payload_str)
+        )
+    except Exception as error:
+        logger.error(f"Unhandled Exception in stream event callback: {error}")
+
+
+@lib.FMLanguageModelSessionResponseCallback
+def _session_broadcast_callback(status, content, length, stream_handle):
+    """ctypes callback function, invoked once per snapshot of a broadcast stream."""
+    try:
+        stream = _safe_from_handle(stream_handle)
+        if stream is None or stream.loop.is_closed():
+            # The broadcast stream was closed
+            return
+
+        if content and length > 0:
+            text = bytes(content[:length].data).decode("utf-8", errors="replace")
+        else:
+            text = None
+
+        stream.loop.call_soon_threadsafe(stream._deliver, status, text)
+    except Exception as error:
+        logger.error(f"Unhandled Exception in broadcast callback: {error}")
+
+
 class StreamingCallback:
     """
     Callback handler for streaming generation responses.
@@ -457,6 +817,8 @@ class StreamingCallback:
         self.queue = queue.Queue()
         self.error = None
         self.completed = threading.Event()
+        # Native and Python threads can both end the stream; the first one wins
+        self._finish_lock = threading.Lock()
 
         # Use the callback type from ctypes bindings
         @lib.FMLanguageModelSessionResponseCallback
@@ -464,9 +826,7 @@ class StreamingCallback:
             try:
                 if status != GenerationErrorCode.SUCCESS:
                     # Convert status code to specific error
-                    self.error = _status_code_to_exception(status)
-                    self.queue.put(None)  # Signal end
-                    self.completed.set()
+                    self._finish(_status_code_to_exception(status))
                     return
 
                 if content and length > 0:
@@ -476,12 +836,22 @@ class StreamingCallback:
                     self.queue.put(current_content)
                 else:
                     # End of stream
-                    self.queue.put(None)  # Signal end
-                    self.completed.set()
+                    self._finish()
 
             except Exception as e:
-                self.error = FoundationModelsError(f"Callback error: {e}")
-                self.queue.put(None)  # Signal end
-                self.completed.set()
+                self._finish(FoundationModelsError(f"Callback error: {e}"))
 
         self._callback = _callback_impl
+
+    def _finish(self, error: Optional[BaseException] = None):
+        """End the stream, recording ``error`` if it is the first to end it.
+
+        Safe to call from any thread and more than once; only the first call
+        records its error and signals the consumer.
+        """
+        with self._finish_lock:
+            if self.completed.is_set():
+                return
+            self.error = error
+            self.queue.put(None)  # Signal end
+            self.completed.set()
@@ -131,6 +131,8 @@ class SystemLanguageModel(_ManagedObject):
                 print(f"Model unavailable: {reason}")
     """
 
+    __slots__ = ()
+
     def __init__(
         self,
         use_case: SystemLanguageModelUseCase = SystemLanguageModelUseCase.GENERAL,
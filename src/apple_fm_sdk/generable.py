@@ -11,7 +11,11 @@ from .c_helpers import _ManagedObject, _get_error_string
 from .generation_schema import GenerationSchema
 from .errors import GenerationErrorCode, _status_code_to_exception
 
+import itertools
 import logging
+import os
+import threading
+import uuid
 from typing import (
     Any,
     Dict,
@@ -38,21 +42,53 @@ except ImportError:
 
 
 class GenerationID:
-    """Represents a unique identifier for generated content."""
+    """Represents a unique identifier for generated content.
+
+    Identifiers are drawn from a per-process monotonic counter, so creating one
+    is cheap. Each identifier keeps the random per-process prefix it was
+    created with, and is formatted as a UUID string only when ``str()`` is
+    called. Identifiers created before a fork keep their prefix in the child,
+    and never equal identifiers created after it.
+    """
+
+    __slots__ = ("_prefix", "_value")
+
+    _counter = itertools.count(1)
+    # itertools.count is only atomic under the GIL; free-threaded builds need the lock
+    _counter_lock = threading.Lock()
+    _process_prefix = int.from_bytes(os.urandom(8), "big")
 
     def __init__(self):
-        import uuid
+        with GenerationID._counter_lock:
+            self._prefix = GenerationID._process_prefix
+            self._value = next(GenerationID._counter)
 
-        self._id = str(uuid.uuid4())
+    @classmethod
+    def _reseed(cls):
+        # A forked child must not hand out the same identifiers as its parent
+        cls._counter = itertools.count(1)
+        cls._counter_lock = threading.Lock()
+        cls._process_prefix = int.from_bytes(os.urandom(8), "big")
 
     def __str__(self):
-        return self._id
+        return str(uuid.UUID(int=(self._prefix << 64) | self._value))
+
+    def __repr__(self):
+        return f"GenerationID({self})"
 
     def __eq__(self, other):
-        return isinstance(other, GenerationID) and self._id == other._id
+        return (
+            isinstance(other, GenerationID)
+            and self._value == other._value
+            and self._prefix == other._prefix
+        )
 
     def __hash__(self):
-        return hash(self._id)
+        return hash((self._prefix, self._value))
+
+
+if hasattr(os, "register_at_fork"):
+    os.register_at_fork(after_in_child=GenerationID._reseed)
 
 
 # MARK: Generated Content
@@ -64,6 +100,8 @@ class GeneratedContent(_ManagedObject):
     This is the actual content generated according to a schema.
     """
 
+    __slots__ = ("id", "_content_dict")
+
     def __init__(
         self,
         content_dict: Optional[Dict] = None,
@@ -301,6 +339,10 @@ class ConvertibleFromGeneratedContent(Protocol):
     Equivalent to Swift's ConvertibleFromGeneratedContent.
     """
 
+    # Empty slots keep __dict__ off slotted implementations such as
+    # the PartiallyGenerated classes
+    __slots__ = ()
+
     @classmethod
     def _from_generated_content(cls, content: GeneratedContent):
         """Create instance from GeneratedContent."""
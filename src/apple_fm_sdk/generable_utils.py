@@ -42,7 +42,18 @@ from .generable import (
 )
 from .generation_property import Property
 from dataclasses import dataclass, field
-from typing import Optional, Union, get_type_hints, get_args, Type, List
+from typing import (
+    Any,
+    Callable,
+    Optional,
+    Union,
+    get_type_hints,
+    get_args,
+    get_origin,
+    Type,
+    List,
+)
+import functools
 import logging
 
 logger = logging.getLogger(__name__)
@@ -143,41 +154,157 @@ def generable(description: Optional[str] = None):
 
 
 def resolve_referenced_generables(
-    field_type, outer_class_name: str
+    field_type, outer_class_name: str, builder: Optional["_SchemaGraphBuilder"] = None
 ) -> Optional[List[GenerationSchema]]:
     """
     Resolve nested generable types referenced by a field.
 
     This helper function recursively examines a field's type to find any nested
     generable types (for example, a field of type ``Cat`` where ``Cat`` is itself
-    a generable class). It handles collections (List, Optional) and prevents
-    infinite recursion for self-referential types.
+    a generable class). It looks through every type argument of collections,
+    unions and optionals, and prevents infinite recursion for self-referential
+    types.
 
     :param field_type: The type annotation of the field to examine
     :type field_type: Type
     :param outer_class_name: Name of the outer class to detect self-references
     :type outer_class_name: str
-    :return: List of GenerationSchema objects for nested generable types, or None
-        if no nested generables are found or if a self-reference is detected
+    :param builder: The schema graph being built. Schemas it has already built
+        are reused rather than rebuilt. A new graph is started when omitted.
+    :type builder: Optional[_SchemaGraphBuilder]
+    :return: List of GenerationSchema objects for the generable types the field
+        references directly, or None if no nested generables are found
     :rtype: Optional[List[GenerationSchema]]
 
     .. note::
         This function is used internally by the schema generation process to
         build the complete schema graph including nested types.
     """
-    # Check if the field_type is a generable class itself
-    if hasattr(field_type, "_generable") and field_type._generable is True:
-        if field_type.__name__ == outer_class_name:
-            return None  # Avoid infinite recursion on self-references
-        schema = field_type.generation_schema()
-        return [
-            schema,
-            *schema.dynamic_nested_types,
-        ]  # Include nested references
-
-    # Unpack collections or optional types to find generable inner types
+    builder = builder or _SchemaGraphBuilder()
+    references: List[GenerationSchema] = []
+    for generable_type in _referenced_generable_types(field_type):
+        if generable_type.__name__ == outer_class_name:
+            continue  # Avoid infinite recursion on self-references
+        schema = builder.build(generable_type)
+        if schema is not None:
+            references.append(schema)
+    return references or None
+
+
+def _referenced_generable_types(field_type) -> List[Type]:
+    """Find the generable classes in a type annotation, in declaration order."""
+    if getattr(field_type, "_generable", False) is True:
+        return [field_type]
+    found = []
     for inner_type in get_args(field_type):
-        return resolve_referenced_generables(inner_type, outer_class_name)
+        found.extend(_referenced_generable_types(inner_type))
+    return found
+
+
+class _SchemaGraphBuilder:
+    """
+    Builds the schema of a generable class together with every generable it
+    references.
+
+    Each class is visited once per build, and its schema is shared by every
+    parent that references it. Without this, each level rebuilt the schemas of
+    all the levels below it, so deep hierarchies took quadratic time.
+
+    The native layer only passes the root schema's references to the model as
+    dependencies, so the root registers every transitive reference, once each.
+    Inner schemas register only their direct references; registering the full
+    set at every level made N(N-1)/2 native calls for a chain of N classes.
+    """
+
+    def __init__(self):
+        self._schemas: dict = {}
+        self._building: set = set()
+
+    def build(self, cls, description: Optional[str] = None) -> Optional[GenerationSchema]:
+        """
+        Return the schema for ``cls``, building it on first use.
+
+        Returns None for a class whose schema is still being built further up
+        the graph. Such a cycle is broken there: the ancestor is either the root
+        or already among the root's references.
+        """
+        schema = self._schemas.get(cls)
+        if schema is not None or cls in self._building:
+            return schema
+
+        self._building.add(cls)
+        try:
+            schema = self._build(cls, description)
+        finally:
+            self._building.discard(cls)
+        self._schemas[cls] = schema
+        return schema
+
+    def _build(self, cls_inner, description: Optional[str]) -> GenerationSchema:
+        is_root = len(self._building) == 1
+        properties = []
+        referenced_schemas: list[GenerationSchema] = []
+        referenced_schema_names: set[str] = {cls_inner.__name__}
+        type_hints = get_type_hints(
+            cls_inner, localns={cls_inner.__name__: cls_inner}, include_extras=True
+        )  # Namespace annotation needed for self-referential types
+
+        for field_name, field_info in cls_inner.__dataclass_fields__.items():
+            field_type = type_hints.get(field_name, str)
+
+            # Get any referenced generable types
+            reference = resolve_referenced_generables(
+                field_type, cls_inner.__name__, self
+            )
+            if reference:
+                for schema in reference:
+                    # Add only unique schemas to avoid duplicate types
+                    if schema.type_class.__name__ not in referenced_schema_names:
+                        referenced_schema_names.add(schema.type_class.__name__)
+                        referenced_schemas.append(schema)
+
+            # Get description and guides from field metadata
+            field_description = None
+            field_guides = []
+            if hasattr(field_info, "metadata") and field_info.metadata:
+                field_description = field_info.metadata.get("description")
+                field_guides = field_info.metadata.get("guides", [])
+
+            prop = Property(
+                name=field_name,
+                type_class=field_type,
+                description=field_description,
+                guides=field_guides,
+            )
+            properties.append(prop)
+
+        if is_root:
+            referenced_schemas = _transitive_references(referenced_schemas, cls_inner.__name__)
+
+        return GenerationSchema(
+            type_class=cls_inner,
+            description=description,
+            properties=properties,
+            dynamic_nested_types=referenced_schemas,
+        )
+
+
+def _transitive_references(
+    references: List[GenerationSchema], root_name: str
+) -> List[GenerationSchema]:
+    """Every schema reachable from ``references``, once each, in depth-first order."""
+    seen = {root_name}
+    ordered = []
+    pending = list(reversed(references))
+    while pending:
+        schema = pending.pop()
+        name = schema.type_class.__name__
+        if name in seen:
+            continue
+        seen.add(name)
+        ordered.append(schema)
+        pending.extend(reversed(schema.dynamic_nested_types))
+    return ordered
 
 
 def generation_schema(cls_inner, description: Optional[str] = None) -> GenerationSchema:
@@ -189,6 +316,9 @@ def generation_schema(cls_inner, description: Optional[str] = None) -> Generatio
     and any nested generable types. The schema can then be used for guided
     generation with Foundation Models.
 
+    Nested generable types are built once each, however many fields or levels
+    reference them, and their schemas are shared across the graph.
+
     :param cls_inner: The generable class to create a schema for
     :type cls_inner: Type
     :param description: Optional description override. If not provided, uses
@@ -206,46 +336,7 @@ def generation_schema(cls_inner, description: Optional[str] = None) -> Generatio
         :func:`generable` decorator which adds this as a class method.
         :class:`GenerationSchema` for the schema representation.
     """
-    properties = []
-    referenced_schemas: list[GenerationSchema] = []
-    referenced_schema_names: set[str] = set()
-    type_hints = get_type_hints(
-        cls_inner, localns={cls_inner.__name__: cls_inner}, include_extras=True
-    )  # Namespace annotation needed for self-referential types
-
-    for field_name, field_info in cls_inner.__dataclass_fields__.items():
-        field_type = type_hints.get(field_name, str)
-
-        # Get any referenced generable types
-        reference = resolve_referenced_generables(field_type, cls_inner.__name__)
-        if reference:
-            for schema in reference:
-                # Add only unique schemas to avoid duplicate types
-                if schema.type_class.__name__ not in referenced_schema_names:
-                    referenced_schema_names.add(schema.type_class.__name__)
-                    referenced_schemas.append(schema)
-
-        # Get description and guides from field metadata
-        field_description = None
-        field_guides = []
-        if hasattr(field_info, "metadata") and field_info.metadata:
-            field_description = field_info.metadata.get("description")
-            field_guides = field_info.metadata.get("guides", [])
-
-        prop = Property(
-            name=field_name,
-            type_class=field_type,
-            description=field_description,
-            guides=field_guides,
-        )
-        properties.append(prop)
-
-    return GenerationSchema(
-        type_class=cls_inner,
-        description=description,
-        properties=properties,
-        dynamic_nested_types=referenced_schemas,
-    )
+    return _SchemaGraphBuilder().build(cls_inner, description)
 
 
 # MARK: - GeneratedContent Helpers
@@ -254,21 +345,105 @@ def generation_schema(cls_inner, description: Optional[str] = None) -> Generatio
 # Add ConvertibleFromGeneratedContent support
 def _from_generated_content(cls_inner, content: GeneratedContent):
     """Create instance from GeneratedContent."""
-    kwargs = {}
-    type_hints = get_type_hints(cls_inner)
+    return _content_converter(cls_inner)(content._content_dict)
 
-    for field_name in cls_inner.__dataclass_fields__:
-        try:
-            field_type = type_hints[field_name]
-            value = content.value(field_type, for_property=field_name)
-            kwargs[field_name] = value
-        except Exception as error:
-            raise ValueError(
-                f"Failed to convert GeneratedContent to {cls_inner.__name__}: "
-                f"could not set field '{field_name}' with error: {error}"
-            )
 
-    return cls_inner(**kwargs)
+def _content_converter(cls_inner) -> Callable[[dict], Any]:
+    """
+    Get the precompiled converter from a content dictionary to ``cls_inner``.
+
+    The converter is compiled on first use and cached on the class, so type
+    hints are resolved and nested types are inspected once per class rather
+    than once per conversion.
+
+    :param cls_inner: A generable class
+    :type cls_inner: Type
+    :return: A function that builds an instance of ``cls_inner`` from the
+        dictionary held by a GeneratedContent
+    :rtype: Callable[[dict], Any]
+    """
+    # Read through __dict__ so subclasses of a generable compile their own. Two
+    # threads may both compile on first use; the converters are equivalent, so
+    # whichever is stored last is kept.
+    converter = cls_inner.__dict__.get("_generable_converter")
+    if converter is None:
+        converter = _compile_content_converter(cls_inner)
+        cls_inner._generable_converter = converter
+    return converter
+
+
+def _compile_content_converter(cls_inner) -> Callable[[dict], Any]:
+    type_hints = get_type_hints(cls_inner, localns={cls_inner.__name__: cls_inner})
+    plan = [
+        (field_name, _compile_value_converter(type_hints.get(field_name, str)))
+        for field_name in cls_inner.__dataclass_fields__
+    ]
+
+    def convert(content_dict: dict):
+        kwargs = {}
+        for field_name, value_converter in plan:
+            raw_value = content_dict.get(field_name)
+            try:
+                kwargs[field_name] = (
+                    raw_value if value_converter is None else value_converter(raw_value)
+                )
+            except Exception as error:
+                raise ValueError(
+                    f"Failed to convert GeneratedContent to {cls_inner.__name__}: "
+                    f"could not set field '{field_name}' with error: {error}"
+                )
+        return cls_inner(**kwargs)
+
+    return convert
+
+
+def _compile_value_converter(field_type) -> Optional[Callable[[Any], Any]]:
+    """
+    Compile the conversion of one raw value to ``field_type``.
+
+    Mirrors :meth:`GeneratedContent._unpack_nested_generables`. Returns None when
+    the raw value is used unchanged, which is the case for primitive types.
+    """
+    # Nested generable. Looked up lazily so self-referential types compile.
+    if getattr(field_type, "_generable", False) is True:
+
+        def convert_generable(raw_value):
+            return _content_converter(field_type)(raw_value or {})
+
+        return convert_generable
+
+    origin_type = get_origin(field_type)
+    non_none_types = [arg for arg in get_args(field_type) if arg is not type(None)]
+
+    if origin_type is list:
+        item_converter = (
+            _compile_value_converter(non_none_types[0])
+            if len(non_none_types) == 1
+            else None
+        )
+
+        def convert_list(raw_value):
+            if raw_value is None:
+                return []
+            if not isinstance(raw_value, list):
+                raise TypeError(f"Expected list, got {type(raw_value)}")
+            if item_converter is None:
+                return list(raw_value)
+            return [item_converter(item) for item in raw_value]
+
+        return convert_list
+
+    if origin_type is Union and len(non_none_types) == 1:
+        inner_converter = _compile_value_converter(non_none_types[0])
+        if inner_converter is None:
+            return None
+
+        def convert_optional(raw_value):
+            return None if raw_value is None else inner_converter(raw_value)
+
+        return convert_optional
+
+    return None
 
 
 # Add ConvertibleToGeneratedContent support
@@ -332,9 +507,13 @@ def create_partially_generated(cls) -> Type:
         {
             "__annotations__": partial_annotations,
             "__module__": cls.__module__,
-            "_from_generated_content": classmethod(partial_from_generated_content),
+            # Bind the generable class so the partial class is passed as partial_cls
+            "_from_generated_content": classmethod(
+                functools.partial(partial_from_generated_content, cls)
+            ),
             **partial_fields,
         },
     )
-    partial_class = dataclass(partial_class)
+    # Streaming creates one partial per snapshot, so keep them slotted
+    partial_class = dataclass(partial_class, slots=True)
     return partial_class
@@ -75,6 +75,8 @@ class GenerationGuide:
     :vartype value: Any
     """
 
+    __slots__ = ("guide_type", "value")
+
     guide_type: GuideType
     value: Any
 
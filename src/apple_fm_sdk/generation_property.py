@@ -46,6 +46,8 @@ class Property:
         ... )
     """
 
+    __slots__ = ("name", "type_class", "description", "guides")
+
     name: str
     type_class: Type
     description: Optional[str]
@@ -1,7 +1,8 @@
 # For licensing see accompanying LICENSE file.
 # Copyright (C) 2026 Apple Inc. All Rights Reserved.
 
-from typing import List, Optional, Type, Any
+from dataclasses import dataclass
+from typing import Any, Iterable, List, Optional, Type, Union
 from .generation_property import Property
 from .c_helpers import _ManagedObject, _get_error_string
 import ctypes
@@ -16,6 +17,31 @@ try:
 except ImportError:
     raise (ImportError("Python C bindings missing"))
 
+# Documents handed to the native validator per call, bounding the memory held
+# for encoded documents and results when validating very large collections
+_VALIDATION_BATCH_SIZE = 4096
+
+
+@dataclass(frozen=True)
+class SchemaViolation:
+    """
+    A guide or type constraint that a document breaks.
+
+    :ivar path: Location of the offending value, such as ``"cats[2].age"``. Empty
+        for the document itself.
+    :vartype path: str
+    :ivar guide: The constraint that failed: a guide name (``"anyOf"``,
+        ``"count"``, ``"minItems"``, ``"maxItems"``, ``"minimum"``, ``"maximum"``,
+        ``"regex"``), or ``"type"``, ``"required"`` or ``"json"``
+    :vartype guide: str
+    :ivar message: Human-readable description of the violation
+    :vartype message: str
+    """
+
+    path: str
+    guide: str
+    message: str
+
 
 class GenerationSchema(_ManagedObject):
     """
@@ -197,3 +223,110 @@ class GenerationSchema(_ManagedObject):
 
         result = json.loads(json_str)
         return result
+
+    def validate_many(
+        self, documents: Iterable[Union[str, bytes, dict, Any]]
+    ) -> List[List[SchemaViolation]]:
+        """
+        Check documents against this schema's types and guides.
+
+        Guides constrain the model while it generates, but stored or edited
+        output can drift from them. This method re-checks documents outside
+        generation. The schema is compiled into a native validation program
+        once, and documents are validated in parallel in native code, so large
+        collections can be checked quickly.
+
+        Regex guides are checked with Swift's ``Regex``, the engine that
+        constrains generation, so a string is valid exactly when generation
+        could have produced it: the whole string must match, with any
+        alternative, and ``.`` and character classes match whole characters
+        (grapheme clusters) rather than code points. Patterns use Swift regex
+        syntax, which can differ from Python's :mod:`re`.
+
+        :param documents: The documents to check, each a JSON string or bytes, a
+            dictionary, or a :class:`GeneratedContent`
+        :type documents: Iterable[Union[str, bytes, dict, GeneratedContent]]
+        :return: One list of violations per document, in input order. An empty
+            list means the document is valid.
+        :rtype: List[List[SchemaViolation]]
+        :raises FoundationModelsError: If the schema cannot be compiled, for
+            example because a regex guide is not a valid pattern
+
+        Example:
+            ::
+
+                @fm.generable("A cat's profile")
+                class Cat:
+                    name: str = fm.guide("Cat's name")
+                    age: int = fm.guide("Age in years", range=(0, 20))
+
+                results = Cat.generation_schema().validate_many(stored_outputs)
+                invalid = [i for i, violations in enumerate(results) if violations]
+        """
+        results: List[List[SchemaViolation]] = []
+        batch: List[bytes] = []
+        for document in documents:
+            batch.append(_encode_document(document))
+            if len(batch) == _VALIDATION_BATCH_SIZE:
+                results.extend(self._validate_batch(batch))
+                batch = []
+        if batch:
+            results.extend(self._validate_batch(batch))
+        return results
+
+    def validate(self, document: Union[str, bytes, dict, Any]) -> List[SchemaViolation]:
+        """
+        Check one document against this schema's types and guides.
+
+        Equivalent to ``validate_many([document])[0]``.
+
+        :param document: A JSON string or bytes, a dictionary, or a GeneratedContent
+        :type document: Union[str, bytes, dict, GeneratedContent]
+        :return: The violations found, empty if the document is valid
+        :rtype: List[SchemaViolation]
+        """
+        return self.validate_many([document])[0]
+
+    def _validate_batch(self, batch: List[bytes]) -> List[List[SchemaViolation]]:
+        count = len(batch)
+        documents = (ctypes.c_char_p * count)(*batch)
+        lengths = (ctypes.c_size_t * count)(*(len(d) for d in batch))
+        error_code = ctypes.c_int32()
+        error_description = ctypes.POINTER(ctypes.c_char)()
+
+        report = lib.FMGenerationSchemaValidateJSONBatch(
+            self._ptr,
+            documents,
+            lengths,
+            count,
+            ctypes.byref(error_code),
+            ctypes.byref(error_description),
+        )
+        if report is None or (hasattr(report, "data") and report.data is None):
+            err_code, err_desc = _get_error_string(error_code, error_description)
+            error_msg = "Failed to compile GenerationSchema for validation"
+            if err_desc:
+                error_msg = error_msg + ": " + err_desc
+            raise _status_code_to_exception(err_code or error_code.value, error_msg)
+
+        # The return value is wrapped in a String object by ctypes
+        return [
+            [SchemaViolation(v["path"], v["guide"], v["message"]) for v in violations]
+            for violations in json.loads(str(report))
+        ]
+
+
+def _encode_document(document: Union[str, bytes, dict, Any]) -> bytes:
+    """Encode a document for the native validator as UTF-8 JSON."""
+    if isinstance(document, bytes):
+        return document
+    if isinstance(document, str):
+        return document.encode("utf-8")
+    if isinstance(document, dict):
+        return json.dumps(document).encode("utf-8")
+    if hasattr(document, "to_json"):
+        return document.to_json().encode("utf-8")
+    raise TypeError(
+        f"Cannot validate a {type(document).__name__}; "
+        "expected a JSON string, bytes, dict or GeneratedContent"
+    )
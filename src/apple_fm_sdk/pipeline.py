@@ -0,0 +1,588 @@
+# For licensing see accompanying LICENSE file.
+# Copyright (C) 2026 Apple Inc. All Rights Reserved.
+
+"""
+Map-reduce processing of documents larger than the model's context window.
+
+This module splits a long document into chunks that fit an estimated token
+budget, maps each chunk through the model in parallel, and then reduces the
+partial results hierarchically until a single result remains.
+
+Every map and reduce step runs on a session of its own, so no chunk is
+answered in the context of another. Sessions are not reused across steps: a
+session's transcript cannot be cleared, and a session restored from an
+instructions-only transcript is itself a new session, so reusing one would
+only carry earlier chunks into later answers. The steps share the model and
+instructions, and at most ``concurrency`` of them run at once.
+
+The main components are:
+
+* :func:`map_reduce` - Run the full pipeline and return the final result
+* :func:`map_reduce_stream` - Run the pipeline, yielding progress as it goes
+* :class:`SessionPool` - A bounded pool of reusable sessions for multi-turn requests
+* :func:`chunk_text` - Split text into chunks under a token budget
+* :func:`estimate_tokens` - Cheap token-count estimate for budgeting
+
+Example:
+    Summarizing a long report::
+
+        import apple_fm_sdk as fm
+
+        summary = await fm.map_reduce(
+            report_text,
+            map_prompt="Summarize this excerpt of a report:\\n\\n{chunk}",
+            reduce_prompt="Combine these partial summaries into one summary:\\n\\n{partials}",
+        )
+
+    Extracting structured data and merging it in Python::
+
+        @fm.generable("Action items found in a document")
+        class ActionItems:
+            items: list[str] = fm.guide("Action items, one per entry")
+
+        def merge(parts: list[ActionItems]) -> ActionItems:
+            return ActionItems(items=[i for p in parts for i in p.items])
+
+        result = await fm.map_reduce(
+            report_text,
+            map_prompt="List the action items in this excerpt:\\n\\n{chunk}",
+            generating=ActionItems,
+            merge=merge,
+        )
+"""
+
+import asyncio
+import contextlib
+import dataclasses
+import json
+import math
+import re
+from dataclasses import dataclass
+from typing import (
+    Any,
+    AsyncIterator,
+    Awaitable,
+    Callable,
+    List,
+    Optional,
+    Type,
+    Union,
+)
+
+from .core import SystemLanguageModel
+from .errors import ExceededContextWindowSizeError
+from .generable import Generable
+from .session import LanguageModelSession
+from .tool import Tool
+
+# Default context window of the on-device system model, in tokens
+DEFAULT_CONTEXT_WINDOW = 4096
+
+# Maximum number of hedges a pool may accumulate credit for, so a long quiet
+# period cannot be followed by a burst of hedged requests
+_HEDGE_BURST = 10
+
+# Average characters per token used for budgeting. Deliberately on the low side
+# so that estimates err towards over-counting.
+_CHARS_PER_TOKEN = 3.5
+
+_PARAGRAPH_BREAK = re.compile(r"\n\s*\n")
+_SENTENCE_BREAK = re.compile(r"(?<=[.!?])\s+")
+
+PromptTemplate = Union[str, Callable[[str], str]]
+ReducePromptTemplate = Union[str, Callable[[List[str]], str]]
+MergeFunction = Callable[[List[Any]], Union[Any, Awaitable[Any]]]
+
+
+def estimate_tokens(text: str) -> int:
+    """Estimate the number of tokens in a piece of text.
+
+    This is a character-count heuristic, not a tokenizer. It is intended for
+    budgeting chunk sizes and is tuned to over-estimate slightly.
+
+    :param text: The text to estimate
+    :type text: str
+    :return: Estimated token count
+    :rtype: int
+    """
+    return math.ceil(len(text) / _CHARS_PER_TOKEN)
+
+
+def chunk_text(text: str, max_tokens: int) -> List[str]:
+    """Split text into chunks whose estimated size fits ``max_tokens``.
+
+    Text is split on paragraph boundaries first, then on sentence boundaries for
+    paragraphs that are too large on their own, and finally on a hard character
+    limit. Adjacent pieces are packed greedily into chunks.
+
+    :param text: The text to split
+    :type text: str
+    :param max_tokens: Maximum estimated tokens per chunk
+    :type max_tokens: int
+    :return: List of chunks, in document order
+    :rtype: List[str]
+    :raises ValueError: If ``max_tokens`` is not positive
+    """
+    if max_tokens <= 0:
+        raise ValueError("max_tokens must be a positive integer")
+
+    max_chars = int(max_tokens * _CHARS_PER_TOKEN)
+
+    pieces: List[str] = []
+    for paragraph in _PARAGRAPH_BREAK.split(text):
+        paragraph = paragraph.strip()
+        if not paragraph:
+            continue
+        if len(paragraph) <= max_chars:
+            pieces.append(paragraph)
+            continue
+        for sentence in _SENTENCE_BREAK.split(paragraph):
+            # Hard split anything that still does not fit
+            for start in range(0, len(sentence), max_chars):
+                pieces.append(sentence[start : start + max_chars])
+
+    chunks: List[str] = []
+    current: List[str] = []
+    current_len = 0
+    for piece in pieces:
+        # Account for the separator that joins pieces back together
+        added = len(piece) + (2 if current else 0)
+        if current and current_len + added > max_chars:
+            chunks.append("\n\n".join(current))
+            current, current_len = [], 0
+            added = len(piece)
+        current.append(piece)
+        current_len += added
+    if current:
+        chunks.append("\n\n".join(current))
+    return chunks
+
+
+@dataclass
+class _PoolSlot:
+    session: Optional[LanguageModelSession] = None
+    used_tokens: int = 0
+
+
+class SessionPool:
+    """A bounded pool of reusable language model sessions.
+
+    The pool creates at most ``size`` sessions, on demand, and hands them out to
+    concurrent requests. Sessions are reused across requests. Because a session
+    accumulates context with every turn, the pool tracks an estimate of the
+    tokens each session has consumed and replaces a session with a fresh one
+    before a request would push it past ``context_window``. A request that still
+    fails with :class:`~apple_fm_sdk.ExceededContextWindowSizeError` is retried
+    once on a fresh session.
+
+    Latency-critical requests can be *hedged* with ``respond(...,
+    hedge_after=...)``: if the first session has not answered within the hedge
+    delay, the same prompt is sent to a second idle session, the first
+    successful result wins, and the other request is cancelled. To keep hedging
+    from doubling the load, each request earns ``hedge_budget`` of a hedge and
+    each hedge spends one, so at most that fraction of requests is hedged over
+    time. A new pool has no credit, and a budget of 0 never hedges.
+
+    :param size: Maximum number of live sessions, which is also the maximum
+        number of concurrent requests
+    :type size: int
+    :param model: Model used for every session in the pool
+    :type model: Optional[SystemLanguageModel]
+    :param instructions: Instructions given to every session in the pool
+    :type instructions: Optional[str]
+    :param tools: Tools given to every session in the pool
+    :type tools: Optional[list[Tool]]
+    :param context_window: Context window size, in tokens, used to decide when a
+        session must be replaced
+    :type context_window: int
+    :param hedge_budget: Fraction of requests that may be hedged, between 0 and 1
+    :type hedge_budget: float
+
+    Example:
+        ::
+
+            import apple_fm_sdk as fm
+
+            pool = fm.SessionPool(size=4, instructions="Answer in one sentence.")
+            answers = await asyncio.gather(
+                *(pool.respond(q) for q in questions)
+            )
+    """
+
+    def __init__(
+        self,
+        size: int = 4,
+        *,
+        model: Optional[SystemLanguageModel] = None,
+        instructions: Optional[str] = None,
+        tools: Optional[List[Tool]] = None,
+        context_window: int = DEFAULT_CONTEXT_WINDOW,
+        hedge_budget: float = 0.05,
+    ):
+        if size <= 0:
+            raise ValueError("size must be a positive integer")
+        if not 0 <= hedge_budget <= 1:
+            raise ValueError("hedge_budget must be between 0 and 1")
+        self.size = size
+        self.context_window = context_window
+        self.hedge_budget = hedge_budget
+        self._model = model
+        self._instructions = instructions
+        self._tools = tools
+        self._base_tokens = estimate_tokens(instructions) if instructions else 0
+        self._idle: "asyncio.Queue[_PoolSlot]" = asyncio.Queue()
+        for _ in range(size):
+            self._idle.put_nowait(_PoolSlot())
+        self.sessions_created = 0
+        self.hedges_sent = 0
+        self.hedges_won = 0
+        self._hedge_credit = 0.0
+
+    def _renew(self, slot: _PoolSlot):
+        slot.session = LanguageModelSession(
+            instructions=self._instructions, model=self._model, tools=self._tools
+        )
+        slot.used_tokens = self._base_tokens
+        self.sessions_created += 1
+
+    def _prepare(self, slot: _PoolSlot, estimated_tokens: int):
+        if (
+            slot.session is None
+            or slot.used_tokens + estimated_tokens > self.context_window
+        ):
+            self._renew(slot)
+
+    @contextlib.asynccontextmanager
+    async def _lease(self, estimated_tokens: int) -> AsyncIterator[_PoolSlot]:
+        slot = await self._idle.get()
+        try:
+            self._prepare(slot, estimated_tokens)
+            yield slot
+        finally:
+            self._idle.put_nowait(slot)
+
+    def _take_hedge_credit(self) -> bool:
+        if self._hedge_credit < 1:
+            return False
+        self._hedge_credit -= 1
+        return True
+
+    async def _respond_on(
+        self, slot: _PoolSlot, prompt: str, generating: Optional[Type[Generable]]
+    ) -> Any:
+        try:
+            result = await slot.session.respond(prompt, generating=generating)
+        except ExceededContextWindowSizeError:
+            if slot.used_tokens == self._base_tokens:
+                raise  # Already a fresh session; the prompt itself is too large
+            self._renew(slot)
+            result = await slot.session.respond(prompt, generating=generating)
+        slot.used_tokens += estimate_tokens(prompt) + estimate_tokens(
+            _render_partial(result)
+        )
+        return result
+
+    async def _cancel_request(self, task: "asyncio.Future[Any]", slot: _PoolSlot):
+        # Cancelling the task cancels the native request through FMTaskCancel
+        task.cancel()
+        with contextlib.suppress(asyncio.CancelledError, Exception):
+            await task
+        # The cancelled turn may be partially recorded in the session's transcript
+        slot.session = None
+
+    async def respond(
+        self,
+        prompt: str,
+        *,
+        generating: Optional[Type[Generable]] = None,
+        reserve_tokens: int = 0,
+        hedge_after: Optional[float] = None,
+    ) -> Any:
+        """Send a prompt to the next idle session in the pool.
+
+        :param prompt: The prompt to send
+        :type prompt: str
+        :param generating: Optional Generable type for guided generation
+        :type generating: Optional[Type[Generable]]
+        :param reserve_tokens: Tokens to reserve for the response when deciding
+            whether the session has enough context left
+        :type reserve_tokens: int
+        :param hedge_after: Seconds to wait for a response before sending the
+            same prompt to a second idle session, for example ``0.8`` for 800 ms.
+            Like every other duration in the SDK and in :mod:`asyncio`, this is
+            in seconds rather than milliseconds. The request is not hedged if
+            this is ``None``, if the pool's hedge budget is spent, or if no
+            other session is idle at that point.
+        :type hedge_after: Optional[float]
+        :return: The response text, or an instance of ``generating``
+        :rtype: Any
+        :raises ExceededContextWindowSizeError: If the prompt does not fit even
+            in a fresh session
+
+        Example:
+            ::
+
+                pool = fm.SessionPool(size=2, hedge_budget=0.1)
+                # Send a backup request if the first takes longer than 800 ms
+                answer = await pool.respond(question, hedge_after=0.8)
+        """
+        needed = estimate_tokens(prompt) + reserve_tokens
+        if hedge_after is None:
+            async with self._lease(needed) as slot:
+                return await self._respond_on(slot, prompt, generating)
+
+        self._hedge_credit = min(self._hedge_credit + self.hedge_budget, _HEDGE_BURST)
+        async with self._lease(needed) as slot:
+            primary = asyncio.ensure_future(self._respond_on(slot, prompt, generating))
+            try:
+                done, _ = await asyncio.wait({primary}, timeout=hedge_after)
+                if done or self._idle.empty() or not self._take_hedge_credit():
+                    return await primary
+                return await self._hedge(primary, prompt, generating, needed)
+            finally:
+                if not primary.done():
+                    await self._cancel_request(primary, slot)
+
+    async def _hedge(
+        self,
+        primary: "asyncio.Future[Any]",
+        prompt: str,
+        generating: Optional[Type[Generable]],
+        needed: int,
+    ) -> Any:
+        """Race a second request against ``primary`` and return the first success."""
+        slot = self._idle.get_nowait()
+        self.hedges_sent += 1
+        try:
+            self._prepare(slot, needed)
+            hedge = asyncio.ensure_future(self._respond_on(slot, prompt, generating))
+            try:
+                pending = {primary, hedge}
+                first_error: Optional[BaseException] = None
+                while pending:
+                    done, pending = await asyncio.wait(
+                        pending, return_when=asyncio.FIRST_COMPLETED
+                    )
+                    for task in done:
+                        if task.exception() is None:
+                            if task is hedge:
+                                self.hedges_won += 1
+                            return task.result()
+                        first_error = first_error or task.exception()
+                raise first_error
+            finally:
+                if not hedge.done():
+                    await self._cancel_request(hedge, slot)
+        finally:
+            self._idle.put_nowait(slot)
+
+
+@dataclass
+class PipelineProgress:
+    """A progress update from :func:`map_reduce_stream`.
+
+    :ivar stage: ``"map"`` when a chunk has been processed, ``"reduce"`` when a
+        group of partial results has been combined, or ``"done"`` for the final
+        update carrying the overall result
+    :vartype stage: str
+    :ivar level: Reduction level, 0 for the map stage
+    :vartype level: int
+    :ivar index: Index of the chunk or group within its level
+    :vartype index: int
+    :ivar total: Number of chunks or groups in this level
+    :vartype total: int
+    :ivar result: The result produced by this step
+    :vartype result: Any
+    """
+
+    stage: str
+    level: int
+    index: int
+    total: int
+    result: Any
+
+
+def _render_partial(result: Any) -> str:
+    """Render a partial result as prompt text."""
+    if isinstance(result, str):
+        return result
+    if dataclasses.is_dataclass(result) and not isinstance(result, type):
+        return json.dumps(dataclasses.asdict(result), default=str)
+    return str(result)
+
+
+def _format_map_prompt(template: PromptTemplate, chunk: str) -> str:
+    if callable(template):
+        return template(chunk)
+    return template.replace("{chunk}", chunk)
+
+
+def _format_reduce_prompt(template: ReducePromptTemplate, partials: List[Any]) -> str:
+    rendered = [_render_partial(p) for p in partials]
+    if callable(template):
+        return template(rendered)
+    return template.replace("{partials}", "\n\n".join(rendered))
+
+
+def _group_partials(
+    partials: List[Any], fan_in: int, max_tokens: int
+) -> List[List[Any]]:
+    """Group partial results so that each group fits both fan-in and token budget."""
+    groups: List[List[Any]] = []
+    current: List[Any] = []
+    current_tokens = 0
+    for partial in partials:
+        tokens = estimate_tokens(_render_partial(partial))
+        if current and (
+            len(current) >= fan_in or current_tokens + tokens > max_tokens
+        ):
+            groups.append(current)
+            current, current_tokens = [], 0
+        current.append(partial)
+        current_tokens += tokens
+    if current:
+        groups.append(current)
+    # A reduction level must make progress; never emit only single-item groups
+    if len(groups) == len(partials) and len(partials) > 1:
+        groups = [partials[i : i + 2] for i in range(0, len(partials), 2)]
+    return groups
+
+
+async def map_reduce_stream(
+    document: str,
+    *,
+    map_prompt: PromptTemplate,
+    reduce_prompt: Optional[ReducePromptTemplate] = None,
+    merge: Optional[MergeFunction] = None,
+    generating: Optional[Type[Generable]] = None,
+    concurrency: int = 4,
+    model: Optional[SystemLanguageModel] = None,
+    instructions: Optional[str] = None,
+    chunk_tokens: int = 1500,
+    fan_in: int = 4,
+) -> AsyncIterator[PipelineProgress]:
+    """Run a map-reduce pipeline over a long document, yielding progress.
+
+    The document is split into chunks of at most ``chunk_tokens`` estimated
+    tokens. Each chunk is mapped through the model with ``map_prompt``, with up
+    to ``concurrency`` requests in flight. Partial results are then combined
+    in groups of up to ``fan_in`` per level, either by ``merge`` (a Python
+    function, sync or async) or by asking the model with ``reduce_prompt``,
+    until a single result remains.
+
+    Every map and reduce request runs on a new session that holds only
+    ``instructions``, so no chunk is answered in the context of another.
+
+    A :class:`PipelineProgress` is yielded as each map or reduce step finishes,
+    in completion order, followed by a final ``"done"`` update whose ``result``
+    is the overall result.
+
+    :param document: The text to process
+    :type document: str
+    :param map_prompt: Prompt applied to each chunk. Either a string containing
+        ``{chunk}``, or a callable that takes the chunk and returns the prompt.
+    :type map_prompt: Union[str, Callable[[str], str]]
+    :param reduce_prompt: Prompt used to combine partial results. Either a
+        string containing ``{partials}``, or a callable that takes the rendered
+        partial results and returns the prompt. Required unless ``merge`` is given.
+    :type reduce_prompt: Optional[Union[str, Callable[[List[str]], str]]]
+    :param merge: Function that combines a list of partial results into one.
+        Takes precedence over ``reduce_prompt``.
+    :type merge: Optional[Callable[[List[Any]], Any]]
+    :param generating: Optional Generable type for guided generation. Both the
+        map and the model-driven reduce steps produce instances of this type.
+    :type generating: Optional[Type[Generable]]
+    :param concurrency: Maximum number of map or reduce requests in flight
+    :type concurrency: int
+    :param model: Model used for every request
+    :type model: Optional[SystemLanguageModel]
+    :param instructions: Instructions given to every request's session
+    :type instructions: Optional[str]
+    :param chunk_tokens: Maximum estimated tokens per chunk, and per group of
+        partial results passed to ``reduce_prompt``
+    :type chunk_tokens: int
+    :param fan_in: Maximum number of partial results combined per reduce step
+    :type fan_in: int
+    :yields: Progress updates, ending with a ``"done"`` update
+    :ytype: PipelineProgress
+    :raises ValueError: If neither ``reduce_prompt`` nor ``merge`` is provided
+    :raises ExceededContextWindowSizeError: If a chunk or group of partial
+        results does not fit in a session with ``instructions``
+    """
+    if reduce_prompt is None and merge is None:
+        raise ValueError("Either 'reduce_prompt' or 'merge' must be provided")
+    if fan_in < 2:
+        raise ValueError("fan_in must be at least 2")
+    if concurrency <= 0:
+        raise ValueError("concurrency must be a positive integer")
+
+    chunks = chunk_text(document, chunk_tokens)
+    if not chunks:
+        raise ValueError("Document is empty")
+
+    limit = asyncio.Semaphore(concurrency)
+
+    async def _respond(prompt: str) -> Any:
+        async with limit:
+            # A new session per step keeps earlier chunks out of its context
+            session = LanguageModelSession(instructions=instructions, model=model)
+            return await session.respond(prompt, generating=generating)
+
+    async def _map(index: int, chunk: str):
+        return index, await _respond(_format_map_prompt(map_prompt, chunk))
+
+    async def _reduce(index: int, group: List[Any]):
+        if merge is not None:
+            merged = merge(group)
+            if asyncio.iscoroutine(merged):
+                merged = await merged
+            return index, merged
+        return index, await _respond(_format_reduce_prompt(reduce_prompt, group))
+
+    async def _run_level(stage: str, level: int, coros, results: List[Any]):
+        tasks = [asyncio.ensure_future(c) for c in coros]
+        results.extend([None] * len(tasks))
+        try:
+            for finished in asyncio.as_completed(tasks):
+                index, result = await finished
+                results[index] = result
+                yield PipelineProgress(stage, level, index, len(tasks), result)
+        finally:
+            # Stop outstanding work if a step failed or the consumer stopped early
+            for task in tasks:
+                task.cancel()
+            await asyncio.gather(*tasks, return_exceptions=True)
+
+    partials: List[Any] = []
+    map_steps = [_map(i, chunk) for i, chunk in enumerate(chunks)]
+    async for progress in _run_level("map", 0, map_steps, partials):
+        yield progress
+
+    level = 0
+    while len(partials) > 1:
+        level += 1
+        groups = _group_partials(partials, fan_in, chunk_tokens)
+        partials = []
+        reduce_steps = [_reduce(i, group) for i, group in enumerate(groups)]
+        async for progress in _run_level("reduce", level, reduce_steps, partials):
+            yield progress
+
+    yield PipelineProgress("done", level, 0, 1, partials[0])
+
+
+async def map_reduce(document: str, **kwargs) -> Any:
+    """Run a map-reduce pipeline over a long document and return the result.
+
+    Accepts the same arguments as :func:`map_reduce_stream`, and returns the
+    ``result`` of its final ``"done"`` update.
+
+    :param document: The text to process
+    :type document: str
+    :return: The fully reduced result: a string, or an instance of the
+        ``generating`` type, or whatever ``merge`` returns
+    :rtype: Any
+    """
+    result = None
+    async for progress in map_reduce_stream(document, **kwargs):
+        result = progress.result
+    return result
@@ -0,0 +1,469 @@
+# For licensing see accompanying LICENSE file.
+# Copyright (C) 2026 Apple Inc. All Rights Reserved.
+
+"""
+Column-oriented storage for many structured results.
+
+Keeping every structured response as a :class:`GeneratedContent` or a
+Generable instance costs a dictionary, an object header and, for
+GeneratedContent, a native reference per result. A :class:`ResultBatch`
+instead appends each property of a schema to its own column:
+
+* ``int``, ``float`` and ``bool`` properties are stored in typed
+  :class:`array.array` buffers
+* ``str`` properties are stored as an offsets array and a UTF-8 data buffer
+* Any other property (lists, nested types) is stored like a string, as JSON text
+* ``Optional`` properties have a validity bitmap with one bit per row
+
+GeneratedContent values are read by the native layer, which encodes a whole
+group of them into column buffers in one call, so no per-result dictionary is
+built. Only the standard library is used.
+
+Example:
+    ::
+
+        import apple_fm_sdk as fm
+
+        batch = fm.ResultBatch(Review)
+        for text in reviews:
+            batch.append(await session.respond(text, schema=Review.generation_schema()))
+
+        ratings = batch.column("rating")
+        print(sum(ratings.data) / len(ratings))
+"""
+
+import ctypes
+import dataclasses
+import json
+from array import array
+from enum import Enum
+from typing import Any, Dict, Iterable, List, Optional, Type, Union, get_args, get_origin
+
+from .errors import _status_code_to_exception
+from .c_helpers import _get_error_string
+from .generable import GeneratedContent, Generable
+from .generation_schema import GenerationSchema
+
+try:
+    from . import _ctypes_bindings as lib
+except ImportError:
+    raise ImportError(
+        "Foundation Models C bindings not found. Please ensure _foundationmodels_ctypes.py is available."
+    )
+
+# Number of GeneratedContent values encoded per native call
+_NATIVE_BATCH_SIZE = 4096
+
+
+class ColumnType(Enum):
+    """The storage type of a :class:`Column`."""
+
+    INT = 0
+    DOUBLE = 1
+    BOOL = 2
+    STRING = 3
+    JSON = 4
+
+
+_TYPE_CODES = {ColumnType.INT: "q", ColumnType.DOUBLE: "d", ColumnType.BOOL: "B"}
+
+
+def _column_type(type_class: Any) -> "tuple[ColumnType, bool]":
+    """Map a property type to its column type and whether it is nullable."""
+    nullable = False
+    if get_origin(type_class) is Union:
+        args = [arg for arg in get_args(type_class) if arg is not type(None)]
+        nullable = len(args) < len(get_args(type_class))
+        type_class = args[0] if len(args) == 1 else type_class
+    if type_class is bool:
+        return ColumnType.BOOL, nullable
+    if type_class is int:
+        return ColumnType.INT, nullable
+    if type_class is float:
+        return ColumnType.DOUBLE, nullable
+    if type_class is str:
+        return ColumnType.STRING, nullable
+    return ColumnType.JSON, nullable
+
+
+def _json_default(value: Any) -> Any:
+    if dataclasses.is_dataclass(value) and not isinstance(value, type):
+        return dataclasses.asdict(value)
+    if isinstance(value, Enum):
+        return value.value
+    raise TypeError(f"Object of type {type(value).__name__} is not JSON serializable")
+
+
+class Column:
+    """One property of a :class:`ResultBatch`, stored contiguously.
+
+    The raw buffers can be used directly for aggregation. For ``INT``,
+    ``DOUBLE`` and ``BOOL`` columns, :attr:`data` holds one value per row, with
+    zero for null rows. For ``STRING`` and ``JSON`` columns, row ``i`` is
+    ``data[offsets[i]:offsets[i + 1]]`` as UTF-8.
+
+    :ivar name: The property name
+    :vartype name: str
+    :ivar type: How the values are stored
+    :vartype type: ColumnType
+    :ivar nullable: Whether the property is Optional
+    :vartype nullable: bool
+    :ivar data: The values, or the UTF-8 data of a string or JSON column
+    :vartype data: Union[array.array, bytearray]
+    :ivar offsets: Row offsets into :attr:`data` for string and JSON columns,
+        otherwise None
+    :vartype offsets: Optional[array.array]
+    :ivar validity: Bitmap with bit ``i % 8`` of byte ``i // 8`` set when row
+        ``i`` is not null, for nullable columns; otherwise None
+    :vartype validity: Optional[bytearray]
+    """
+
+    __slots__ = ("name", "type", "nullable", "data", "offsets", "validity", "_length")
+
+    def __init__(self, name: str, type: ColumnType, nullable: bool):
+        self.name = name
+        self.type = type
+        self.nullable = nullable
+        if type in _TYPE_CODES:
+            self.data: Union[array, bytearray] = array(_TYPE_CODES[type])
+            self.offsets: Optional[array] = None
+        else:
+            self.data = bytearray()
+            self.offsets = array("q", [0])
+        self.validity: Optional[bytearray] = bytearray() if nullable else None
+        self._length = 0
+
+    def __len__(self) -> int:
+        return self._length
+
+    def __getitem__(self, index: int) -> Any:
+        if index < 0:
+            index += self._length
+        if not 0 <= index < self._length:
+            raise IndexError("column index out of range")
+        if not self.is_valid(index):
+            return None
+        if self.offsets is None:
+            value = self.data[index]
+            return bool(value) if self.type is ColumnType.BOOL else value
+        text = self.data[self.offsets[index] : self.offsets[index + 1]].decode("utf-8")
+        return json.loads(text) if self.type is ColumnType.JSON else text
+
+    def is_valid(self, index: int) -> bool:
+        """Whether row ``index`` holds a value rather than null."""
+        if self.validity is None:
+            return True
+        return bool(self.validity[index >> 3] & (1 << (index & 7)))
+
+    @property
+    def null_count(self) -> int:
+        """Number of null rows."""
+        if self.validity is None:
+            return 0
+        return self._length - sum(bin(byte).count("1") for byte in self.validity)
+
+    @property
+    def nbytes(self) -> int:
+        """Bytes used by the column's buffers."""
+        size = len(self.data) * (self.data.itemsize if isinstance(self.data, array) else 1)
+        if self.offsets is not None:
+            size += len(self.offsets) * self.offsets.itemsize
+        if self.validity is not None:
+            size += len(self.validity)
+        return size
+
+    def to_list(self) -> List[Any]:
+        """Decode every row, with None for null rows."""
+        return [self[i] for i in range(self._length)]
+
+    def _convert(self, value: Any) -> Any:
+        """Check a value against the column type, returning what to store."""
+        if value is None:
+            if not self.nullable:
+                raise ValueError(f"Property '{self.name}' is missing")
+            return None
+        kind = self.type
+        if kind is ColumnType.STRING:
+            if isinstance(value, str):
+                return value.encode("utf-8")
+        elif kind is ColumnType.JSON:
+            return json.dumps(value, default=_json_default).encode("utf-8")
+        elif kind is ColumnType.BOOL:
+            if isinstance(value, bool):
+                return int(value)
+        elif isinstance(value, bool):
+            pass
+        elif kind is ColumnType.INT:
+            if isinstance(value, float) and value.is_integer():
+                value = int(value)
+            if isinstance(value, int) and -(2**63) <= value < 2**63:
+                return value
+        elif isinstance(value, (int, float)):
+            return float(value)
+        raise ValueError(
+            f"Property '{self.name}' value {value!r} does not fit a {kind.name} column"
+        )
+
+    def _append(self, value: Any):
+        """Append a value returned by :meth:`_convert`."""
+        if self.validity is not None:
+            if self._length & 7 == 0:
+                self.validity.append(0)
+            if value is not None:
+                self.validity[-1] |= 1 << (self._length & 7)
+        if self.offsets is None:
+            self.data.append(0 if value is None else value)
+        else:
+            if value is not None:
+                self.data += value
+            self.offsets.append(len(self.data))
+        self._length += 1
+
+    def _locate_encoded(self, buffer: memoryview, position: int, count: int):
+        """Find this column's part of a native buffer without copying it.
+
+        :return: The bitmap, the values or offsets, the string data (or None),
+            and the position after the column
+        """
+        bitmap_size = (count + 7) // 8
+        bitmap = buffer[position : position + bitmap_size]
+        position += bitmap_size
+        if self.validity is None and count and bytes(bitmap) != _all_valid(count):
+            row = _first_null(bitmap, count)
+            raise ValueError(f"Property '{self.name}' is missing in row {row}")
+
+        if self.offsets is None:
+            size = count * self.data.itemsize
+            return bitmap, buffer[position : position + size], None, position + size
+        offsets = array("q")
+        offsets.frombytes(buffer[position : position + (count + 1) * 8])
+        position += (count + 1) * 8
+        data = buffer[position : position + offsets[-1]]
+        return bitmap, offsets, data, position + offsets[-1]
+
+    def _extend_encoded(self, bitmap: memoryview, values, data, count: int):
+        """Append ``count`` rows located by :meth:`_locate_encoded`."""
+        if self.validity is not None:
+            self._extend_validity(bitmap, count)
+        if self.offsets is None:
+            self.data.frombytes(values)
+        else:
+            base = len(self.data)
+            self.offsets.extend(base + offset for offset in values[1:])
+            self.data += data
+        self._length += count
+
+    def _extend_validity(self, bitmap: memoryview, count: int):
+        shift = self._length & 7
+        if shift == 0:
+            self.validity += bitmap
+            return
+        # Shift the new bits past the ones already in the last byte
+        bits = int.from_bytes(bitmap, "little") << shift
+        bits |= self.validity.pop()
+        self.validity += bits.to_bytes((shift + count + 7) // 8, "little")
+
+
+def _all_valid(count: int) -> bytes:
+    full, rest = divmod(count, 8)
+    return b"\xff" * full + (bytes([(1 << rest) - 1]) if rest else b"")
+
+
+def _first_null(bitmap: memoryview, count: int) -> int:
+    for row in range(count):
+        if not bitmap[row >> 3] & (1 << (row & 7)):
+            return row
+    return -1
+
+
+class ResultBatch:
+    """Column-oriented storage for structured results of one schema.
+
+    Results can be appended as :class:`GeneratedContent`, instances of the
+    Generable type, or dictionaries. GeneratedContent values are encoded by
+    the native layer in groups, which is the fastest way to fill a batch.
+
+    :param schema: The Generable type or GenerationSchema of the results
+    :type schema: Union[Type[Generable], GenerationSchema]
+    :raises ValueError: If ``schema`` is not a Generable type or a GenerationSchema
+
+    Example:
+        ::
+
+            from typing import Optional
+            import apple_fm_sdk as fm
+
+            @fm.generable("A product review")
+            class Review:
+                rating: int = fm.guide("Rating out of five", range=(1, 5))
+                summary: str
+                recommended: bool
+                reviewer: Optional[str]
+
+            batch = fm.ResultBatch(Review)
+            batch.extend(contents)  # a list of GeneratedContent
+
+            ratings = batch.column("rating").data  # array('q', [...])
+            share = sum(batch.column("recommended").data) / len(batch)
+            print(batch.column("reviewer").null_count, batch.nbytes)
+    """
+
+    def __init__(self, schema: Union[Type[Generable], GenerationSchema]):
+        if not isinstance(schema, GenerationSchema):
+            if not isinstance(schema, Generable):
+                raise ValueError(
+                    f"{schema!r} is not a Generable type or GenerationSchema"
+                )
+            schema = schema.generation_schema()
+        self.schema = schema
+        self._columns: Dict[str, Column] = {}
+        for prop in schema.properties:
+            column_type, nullable = _column_type(prop.type_class)
+            self._columns[prop.name] = Column(prop.name, column_type, nullable)
+        self._length = 0
+
+    def __len__(self) -> int:
+        return self._length
+
+    @property
+    def columns(self) -> List[str]:
+        """The property names, in schema order."""
+        return list(self._columns)
+
+    def column(self, name: str) -> Column:
+        """Get the column for a property.
+
+        :param name: The property name
+        :type name: str
+        :return: The column
+        :rtype: Column
+        :raises KeyError: If the schema has no such property
+        """
+        return self._columns[name]
+
+    @property
+    def nbytes(self) -> int:
+        """Bytes used by all column buffers."""
+        return sum(column.nbytes for column in self._columns.values())
+
+    def row(self, index: int) -> Dict[str, Any]:
+        """Decode one row as a dictionary of property values.
+
+        :param index: The row
+        :type index: int
+        :return: The row's values, keyed by property name
+        :rtype: Dict[str, Any]
+        """
+        return {name: column[index] for name, column in self._columns.items()}
+
+    def to_pydict(self) -> Dict[str, List[Any]]:
+        """Decode every column as a list.
+
+        :return: A list of values per property name
+        :rtype: Dict[str, List[Any]]
+        """
+        return {name: column.to_list() for name, column in self._columns.items()}
+
+    def append(self, result: Any):
+        """Append one result.
+
+        :param result: A GeneratedContent, an instance of the Generable type, or
+            a dictionary of property values
+        :raises ValueError: If a required property is missing or a value does
+            not match its column type
+        """
+        self.extend([result])
+
+    def extend(self, results: Iterable[Any]):
+        """Append many results.
+
+        Consecutive GeneratedContent values are encoded natively in groups. If
+        a result is invalid, the results before it in the same group are not
+        appended either.
+
+        :param results: GeneratedContent values, instances of the Generable
+            type, or dictionaries of property values
+        :raises ValueError: If a required property is missing or a value does
+            not match its column type
+        """
+        pending: List[GeneratedContent] = []
+        for result in results:
+            if isinstance(result, GeneratedContent) and getattr(result, "_ptr", None):
+                pending.append(result)
+                if len(pending) == _NATIVE_BATCH_SIZE:
+                    self._extend_native(pending)
+                    pending = []
+                continue
+            if pending:
+                self._extend_native(pending)
+                pending = []
+            self._append_values(result)
+        if pending:
+            self._extend_native(pending)
+
+    def _append_values(self, result: Any):
+        if isinstance(result, GeneratedContent):
+            values = result._content_dict
+        elif isinstance(result, dict):
+            values = result
+        elif dataclasses.is_dataclass(result) and not isinstance(result, type):
+            values = {name: getattr(result, name, None) for name in self._columns}
+        else:
+            raise ValueError(
+                f"Cannot append {type(result).__name__}; expected GeneratedContent, "
+                "a Generable instance or a dict"
+            )
+        # Check every value first so that a bad row leaves all columns aligned
+        columns = self._columns.values()
+        converted = [column._convert(values.get(column.name)) for column in columns]
+        for column, value in zip(columns, converted):
+            column._append(value)
+        self._length += 1
+
+    def _extend_native(self, contents: List[GeneratedContent]):
+        columns = list(self._columns.values())
+        count = len(contents)
+        refs = (ctypes.c_void_p * count)(*(content._ptr for content in contents))
+        names = (ctypes.c_char_p * len(columns))(
+            *(column.name.encode("utf-8") for column in columns)
+        )
+        kinds = (ctypes.c_uint8 * len(columns))(*(column.type.value for column in columns))
+        out_buffer = ctypes.POINTER(ctypes.c_char)()
+        error_code = ctypes.c_int32()
+        error_description = ctypes.POINTER(ctypes.c_char)()
+
+        length = lib.FMGeneratedContentBatchEncodeColumns(
+            refs,
+            count,
+            names,
+            kinds,
+            len(columns),
+            ctypes.byref(out_buffer),
+            ctypes.byref(error_code),
+            ctypes.byref(error_description),
+        )
+        if length < 0:
+            err_code, err_desc = _get_error_string(error_code, error_description)
+            error_msg = "Failed to encode results as columns"
+            if err_desc:
+                error_msg = error_msg + ": " + err_desc
+            raise _status_code_to_exception(err_code or error_code.value, error_msg)
+
+        try:
+            buffer = memoryview(
+                (ctypes.c_char * length).from_address(
+                    ctypes.cast(out_buffer, ctypes.c_void_p).value
+                )
+            ).cast("B")
+            # Locate and check every column first so that a bad group appends nothing
+            located = []
+            position = 0
+            for column in columns:
+                *parts, position = column._locate_encoded(buffer, position, count)
+                located.append(parts)
+            for column, (bitmap, values, data) in zip(columns, located):
+                column._extend_encoded(bitmap, values, data, count)
+        finally:
+            lib.FMFreeString(out_buffer)
+
+        self._length += count
@@ -0,0 +1,512 @@
+# For licensing see accompanying LICENSE file.
+# Copyright (C) 2026 Apple Inc. All Rights Reserved.
+
+"""
+Fair sharing of the on-device model between tenants.
+
+The model processes one inference call at a time, so requests from concurrent
+sessions queue inside the framework in arrival order. A tenant that submits a
+long batch of requests therefore delays every other tenant on the machine
+until its batch is done. A :class:`FairScheduler` admits session requests
+itself, so it decides which tenant goes next:
+
+* Tenants are served in deficit round robin order. Each turn credits a tenant
+  with ``quantum * weight`` seconds, and each request is charged the time it
+  actually held the model. Over time, tenants that are waiting share the
+  model in proportion to their weights, however long their requests are.
+* A tenant can be given quotas of requests and of generation seconds per
+  ``quota_period``. Requests over quota wait until the quota allows them.
+* Queue-wait and generation-time metrics are kept per tenant.
+
+The main components are:
+
+* :class:`FairScheduler` - Admits requests in fair-share order
+* :class:`TenantStats` - Counters and wait times of one tenant
+* :func:`set_scheduler` - Route all session requests through a scheduler
+* :func:`tenant` - Select the tenant of the requests made in a block
+
+Example:
+    ::
+
+        import apple_fm_sdk as fm
+
+        scheduler = fm.FairScheduler()
+        scheduler.configure("interactive", weight=4.0)
+        scheduler.configure("batch", weight=1.0, max_generation_seconds=600)
+        fm.set_scheduler(scheduler)
+
+        async def handle_message(session, message):
+            with fm.tenant("interactive"):
+                return await session.respond(message)
+
+        async def nightly_report(session, documents):
+            with fm.tenant("batch"):
+                for document in documents:
+                    await session.respond(f"Summarize:\\n\\n{document}")
+"""
+
+import asyncio
+import contextlib
+import contextvars
+import time
+from collections import deque
+from dataclasses import dataclass, replace
+from typing import AsyncIterator, Deque, Dict, Iterator, List, Optional, Tuple
+
+DEFAULT_TENANT = "default"
+
+_current_tenant: contextvars.ContextVar[str] = contextvars.ContextVar(
+    "apple_fm_sdk_tenant", default=DEFAULT_TENANT
+)
+
+
+class _Admission:
+    """A held slot, or a tool call made on behalf of a request that holds one."""
+
+    __slots__ = ("held",)
+
+    def __init__(self):
+        self.held = True
+
+
+# The admission of the current task. Requests made while it is held are not
+# queued again, because with a single slot they would wait for themselves.
+# Tasks created meanwhile share the admission object, so they stop bypassing
+# the queue as soon as it is released.
+_admitted: contextvars.ContextVar[Optional[_Admission]] = contextvars.ContextVar(
+    "apple_fm_sdk_admitted", default=None
+)
+
+
+def _is_admitted() -> bool:
+    """Whether the current task holds an admission that has not been released."""
+    admission = _admitted.get()
+    return admission is not None and admission.held
+
+_scheduler: Optional["FairScheduler"] = None
+
+
+@dataclass
+class TenantStats:
+    """Counters of one tenant of a :class:`FairScheduler`.
+
+    Times are in seconds. Wait times are measured from the moment a request
+    asks for a slot until it is admitted.
+
+    :ivar tenant: Name of the tenant
+    :vartype tenant: str
+    :ivar weight: Share of the model given to the tenant, relative to others
+    :vartype weight: float
+    :ivar requests: Requests admitted
+    :vartype requests: int
+    :ivar completed: Admitted requests that have released their slot
+    :vartype completed: int
+    :ivar waiting: Requests currently queued
+    :vartype waiting: int
+    :ivar running: Requests currently holding a slot
+    :vartype running: int
+    :ivar total_wait: Sum of the queue waits of admitted requests
+    :vartype total_wait: float
+    :ivar max_wait: Longest queue wait of an admitted request
+    :vartype max_wait: float
+    :ivar throttled: Admissions delayed because the tenant was over quota
+    :vartype throttled: int
+    :ivar generation_seconds: Time completed requests held a slot
+    :vartype generation_seconds: float
+    """
+
+    tenant: str
+    weight: float = 1.0
+    requests: int = 0
+    completed: int = 0
+    waiting: int = 0
+    running: int = 0
+    total_wait: float = 0.0
+    max_wait: float = 0.0
+    throttled: int = 0
+    generation_seconds: float = 0.0
+
+    @property
+    def mean_wait(self) -> float:
+        """Average queue wait of admitted requests, or 0 before the first.
+
+        :rtype: float
+        """
+        return self.total_wait / self.requests if self.requests else 0.0
+
+
+class _Tenant:
+    """Queue, credit and quota usage of one tenant."""
+
+    def __init__(self, name: str):
+        self.stats = TenantStats(tenant=name)
+        self.max_requests: Optional[int] = None
+        self.max_generation_seconds: Optional[float] = None
+        # Waiters in arrival order, as (future, time asked)
+        self.queue: Deque[Tuple[asyncio.Future, float]] = deque()
+        self.deficit = 0.0
+        self.active = False
+        # Admission times, and (release time, seconds held), within the quota period
+        self.starts: Deque[float] = deque()
+        self.usage: Deque[Tuple[float, float]] = deque()
+        self.over_quota = False
+
+    def available_at(self, now: float, period: float) -> float:
+        """Earliest time the quotas allow this tenant another request."""
+        while self.starts and self.starts[0] <= now - period:
+            self.starts.popleft()
+        while self.usage and self.usage[0][0] <= now - period:
+            self.usage.popleft()
+        at = now
+        if self.max_requests is not None and len(self.starts) >= self.max_requests:
+            at = max(at, self.starts[-self.max_requests] + period)
+        if self.max_generation_seconds is not None:
+            used = sum(seconds for _, seconds in self.usage)
+            for released, seconds in self.usage:
+                if used < self.max_generation_seconds:
+                    break
+                used -= seconds
+                at = max(at, released + period)
+        return at
+
+
+class FairScheduler:
+    """Admits model requests from several tenants in fair-share order.
+
+    Install a scheduler with :func:`set_scheduler` to route every request of
+    every :class:`~apple_fm_sdk.LanguageModelSession` through it, or hold a
+    slot explicitly with :meth:`slot`. Requests belong to the tenant selected
+    with :func:`tenant`, or to ``"default"``. Tenants that are not configured
+    have weight 1 and no quotas.
+
+    Only ``concurrency`` requests hold a slot at a time. The default of one
+    matches the model, which runs one inference call at a time, and leaves the
+    order of all queued requests to the scheduler.
+
+    :param concurrency: Number of requests that may run at the same time
+    :type concurrency: int
+    :param quantum: Generation seconds credited to a weight 1 tenant per turn.
+        Smaller values interleave tenants more finely.
+    :type quantum: float
+    :param quota_period: Length of the sliding window quotas apply to, in seconds
+    :type quota_period: float
+    :raises ValueError: If an argument is not positive
+
+    Example:
+        Giving a batch job a fixed budget::
+
+            scheduler = fm.FairScheduler(quota_period=3600)
+            scheduler.configure("batch", max_requests=500, max_generation_seconds=900)
+            fm.set_scheduler(scheduler)
+
+            with fm.tenant("batch"):
+                results = await fm.map_reduce(report, map_prompt=...)
+
+            stats = scheduler.tenant_stats("interactive")
+            print(f"Interactive requests waited {stats.mean_wait:.2f} s on average")
+
+    Note:
+        - A request holds its slot until it completes. A stream holds it until
+          it ends or is closed, so consume streams promptly
+        - Requests made from a tool call, or from a task that holds a slot or
+          was created while holding one, run as part of that slot and are
+          not queued again
+        - A scheduler must only be used from one event loop at a time
+    """
+
+    def __init__(
+        self,
+        *,
+        concurrency: int = 1,
+        quantum: float = 0.5,
+        quota_period: float = 60.0,
+    ):
+        if concurrency < 1:
+            raise ValueError("concurrency must be at least 1")
+        if quantum <= 0:
+            raise ValueError("quantum must be positive")
+        if quota_period <= 0:
+            raise ValueError("quota_period must be positive")
+        self.concurrency = concurrency
+        self.quantum = quantum
+        self.quota_period = quota_period
+        self._tenants: Dict[str, _Tenant] = {}
+        # Tenants with queued requests, in round robin order
+        self._ring: Deque[_Tenant] = deque()
+        self._running = 0
+        self._loop: Optional[asyncio.AbstractEventLoop] = None
+        self._timer: Optional[asyncio.TimerHandle] = None
+
+    def configure(
+        self,
+        tenant: str,
+        *,
+        weight: float = 1.0,
+        max_requests: Optional[int] = None,
+        max_generation_seconds: Optional[float] = None,
+    ):
+        """Set the weight and quotas of a tenant.
+
+        :param tenant: Name of the tenant
+        :type tenant: str
+        :param weight: Share of the model relative to other tenants. A tenant
+            with weight 2 gets twice the generation time of a tenant with
+            weight 1 while both have requests waiting.
+        :type weight: float
+        :param max_requests: Maximum requests admitted per quota period, or
+            None for no limit
+        :type max_requests: Optional[int]
+        :param max_generation_seconds: Maximum time the tenant's requests may
+            hold a slot per quota period, or None for no limit. A request that
+            starts within the quota runs to completion.
+        :type max_generation_seconds: Optional[float]
+        :raises ValueError: If an argument is not positive
+        """
+        if weight <= 0:
+            raise ValueError("weight must be positive")
+        if max_requests is not None and max_requests < 1:
+            raise ValueError("max_requests must be at least 1")
+        if max_generation_seconds is not None and max_generation_seconds <= 0:
+            raise ValueError("max_generation_seconds must be positive")
+        state = self._tenant(tenant)
+        state.stats.weight = weight
+        state.max_requests = max_requests
+        state.max_generation_seconds = max_generation_seconds
+        # New quotas may admit requests that were held back
+        if self._ring:
+            self._dispatch()
+
+    @property
+    def tenants(self) -> List[str]:
+        """Names of the tenants configured or seen so far.
+
+        :rtype: List[str]
+        """
+        return list(self._tenants)
+
+    def tenant_stats(self, tenant: str) -> TenantStats:
+        """Return a snapshot of one tenant's counters.
+
+        :param tenant: Name of the tenant
+        :type tenant: str
+        :rtype: TenantStats
+        """
+        return replace(self._tenant(tenant).stats)
+
+    def stats(self) -> Dict[str, TenantStats]:
+        """Return a snapshot of every tenant's counters, by tenant name.
+
+        :rtype: Dict[str, TenantStats]
+        """
+        return {name: replace(state.stats) for name, state in self._tenants.items()}
+
+    @contextlib.asynccontextmanager
+    async def slot(self, tenant: Optional[str] = None) -> AsyncIterator[None]:
+        """Wait for the scheduler to admit a request, and hold a slot for the block.
+
+        Session requests take a slot on their own once the scheduler is
+        installed. Use this to schedule other work that uses the model, or to
+        keep several requests together.
+
+        :param tenant: Tenant to charge, or None for the current :func:`tenant`
+        :type tenant: Optional[str]
+        :raises asyncio.CancelledError: If cancelled while waiting; the request
+            leaves the queue
+
+        Example:
+            ::
+
+                async with scheduler.slot("batch"):
+                    outline = await session.respond("Outline the report")
+                    draft = await session.respond("Write it")
+        """
+        if _is_admitted():
+            yield
+            return
+        started = await self._acquire(tenant or _current_tenant.get())
+        admission = _Admission()
+        _admitted.set(admission)
+        try:
+            yield
+        finally:
+            # Released through the object rather than reset with a token: a
+            # stream may be closed from another context, and tasks created in
+            # the block hold the same admission
+            admission.held = False
+            self._release(*started)
+
+    async def _acquire(self, name: str) -> Tuple[_Tenant, float]:
+        """Queue a request for ``name`` and wait until it is admitted."""
+        state = self._tenant(name)
+        self._loop = asyncio.get_running_loop()
+        future = self._loop.create_future()
+        state.queue.append((future, time.monotonic()))
+        state.stats.waiting += 1
+        if not state.active:
+            state.active = True
+            self._ring.append(state)
+        self._dispatch()
+        try:
+            return await future
+        except asyncio.CancelledError:
+            if future.done() and not future.cancelled():
+                # Admitted just before the cancellation arrived
+                self._release(*future.result())
+            else:
+                self._withdraw(state, future)
+            raise
+
+    def _release(self, state: _Tenant, started: float):
+        now = time.monotonic()
+        held = now - started
+        state.deficit -= held
+        state.usage.append((now, held))
+        state.stats.running -= 1
+        state.stats.completed += 1
+        state.stats.generation_seconds += held
+        self._running -= 1
+        self._dispatch()
+
+    def _withdraw(self, state: _Tenant, future: asyncio.Future):
+        for i, (waiter, _) in enumerate(state.queue):
+            if waiter is future:
+                del state.queue[i]
+                state.stats.waiting -= 1
+                break
+        if not state.queue:
+            self._deactivate(state)
+        self._dispatch()
+
+    def _deactivate(self, state: _Tenant):
+        # An idle tenant keeps its debt but not its credit, so it cannot bank
+        # turns while it has nothing to run
+        state.active = False
+        state.deficit = min(state.deficit, 0.0)
+        state.over_quota = False
+        self._ring.remove(state)
+
+    def _dispatch(self):
+        """Admit queued requests while slots are free."""
+        while self._running < self.concurrency and self._ring:
+            state = self._next()
+            if state is None:
+                return
+            future, asked = state.queue.popleft()
+            state.stats.waiting -= 1
+            if not state.queue:
+                self._deactivate(state)
+            if future.cancelled():
+                continue
+            now = time.monotonic()
+            wait = now - asked
+            state.starts.append(now)
+            state.stats.requests += 1
+            state.stats.running += 1
+            state.stats.total_wait += wait
+            state.stats.max_wait = max(state.stats.max_wait, wait)
+            self._running += 1
+            future.set_result((state, now))
+
+    def _next(self) -> Optional[_Tenant]:
+        """Pick the tenant whose request runs next, in deficit round robin order."""
+        now = time.monotonic()
+        eligible = 0
+        retry_at = None
+        for state in self._ring:
+            at = state.available_at(now, self.quota_period)
+            if at > now:
+                if not state.over_quota:
+                    state.over_quota = True
+                    state.stats.throttled += 1
+                retry_at = at if retry_at is None else min(retry_at, at)
+            else:
+                state.over_quota = False
+                eligible += 1
+        if retry_at is not None:
+            self._wake_at(retry_at - now)
+        if not eligible:
+            return None
+        # Terminates because every turn of an eligible tenant adds credit
+        while True:
+            state = self._ring[0]
+            if not state.over_quota and state.deficit > 0:
+                return state
+            if not state.over_quota:
+                state.deficit += self.quantum * state.stats.weight
+            self._ring.rotate(-1)
+
+    def _wake_at(self, delay: float):
+        if self._timer is not None:
+            self._timer.cancel()
+        self._timer = self._loop.call_later(delay, self._wake)
+
+    def _wake(self):
+        self._timer = None
+        self._dispatch()
+
+    def _tenant(self, name: str) -> _Tenant:
+        state = self._tenants.get(name)
+        if state is None:
+            state = self._tenants[name] = _Tenant(name)
+        return state
+
+
+def set_scheduler(scheduler: Optional[FairScheduler]):
+    """Route the requests of every session through ``scheduler``.
+
+    :param scheduler: The scheduler, or None to admit requests directly again
+    :type scheduler: Optional[FairScheduler]
+    """
+    global _scheduler
+    _scheduler = scheduler
+
+
+def get_scheduler() -> Optional[FairScheduler]:
+    """Return the scheduler installed with :func:`set_scheduler`, if any.
+
+    :rtype: Optional[FairScheduler]
+    """
+    return _scheduler
+
+
+@contextlib.contextmanager
+def tenant(name: str) -> Iterator[None]:
+    """Make ``name`` the tenant of the requests made in this block.
+
+    The tenant is a context variable, so it applies to the current task and
+    to tasks created inside the block.
+
+    :param name: Name of the tenant
+    :type name: str
+
+    Example:
+        ::
+
+            with fm.tenant("interactive"):
+                reply = await session.respond(message)
+    """
+    token = _current_tenant.set(name)
+    try:
+        yield
+    finally:
+        _current_tenant.reset(token)
+
+
+@contextlib.asynccontextmanager
+async def _scheduled() -> AsyncIterator[None]:
+    """Hold a slot of the installed scheduler, if there is one."""
+    if _scheduler is None:
+        yield
+        return
+    async with _scheduler.slot():
+        yield
+
+
+async def _exempt(run):
+    """Run a tool call coroutine function outside the scheduler's queue."""
+    admission = _Admission()
+    _admitted.set(admission)
+    try:
+        await run()
+    finally:
+        admission.held = False
@@ -2,14 +2,23 @@
 # Copyright (C) 2026 Apple Inc. All Rights Reserved.
 
 import asyncio
+import contextlib
 import json
 import logging
 from apple_fm_sdk.transcript import Transcript
 from .c_helpers import (
     _ManagedObject,
+    _adopt_into_scope,
+    _borrowed_bytes,
+    _get_error_string,
     _register_handle,
+    _session_broadcast_callback,
     _session_callback,
+    _session_stream_event_callback,
     _session_structured_callback,
+    _session_turn_callback,
+    _StreamEventChannel,
+    _TurnBatch,
     _unregister_handle,
     StreamingCallback,
 )
@@ -17,10 +26,28 @@ from .core import SystemLanguageModel
 from .tool import Tool
 from .generable import Generable, GeneratedContent
 from .generation_schema import GenerationSchema
+from .stream_events import Completed, StreamEvent, _event_from_native
+from .broadcast import BroadcastStream
+from .scheduler import _scheduled, _is_admitted, _current_tenant, get_scheduler
 import threading
 import queue
-from typing import Any, Optional, AsyncIterator, Type, Union, overload
-from .errors import FoundationModelsError
+from typing import (
+    Any,
+    Callable,
+    List,
+    Optional,
+    AsyncIterator,
+    Sequence,
+    Tuple,
+    Type,
+    Union,
+    overload,
+)
+from .errors import (
+    FoundationModelsError,
+    GenerationErrorCode,
+    _status_code_to_exception,
+)
 
 import ctypes
 
@@ -33,7 +60,29 @@ except ImportError:
         "Foundation Models C bindings not found. Please ensure _foundationmodels_ctypes.py is available."
     )
 
-Prompt = str  # Alias for prompt type
+# A prompt is text, or any buffer-protocol object holding UTF-8 bytes (for example
+# ``bytes``, ``bytearray``, ``memoryview`` or an ``mmap``). Bytes-like prompts are
+# handed to the native layer in place, without re-encoding or an intermediate copy.
+Prompt = Union[str, bytes, bytearray, memoryview]
+
+# A turn of respond_many(): a prompt, or a prompt with what to generate for it
+Turn = Union[Prompt, Tuple[Prompt, Union[Type[Generable], GenerationSchema]]]
+
+# Seconds to wait for the native iteration of a stream stopped by ``until`` to end
+_STOP_TIMEOUT = 2.0
+
+
+def _set_stop_sequences(stream_ptr, stop: Sequence[str]):
+    """Hand stop sequences to a native response stream before it is iterated."""
+    if isinstance(stop, str):
+        stop = [stop]
+    encoded = [sequence.encode("utf-8") for sequence in stop if sequence]
+    count = len(encoded)
+    sequences = (ctypes.c_char_p * count)(*encoded)
+    lengths = (ctypes.c_size_t * count)(*(len(sequence) for sequence in encoded))
+    lib.FMLanguageModelSessionResponseStreamSetStopSequences(
+        stream_ptr, sequences, lengths, count
+    )
 
 
 class LanguageModelSession(_ManagedObject):
@@ -103,6 +152,8 @@ class LanguageModelSession(_ManagedObject):
         - :class:`~apple_fm_sdk.transcript.Transcript`: For accessing session history
     """
 
+    __slots__ = ("transcript", "_request_lock", "_active_task", "_tools")
+
     def __init__(
         self,
         instructions: Optional[str] = None,
@@ -135,9 +186,12 @@ class LanguageModelSession(_ManagedObject):
         # Initialize request lock for preventing concurrent requests
         self._request_lock = asyncio.Lock()
         self._active_task = None
+        # Kept so stream_events() can ask the tools to report their calls
+        self._tools = tuple(tools) if tools else ()
 
         if _ptr is not None:
             # Internal constructor for specific ptr
+            self.transcript = Transcript(_ptr)
             super().__init__(_ptr)
         else:
             # Create model pointer
@@ -168,6 +222,71 @@ class LanguageModelSession(_ManagedObject):
             super().__init__(ptr)
         # This opaque pointer already has 1 ref count by `passRetained`
 
+    @classmethod
+    def from_transcript(
+        cls,
+        transcript: Union[dict, str, bytes],
+        *,
+        model: Optional[SystemLanguageModel] = None,
+        tools: Optional[list[Tool]] = None,
+    ) -> "LanguageModelSession":
+        """Create a session that continues from a saved transcript.
+
+        The new session starts with every entry of ``transcript``, including
+        its instructions, so the model sees the earlier conversation on the
+        next request.
+
+        :param transcript: A transcript as returned by
+            :meth:`Transcript.to_dict`, or the same data as JSON
+        :type transcript: Union[dict, str, bytes]
+        :param model: Optional model configuration, as for the constructor
+        :type model: Optional[SystemLanguageModel]
+        :param tools: The tools the session can call. Pass the tools named in
+            the transcript for the model to keep using them.
+        :type tools: Optional[list[Tool]]
+        :return: The restored session
+        :rtype: LanguageModelSession
+        :raises DecodingFailureError: If the transcript cannot be decoded
+
+        Example:
+            ::
+
+                import apple_fm_sdk as fm
+
+                saved = await session.transcript.to_dict()
+                del session
+
+                session = fm.LanguageModelSession.from_transcript(saved)
+                await session.respond("What did I ask you earlier?")
+        """
+        if isinstance(transcript, dict):
+            transcript = json.dumps(transcript)
+
+        tool_count = len(tools) if tools else 0
+        tool_refs = (ctypes.c_void_p * tool_count)()
+        for i, tool in enumerate(tools or ()):
+            tool_refs[i] = tool._ptr
+
+        error_code = ctypes.c_int32()
+        error_description = ctypes.POINTER(ctypes.c_char)()
+        with _borrowed_bytes(transcript) as (data, length):
+            ptr = lib.FMLanguageModelSessionCreateFromTranscriptJSON(
+                model._ptr if model else None,
+                data,
+                length,
+                tool_refs,
+                tool_count,
+                ctypes.byref(error_code),
+                ctypes.byref(error_description),
+            )
+        if not ptr:
+            err_code, err_desc = _get_error_string(error_code, error_description)
+            error_msg = "Failed to restore session from transcript"
+            if err_desc:
+                error_msg = error_msg + ": " + err_desc
+            raise _status_code_to_exception(err_code or error_code.value, error_msg)
+        return cls(model=model, tools=tools, _ptr=ptr)
+
     @property
     def is_responding(self) -> bool:
         """Check if the session is currently responding to a request.
@@ -207,11 +326,13 @@ class LanguageModelSession(_ManagedObject):
     ) -> GeneratedContent: ...
 
     @overload  # This overload helps the type checker understand the return type
-    async def respond(self, prompt: str, *, json_schema: dict) -> GeneratedContent: ...
+    async def respond(
+        self, prompt: Prompt, *, json_schema: dict
+    ) -> GeneratedContent: ...
 
     async def respond(
         self,
-        prompt: str,
+        prompt: Prompt,
         generating: Optional[Union[Type[Generable], Generable]] = None,
         *,
         schema: Optional[GenerationSchema] = None,
@@ -229,8 +350,11 @@ class LanguageModelSession(_ManagedObject):
         The session automatically updates its transcript after each response, maintaining
         the full session history.
 
-        :param prompt: The input prompt string to send to the model
-        :type prompt: str
+        :param prompt: The input prompt to send to the model. Either a string, or any
+            buffer-protocol object (``bytes``, ``bytearray``, ``memoryview``, ``mmap``)
+            containing UTF-8 text. Bytes-like prompts are passed to the model without
+            re-encoding or copying on the Python side, and may contain NUL bytes.
+        :type prompt: Union[str, bytes, bytearray, memoryview]
         :param generating: Optional Generable type or instance for type-safe guided generation.
             When provided, the response will be constrained to match the structure of
             the Generable type and automatically converted to an instance of that type.
@@ -292,6 +416,17 @@ class LanguageModelSession(_ManagedObject):
                 )
                 print(response2)
 
+            Prompting with a memory-mapped document::
+
+                import mmap
+                import apple_fm_sdk as fm
+
+                session = fm.LanguageModelSession()
+                with open("report.txt", "rb") as f:
+                    with mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ) as mm:
+                        # Slice through a memoryview; slicing the mmap directly copies
+                        response = await session.respond(memoryview(mm)[:4096])
+
         Note:
             - Only one of ``generating``, ``schema``, or ``json_schema`` can be specified
             - The session maintains session context across multiple ``respond()`` calls
@@ -334,7 +469,145 @@ class LanguageModelSession(_ManagedObject):
         # Handle basic text response
         return await self._respond_basic(prompt)
 
-    async def _respond_basic(self, prompt: str) -> str:
+    async def respond_many(self, prompts: Sequence[Turn]) -> List[Any]:
+        """Get responses to several prompts, run back-to-back as consecutive turns.
+
+        All turns are handed to the native layer at once and run one after the
+        other in a single native task, so there is no round trip through Python
+        between turns. Each turn sees the previous turns in the session context,
+        exactly as with successive :meth:`respond` calls.
+
+        :param prompts: The turns to run, in order. Each item is a prompt, or a
+            ``(prompt, generating)`` pair where ``generating`` is a ``@generable``
+            type or a :class:`~apple_fm_sdk.generation_schema.GenerationSchema`.
+        :type prompts: Sequence[Union[Prompt, Tuple[Prompt, Union[Type[Generable], GenerationSchema]]]]
+        :return: One result per turn: a string for plain prompts, an instance of
+            the ``@generable`` type, or ``GeneratedContent`` for a schema
+        :rtype: List[Any]
+        :raises FoundationModelsError: If a turn fails. Turns after the failing
+            one are not run; earlier turns remain in the transcript.
+        :raises ValueError: If a ``generating`` type is not a valid Generable
+        :raises asyncio.CancelledError: If the request is cancelled
+
+        Example:
+            ::
+
+                import apple_fm_sdk as fm
+
+                @fm.generable()
+                class Verdict:
+                    correct: bool
+
+                session = fm.LanguageModelSession()
+                answer, follow_up, verdict = await session.respond_many([
+                    "What is 17 * 23?",
+                    "Explain how you got that.",
+                    ("Is your first answer correct?", Verdict),
+                ])
+
+        Note:
+            Concurrent requests on the same session are serialized, so no other
+            request can interleave with the turns of a ``respond_many`` call.
+        """
+        prompt_list: List[Prompt] = []
+        generating_list: List[Any] = []
+        for turn in prompts:
+            if isinstance(turn, tuple):
+                prompt, generating = turn
+                if not isinstance(generating, GenerationSchema) and not isinstance(
+                    generating, Generable
+                ):
+                    raise ValueError(
+                        f"{getattr(generating, '__name__', generating)} is not a "
+                        "Generable type. Use @generable decorator."
+                    )
+            else:
+                prompt, generating = turn, None
+            prompt_list.append(prompt)
+            generating_list.append(generating)
+
+        count = len(prompt_list)
+        if count == 0:
+            return []
+
+        # Keep the schemas alive until the native task has finished with them
+        schemas = [
+            None
+            if generating is None
+            else generating
+            if isinstance(generating, GenerationSchema)
+            else generating.generation_schema()
+            for generating in generating_list
+        ]
+
+        async with self._request_lock, _scheduled():
+            loop = asyncio.get_running_loop()
+            future = loop.create_future()
+            batch = _TurnBatch(future, count)
+            batch_handle = _register_handle(batch)
+
+            prompt_ptrs = (ctypes.POINTER(ctypes.c_char) * count)()
+            prompt_lengths = (ctypes.c_size_t * count)()
+            schema_ptrs = (ctypes.c_void_p * count)()
+            with contextlib.ExitStack() as stack:
+                for i, prompt in enumerate(prompt_list):
+                    prompt_ptrs[i], prompt_lengths[i] = stack.enter_context(
+                        _borrowed_bytes(prompt)
+                    )
+                    if schemas[i] is not None:
+                        schema_ptrs[i] = schemas[i]._ptr
+                task = lib.FMLanguageModelSessionEnqueue(
+                    self._ptr,
+                    prompt_ptrs,
+                    prompt_lengths,
+                    schema_ptrs,
+                    count,
+                    batch_handle,
+                    _session_turn_callback,
+                )
+
+            # Store active task reference
+            self._active_task = task
+
+            try:
+                results = [_adopt_into_scope(result) for result in await future]
+            except asyncio.CancelledError as e:
+                # Cancel the native task
+                lib.FMTaskCancel(task)
+                future.cancel()
+
+                # Wait for the task to actually complete cancellation
+                # Poll is_responding until it becomes False, with timeout
+                max_wait_time = 1.0  # Maximum 1 second wait
+                poll_interval = 0.01  # Poll every 10ms
+                elapsed = 0.0
+
+                while self.is_responding and elapsed < max_wait_time:
+                    await asyncio.sleep(poll_interval)
+                    elapsed += poll_interval
+
+                # Reset task state to ensure the session is ready for new requests
+                self._reset_task_state()
+
+                raise e
+            except Exception as e:
+                # On any error, reset task state to ensure clean state
+                self._reset_task_state()
+                raise e
+            finally:
+                # Clean up handle to prevent memory leaks
+                _unregister_handle(batch_handle)
+                lib.FMRelease(task)
+                self._active_task = None
+
+        return [
+            generating._from_generated_content(result)
+            if generating is not None and not isinstance(generating, GenerationSchema)
+            else result
+            for generating, result in zip(generating_list, results)
+        ]
+
+    async def _respond_basic(self, prompt: Prompt) -> str:
         """Get a complete basic text response to a prompt.
 
         Args:
@@ -348,18 +621,17 @@ class LanguageModelSession(_ManagedObject):
             FoundationModelsError: For other errors like timeout
             ConcurrentRequestsError: If another request is already in progress
         """
-        # Acquire lock to prevent concurrent requests
-        async with self._request_lock:
+        # Acquire lock to prevent concurrent requests, then wait for the scheduler
+        async with self._request_lock, _scheduled():
             loop = asyncio.get_running_loop()
             future = loop.create_future()
 
-            prompt_bytes = prompt.encode("utf-8")
-
             future_handle = _register_handle(future)
 
-            task = lib.FMLanguageModelSessionRespond(
-                self._ptr, prompt_bytes, future_handle, _session_callback
-            )
+            with _borrowed_bytes(prompt) as (prompt_ptr, prompt_length):
+                task = lib.FMLanguageModelSessionRespondBytes(
+                    self._ptr, prompt_ptr, prompt_length, future_handle, _session_callback
+                )
 
             # Store active task reference
             self._active_task = task
@@ -394,26 +666,26 @@ class LanguageModelSession(_ManagedObject):
             return future.result()
 
     async def _respond_with_schema(
-        self, prompt: str, schema: GenerationSchema
+        self, prompt: Prompt, schema: GenerationSchema
     ) -> GeneratedContent:
         """Internal method for guided generation using a GenerationSchema."""
-        # Acquire lock to prevent concurrent requests
-        async with self._request_lock:
+        # Acquire lock to prevent concurrent requests, then wait for the scheduler
+        async with self._request_lock, _scheduled():
             loop = asyncio.get_running_loop()
             future = loop.create_future()
 
-            prompt_bytes = prompt.encode("utf-8")
-
             future_handle = _register_handle(future)
 
             # Always use the proper C binding for guided generation
-            task = lib.FMLanguageModelSessionRespondWithSchema(
-                self._ptr,
-                prompt_bytes,
-                schema._ptr,
-                future_handle,
-                _session_structured_callback,
-            )
+            with _borrowed_bytes(prompt) as (prompt_ptr, prompt_length):
+                task = lib.FMLanguageModelSessionRespondBytesWithSchema(
+                    self._ptr,
+                    prompt_ptr,
+                    prompt_length,
+                    schema._ptr,
+                    future_handle,
+                    _session_structured_callback,
+                )
 
             # Store active task reference
             self._active_task = task
@@ -449,30 +721,31 @@ class LanguageModelSession(_ManagedObject):
                 lib.FMRelease(task)
                 self._active_task = None
 
-            return future.result()
+            return _adopt_into_scope(future.result())
 
     async def _respond_with_schema_from_json(
-        self, prompt: str, json_schema: dict
+        self, prompt: Prompt, json_schema: dict
     ) -> GeneratedContent:
         """Internal method for guided generation using a JSON schema string."""
-        # Acquire lock to prevent concurrent requests
-        async with self._request_lock:
+        # Acquire lock to prevent concurrent requests, then wait for the scheduler
+        async with self._request_lock, _scheduled():
             loop = asyncio.get_running_loop()
             future = loop.create_future()
 
-            prompt_bytes = prompt.encode("utf-8")
             json_schema_bytes = json.dumps(json_schema).encode("utf-8")
 
             future_handle = _register_handle(future)
 
             # Use the C binding for guided generation with JSON schema
-            task = lib.FMLanguageModelSessionRespondWithSchemaFromJSON(
-                self._ptr,
-                prompt_bytes,
-                json_schema_bytes,
-                future_handle,
-                _session_structured_callback,
-            )
+            with _borrowed_bytes(prompt) as (prompt_ptr, prompt_length):
+                task = lib.FMLanguageModelSessionRespondBytesWithSchemaFromJSON(
+                    self._ptr,
+                    prompt_ptr,
+                    prompt_length,
+                    json_schema_bytes,
+                    future_handle,
+                    _session_structured_callback,
+                )
 
             # Store active task reference
             self._active_task = task
@@ -508,9 +781,15 @@ class LanguageModelSession(_ManagedObject):
                 lib.FMRelease(task)
                 self._active_task = None
 
-            return future.result()
+            return _adopt_into_scope(future.result())
 
-    async def stream_response(self, prompt: Prompt) -> AsyncIterator:
+    async def stream_response(
+        self,
+        prompt: Prompt,
+        *,
+        stop: Optional[Sequence[str]] = None,
+        until: Optional[Callable[[str], bool]] = None,
+    ) -> AsyncIterator:
         """Stream response chunks for a prompt (text only).
 
         This function provides real-time streaming of the model's response, yielding text
@@ -524,9 +803,19 @@ class LanguageModelSession(_ManagedObject):
         - Automatically updates the session transcript after completion
         - Does not support guided generation (text responses only)
         - Can be cancelled mid-stream using asyncio cancellation
-
-        :param prompt: The input prompt string to send to the model
-        :type prompt: str
+        - Can stop early at a stop sequence or when a predicate is satisfied
+
+        :param prompt: The input prompt to send to the model, as a string or a
+            bytes-like object containing UTF-8 text (see :meth:`respond`)
+        :type prompt: Union[str, bytes, bytearray, memoryview]
+        :param stop: Stop sequences. Generation stops at the first occurrence of
+            any of them, and the last snapshot is the text before it. Matching
+            happens in the native stream loop, including sequences that span
+            two snapshots.
+        :type stop: Optional[Sequence[str]]
+        :param until: Called with each snapshot. When it returns True, that
+            snapshot is the last one yielded and generation is cancelled.
+        :type until: Optional[Callable[[str], bool]]
         :yields: Progressive snapshots of the response text. Each snapshot contains
             the full text generated so far, rather than only the new tokens.
         :ytype: str
@@ -575,25 +864,236 @@ class LanguageModelSession(_ManagedObject):
                 except fm.FoundationModelsError as e:
                     print(f"Streaming error: {e}")
 
+            Stopping early::
+
+                import apple_fm_sdk as fm
+
+                session = fm.LanguageModelSession()
+
+                # Only the first line
+                async for line in session.stream_response("List five fruits", stop=["\\n"]):
+                    pass
+
+                # Stop once the JSON object is closed
+                async for text in session.stream_response(
+                    "Describe a cat as JSON", until=lambda text: text.rstrip().endswith("}")
+                ):
+                    pass
+
         Note:
             - Streaming currently only supports basic text responses
             - For guided generation, use :meth:`respond` instead
             - Each snapshot contains the full text, rather than only new tokens
             - The session transcript is updated only after streaming completes
             - Breaking out of the async for loop early will properly clean up resources
+            - A stream ended by ``stop`` or ``until`` does not raise; the text
+              after the stop point is never generated
 
         See Also:
             - :meth:`respond`: For non-streaming responses with guided generation support
         """
-        # Handle basic text streaming only
-        async for chunk in self._stream_response_basic(prompt):
-            yield chunk
+        # Handle basic text streaming only; the stream holds its scheduler slot until it ends
+        async with _scheduled():
+            async for chunk in self._stream_response_basic(prompt, stop=stop, until=until):
+                yield chunk
+
+    def broadcast_response(
+        self, prompt: Prompt, *, stop: Optional[Sequence[str]] = None
+    ) -> BroadcastStream:
+        """Start streaming a response that any number of subscribers can follow.
+
+        The response is generated once, by a single native stream iteration,
+        and every :class:`~apple_fm_sdk.broadcast.StreamSubscription` receives
+        its snapshots. A subscriber that joins late starts at the latest
+        snapshot, and a slow subscriber skips ahead to the latest snapshot
+        rather than holding up the others.
+
+        Must be called from a running event loop. Generation starts
+        immediately, or once the installed
+        :class:`~apple_fm_sdk.FairScheduler` admits the request. In the latter
+        case, errors creating the stream are raised by
+        :meth:`~apple_fm_sdk.BroadcastStream.result` and by subscribers.
+
+        :param prompt: The input prompt to send to the model, as a string or a
+            bytes-like object containing UTF-8 text (see :meth:`respond`)
+        :type prompt: Union[str, bytes, bytearray, memoryview]
+        :param stop: Stop sequences, as for :meth:`stream_response`
+        :type stop: Optional[Sequence[str]]
+        :return: The broadcast stream
+        :rtype: BroadcastStream
+        :raises FoundationModelsError: If the stream cannot be created
+
+        Example:
+            ::
+
+                import asyncio
+                import apple_fm_sdk as fm
+
+                session = fm.LanguageModelSession()
+
+                async with session.broadcast_response("Draft a welcome email") as broadcast:
+                    await asyncio.gather(
+                        send_to_clients(broadcast.subscribe()),
+                        moderate(broadcast.subscribe()),
+                    )
+                    email = await broadcast.result()
+
+        Note:
+            - The session transcript is updated when the response completes
+            - Closing the broadcast stream stops the generation for every
+              subscriber
+        """
+        broadcast = BroadcastStream(asyncio.get_running_loop())
+        scheduler = get_scheduler()
+        if scheduler is None or _is_admitted():
+            self._start_broadcast(broadcast, prompt, stop)
+            return broadcast
+
+        async def _admit():
+            admitted = await scheduler._acquire(_current_tenant.get())
+            broadcast._release = lambda: scheduler._release(*admitted)
+            if broadcast.done:
+                # Closed while waiting for the scheduler
+                broadcast._release()
+                return
+            try:
+                self._start_broadcast(broadcast, prompt, stop)
+            except Exception as e:
+                broadcast._finish(e)
+
+        broadcast._admission = broadcast.loop.create_task(_admit())
+        return broadcast
+
+    def _start_broadcast(
+        self,
+        broadcast: BroadcastStream,
+        prompt: Prompt,
+        stop: Optional[Sequence[str]],
+    ):
+        """Create the native stream of a broadcast and start iterating it."""
+        with _borrowed_bytes(prompt) as (prompt_ptr, prompt_length):
+            stream_ptr = lib.FMLanguageModelSessionStreamResponseBytes(
+                self._ptr, prompt_ptr, prompt_length
+            )
+        if not stream_ptr:
+            raise FoundationModelsError("Failed to create response stream")
+        if stop:
+            _set_stop_sequences(stream_ptr, stop)
+
+        handle = _register_handle(broadcast)
+        broadcast._attach(stream_ptr, handle)
+        lib.FMLanguageModelSessionResponseStreamIterate(
+            stream_ptr, handle, _session_broadcast_callback
+        )
+
+    async def stream_events(
+        self, prompt: Prompt, *, stop: Optional[Sequence[str]] = None
+    ) -> AsyncIterator[StreamEvent]:
+        """Stream a response as typed events (text only).
+
+        Where :meth:`stream_response` yields snapshots of the text, this method
+        reports everything that happens while the response is generated:
+
+        - :class:`~apple_fm_sdk.TextDelta`: text generated since the previous event
+        - :class:`~apple_fm_sdk.ToolCallStarted`: the model invoked one of the
+          session's tools, with the arguments it generated
+        - :class:`~apple_fm_sdk.ToolCallFinished`: a tool call returned, with its
+          duration and outcome
+        - :class:`~apple_fm_sdk.Completed`: always the last event, with the full
+          text and :class:`~apple_fm_sdk.StreamMetrics`
+
+        Events are produced by the native layer, including tool events, which are
+        reported by the bridged tool itself when the call is dispatched and when
+        its result is recorded.
+
+        :param prompt: The input prompt to send to the model, as a string or a
+            bytes-like object containing UTF-8 text (see :meth:`respond`)
+        :type prompt: Union[str, bytes, bytearray, memoryview]
+        :param stop: Stop sequences, as for :meth:`stream_response`. A stream
+            that stops at one ends with a :class:`~apple_fm_sdk.Completed`
+            event whose ``stopped`` is True.
+        :type stop: Optional[Sequence[str]]
+        :yields: Stream events, in the order they happened
+        :ytype: StreamEvent
+        :raises FoundationModelsError: If streaming fails or encounters an error
+        :raises asyncio.CancelledError: If the stream is cancelled
+
+        Example:
+            ::
+
+                import apple_fm_sdk as fm
+
+                session = fm.LanguageModelSession(tools=[WeatherTool()])
+
+                async for event in session.stream_events("Weather in Paris?"):
+                    if isinstance(event, fm.TextDelta):
+                        print(event.text, end="", flush=True)
+                    elif isinstance(event, fm.ToolCallStarted):
+                        print(f"[calling {event.name}({event.arguments})]")
+                    elif isinstance(event, fm.Completed):
+                        print(f"\n{event.metrics.duration:.2f} s")
+
+        Note:
+            - A :class:`~apple_fm_sdk.TextDelta` with ``replaces=True`` carries the
+              whole response so far, because the model revised earlier text
+            - A tool instance shared with another session that is streaming events
+              at the same time reports its calls to both streams
+        """
+        async with _scheduled():
+            loop = asyncio.get_running_loop()
+            channel = _StreamEventChannel(loop)
+            channel_handle = _register_handle(channel)
+            stream_ptr = None
+            try:
+                with _borrowed_bytes(prompt) as (prompt_ptr, prompt_length):
+                    stream_ptr = lib.FMLanguageModelSessionStreamResponseBytes(
+                        self._ptr, prompt_ptr, prompt_length
+                    )
+                if not stream_ptr:
+                    raise FoundationModelsError("Failed to create response stream")
+                if stop:
+                    _set_stop_sequences(stream_ptr, stop)
+
+                tool_count = len(self._tools)
+                tool_refs = (ctypes.c_void_p * tool_count)(
+                    *(tool._ptr for tool in self._tools)
+                )
+                lib.FMLanguageModelSessionResponseStreamIterateEvents(
+                    stream_ptr,
+                    tool_refs,
+                    tool_count,
+                    channel_handle,
+                    _session_stream_event_callback,
+                )
 
-    async def _stream_response_basic(self, prompt: Prompt) -> AsyncIterator[str]:
+                while True:
+                    status, event_type, payload = await channel.queue.get()
+                    if status != GenerationErrorCode.SUCCESS:
+                        raise _status_code_to_exception(
+                            status, debug_description=payload
+                        )
+                    event = _event_from_native(event_type, payload)
+                    yield event
+                    if isinstance(event, Completed):
+                        break
+            finally:
+                _unregister_handle(channel_handle)
+                # Releasing the stream cancels the native iteration if it is still running
+                if stream_ptr:
+                    lib.FMRelease(stream_ptr)
+
+    async def _stream_response_basic(
+        self,
+        prompt: Prompt,
+        stop: Optional[Sequence[str]] = None,
+        until: Optional[Callable[[str], bool]] = None,
+    ) -> AsyncIterator[str]:
         """Stream basic text response chunks for a prompt.
 
         Args:
             prompt: The input prompt
+            stop: Stop sequences matched by the native stream loop
+            until: Predicate that ends the stream when it returns True
 
         Yields:
             Response text snapshots as they become available
@@ -603,28 +1103,32 @@ class LanguageModelSession(_ManagedObject):
         stream_ptr_holder = [None]  # Use list to allow modification in nested function
 
         def _start_stream():
-            prompt_bytes = prompt.encode("utf-8")
-            stream_ptr = lib.FMLanguageModelSessionStreamResponse(
-                self._ptr, prompt_bytes
-            )
+            try:
+                with _borrowed_bytes(prompt) as (prompt_ptr, prompt_length):
+                    stream_ptr = lib.FMLanguageModelSessionStreamResponseBytes(
+                        self._ptr, prompt_ptr, prompt_length
+                    )
+            except TypeError as e:
+                # Unsupported prompt type, surfaced to the consumer as-is
+                callback._finish(e)
+                return
             stream_ptr_holder[0] = stream_ptr  # Store for cleanup
 
             if not stream_ptr:
-                callback.error = FoundationModelsError(
-                    "Failed to create response stream"
+                callback._finish(
+                    FoundationModelsError("Failed to create response stream")
                 )
-                callback.queue.put(None)
-                callback.completed.set()
                 return
 
+            if stop:
+                _set_stop_sequences(stream_ptr, stop)
+
             try:
                 lib.FMLanguageModelSessionResponseStreamIterate(
                     stream_ptr, None, callback._callback
                 )
             except Exception as e:
-                callback.error = FoundationModelsError(f"Stream iteration error: {e}")
-                callback.queue.put(None)
-                callback.completed.set()
+                callback._finish(FoundationModelsError(f"Stream iteration error: {e}"))
 
         try:
             # Start streaming in a separate thread
@@ -640,6 +1144,16 @@ class LanguageModelSession(_ManagedObject):
                     if snapshot is None:  # End signal
                         break
                     yield snapshot
+                    if until is not None and until(snapshot):
+                        # The cancellation error reported by the native
+                        # iteration is expected, so it is not raised
+                        lib.FMLanguageModelSessionResponseStreamCancel(
+                            stream_ptr_holder[0]
+                        )
+                        # Generation has stopped, and the session can take the
+                        # next request, once the native iteration has ended
+                        await asyncio.to_thread(callback.completed.wait, _STOP_TIMEOUT)
+                        return
                 except queue.Empty:
                     # Check if we're done or have an error
                     if callback.completed.is_set():
@@ -650,6 +1164,8 @@ class LanguageModelSession(_ManagedObject):
                                 if snapshot is None:
                                     break
                                 yield snapshot
+                                if until is not None and until(snapshot):
+                                    return
                         except queue.Empty:
                             pass
                         break
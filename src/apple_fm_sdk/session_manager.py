@@ -0,0 +1,414 @@
+# For licensing see accompanying LICENSE file.
+# Copyright (C) 2026 Apple Inc. All Rights Reserved.
+
+"""
+Lifecycle management for many long-running conversations.
+
+A server that maps conversation ids to sessions cannot keep every session
+alive: each one holds native model state for as long as it exists. A
+:class:`SessionManager` keeps a bounded set of live sessions and evicts the
+rest. Evicting a session saves its transcript to a store and releases the
+native session. Asking for that conversation again restores the session from
+the saved transcript, so callers never see the difference.
+
+Sessions are evicted when:
+
+* More than ``max_sessions`` are live (least recently used first)
+* A session has not been used for ``idle_timeout`` seconds
+* A session was created or restored more than ``max_age`` seconds ago
+
+The main components are:
+
+* :class:`SessionManager` - Maps conversation ids to live sessions
+* :class:`TranscriptStore` - Where evicted transcripts are saved
+* :class:`InMemoryTranscriptStore` - A store that keeps transcripts in a dict
+* :class:`SessionManagerStats` - Counters of a manager
+
+A :class:`~apple_fm_sdk.transcript_archive.TranscriptArchive` opened for
+appending can be used as the store to keep evicted transcripts on disk.
+
+Example:
+    ::
+
+        import apple_fm_sdk as fm
+
+        manager = fm.SessionManager(
+            instructions="You are a helpful support agent.",
+            max_sessions=200,
+            idle_timeout=600,
+        )
+
+        async with manager:
+            async with manager.session(conversation_id) as session:
+                reply = await session.respond(message)
+"""
+
+import asyncio
+import contextlib
+import time
+from collections import OrderedDict
+from dataclasses import dataclass
+from typing import (
+    Any,
+    AsyncIterator,
+    Dict,
+    List,
+    Optional,
+    Protocol,
+    runtime_checkable,
+)
+
+from .c_helpers import _drain_releases
+from .core import SystemLanguageModel
+from .session import LanguageModelSession
+from .tool import Tool
+
+
+@runtime_checkable
+class TranscriptStore(Protocol):
+    """Where a :class:`SessionManager` saves the transcripts of evicted sessions.
+
+    :class:`~apple_fm_sdk.transcript_archive.TranscriptArchive` implements
+    this protocol.
+    """
+
+    def add(self, session_id: str, transcript: Dict[str, Any]) -> Any:
+        """Save ``transcript`` under ``session_id``, replacing any earlier one."""
+        ...
+
+    def get(self, session_id: str) -> Dict[str, Any]:
+        """Return the transcript saved under ``session_id``, or raise KeyError."""
+        ...
+
+    def __contains__(self, session_id: object) -> bool: ...
+
+
+class InMemoryTranscriptStore:
+    """A :class:`TranscriptStore` that keeps transcripts in a dictionary.
+
+    Saved transcripts are lost when the process exits.
+    """
+
+    def __init__(self):
+        self._transcripts: Dict[str, Dict[str, Any]] = {}
+
+    def add(self, session_id: str, transcript: Dict[str, Any]) -> None:
+        self._transcripts[session_id] = transcript
+
+    def get(self, session_id: str) -> Dict[str, Any]:
+        return self._transcripts[session_id]
+
+    def __contains__(self, session_id: object) -> bool:
+        return session_id in self._transcripts
+
+    def __len__(self) -> int:
+        return len(self._transcripts)
+
+
+@dataclass
+class SessionManagerStats:
+    """Counters of a :class:`SessionManager`.
+
+    :ivar live: Number of sessions currently live
+    :vartype live: int
+    :ivar created: Number of sessions started for new conversations
+    :vartype created: int
+    :ivar restored: Number of sessions restored from a saved transcript
+    :vartype restored: int
+    :ivar evicted: Number of sessions evicted
+    :vartype evicted: int
+    """
+
+    live: int = 0
+    created: int = 0
+    restored: int = 0
+    evicted: int = 0
+
+
+class _Entry:
+    __slots__ = ("session", "created", "last_used", "leases")
+
+    def __init__(self, session: LanguageModelSession, now: float):
+        self.session = session
+        self.created = now
+        self.last_used = now
+        self.leases = 0
+
+
+class SessionManager:
+    """Keeps a bounded set of live sessions for many conversations.
+
+    Sessions that are in use, either inside :meth:`session` or while
+    responding, are never evicted. Limits are enforced when a session is
+    requested and, inside ``async with manager``, by a background sweep every
+    ``sweep_interval`` seconds.
+
+    :param instructions: Instructions for new conversations
+    :type instructions: Optional[str]
+    :param model: Model for every session. Defaults to the system model.
+    :type model: Optional[SystemLanguageModel]
+    :param tools: Tools for every session. The same tool instances are shared
+        by all sessions, so tools must not keep per-conversation state.
+    :type tools: Optional[list[Tool]]
+    :param max_sessions: Maximum number of live sessions. Unlimited if None.
+    :type max_sessions: Optional[int]
+    :param idle_timeout: Seconds without use after which a session is evicted
+    :type idle_timeout: Optional[float]
+    :param max_age: Seconds after creation or restoration after which a
+        session is evicted
+    :type max_age: Optional[float]
+    :param store: Where evicted transcripts are saved. Defaults to an
+        :class:`InMemoryTranscriptStore`.
+    :type store: Optional[TranscriptStore]
+    :param sweep_interval: Seconds between background sweeps. Defaults to a
+        quarter of the shortest of ``idle_timeout`` and ``max_age``.
+    :type sweep_interval: Optional[float]
+    :raises ValueError: If a limit is not positive
+
+    Example:
+        Keeping evicted transcripts on disk::
+
+            import apple_fm_sdk as fm
+
+            with fm.TranscriptArchive("conversations.fmta", "a") as archive:
+                manager = fm.SessionManager(store=archive, max_sessions=500, max_age=3600)
+                async with manager:
+                    await serve(manager)
+
+    Note:
+        - Session ids must be strings
+        - Sessions returned by :meth:`get` can be evicted as soon as they are
+          idle. Keep using the returned object if needed; the conversation
+          continues on a restored session the next time it is requested.
+    """
+
+    def __init__(
+        self,
+        *,
+        instructions: Optional[str] = None,
+        model: Optional[SystemLanguageModel] = None,
+        tools: Optional[List[Tool]] = None,
+        max_sessions: Optional[int] = None,
+        idle_timeout: Optional[float] = None,
+        max_age: Optional[float] = None,
+        store: Optional[TranscriptStore] = None,
+        sweep_interval: Optional[float] = None,
+    ):
+        for name, value in (
+            ("max_sessions", max_sessions),
+            ("idle_timeout", idle_timeout),
+            ("max_age", max_age),
+            ("sweep_interval", sweep_interval),
+        ):
+            if value is not None and value <= 0:
+                raise ValueError(f"{name} must be positive")
+
+        self.instructions = instructions
+        self.model = model
+        self.tools = list(tools) if tools else None
+        self.max_sessions = max_sessions
+        self.idle_timeout = idle_timeout
+        self.max_age = max_age
+        self.store: TranscriptStore = store if store is not None else InMemoryTranscriptStore()
+        if sweep_interval is None:
+            limits = [limit for limit in (idle_timeout, max_age) if limit is not None]
+            sweep_interval = min(limits) / 4 if limits else None
+        self.sweep_interval = sweep_interval
+
+        # Least recently used first
+        self._live: "OrderedDict[str, _Entry]" = OrderedDict()
+        self._lock = asyncio.Lock()
+        self._sweeper: Optional[asyncio.Task] = None
+        self._stats = SessionManagerStats()
+
+    def __len__(self) -> int:
+        return len(self._live)
+
+    def __contains__(self, session_id: object) -> bool:
+        return session_id in self._live
+
+    async def __aenter__(self) -> "SessionManager":
+        if self.sweep_interval is not None and self._sweeper is None:
+            self._sweeper = asyncio.ensure_future(self._sweep_forever())
+        return self
+
+    async def __aexit__(self, exc_type, exc, tb):
+        await self.close()
+
+    def stats(self) -> SessionManagerStats:
+        """Get a snapshot of the manager's counters.
+
+        :return: The counters
+        :rtype: SessionManagerStats
+        """
+        return SessionManagerStats(
+            live=len(self._live),
+            created=self._stats.created,
+            restored=self._stats.restored,
+            evicted=self._stats.evicted,
+        )
+
+    async def get(self, session_id: str) -> LanguageModelSession:
+        """Get the session for a conversation.
+
+        Returns the live session if there is one. Otherwise the session is
+        restored from the store, or a new session is started if the
+        conversation has never been seen.
+
+        :param session_id: The conversation id
+        :type session_id: str
+        :return: The session
+        :rtype: LanguageModelSession
+        :raises FoundationModelsError: If the saved transcript cannot be restored
+        """
+        async with self._lock:
+            return (await self._checkout(session_id)).session
+
+    @contextlib.asynccontextmanager
+    async def session(self, session_id: str) -> AsyncIterator[LanguageModelSession]:
+        """Use the session for a conversation, keeping it live until the block exits.
+
+        :param session_id: The conversation id
+        :type session_id: str
+        :return: An async context manager that yields the session
+        :raises FoundationModelsError: If the saved transcript cannot be restored
+
+        Example:
+            ::
+
+                async with manager.session("conversation-42") as session:
+                    reply = await session.respond("And what about tomorrow?")
+        """
+        async with self._lock:
+            entry = await self._checkout(session_id)
+            entry.leases += 1
+        try:
+            yield entry.session
+        finally:
+            entry.leases -= 1
+            entry.last_used = time.monotonic()
+
+    async def evict(self, session_id: str) -> bool:
+        """Save a conversation's transcript and release its live session.
+
+        :param session_id: The conversation id
+        :type session_id: str
+        :return: True if the session was evicted, False if it was not live
+        :rtype: bool
+        :raises RuntimeError: If the session is in use
+        """
+        async with self._lock:
+            entry = self._live.get(session_id)
+            if entry is None:
+                return False
+            if self._busy(entry):
+                raise RuntimeError(f"Session {session_id!r} is in use")
+            await self._evict(session_id, entry)
+        _drain_releases()
+        return True
+
+    async def sweep(self) -> int:
+        """Evict sessions past their idle timeout or maximum age, and any
+        above ``max_sessions``.
+
+        :return: Number of sessions evicted
+        :rtype: int
+        """
+        async with self._lock:
+            evicted = await self._enforce_limits()
+        if evicted:
+            _drain_releases()
+        return evicted
+
+    async def close(self):
+        """Stop the background sweep and evict every live session.
+
+        Sessions still in use are left live.
+        """
+        if self._sweeper is not None:
+            self._sweeper.cancel()
+            await asyncio.gather(self._sweeper, return_exceptions=True)
+            self._sweeper = None
+        async with self._lock:
+            for session_id, entry in list(self._live.items()):
+                if not self._busy(entry):
+                    await self._evict(session_id, entry)
+        _drain_releases()
+
+    @staticmethod
+    def _busy(entry: _Entry) -> bool:
+        return entry.leases > 0 or entry.session.is_responding
+
+    async def _checkout(self, session_id: str) -> _Entry:
+        if not isinstance(session_id, str):
+            raise ValueError("session_id must be a string")
+        now = time.monotonic()
+        entry = self._live.get(session_id)
+        if (
+            entry is not None
+            and self.max_age is not None
+            and now - entry.created >= self.max_age
+            and not self._busy(entry)
+        ):
+            # Continue the conversation on a fresh native session
+            await self._evict(session_id, entry)
+            entry = None
+        if entry is None:
+            entry = _Entry(self._open(session_id), now)
+            self._live[session_id] = entry
+        else:
+            self._live.move_to_end(session_id)
+            entry.last_used = now
+        # The requested session is most recently used, so it is never the
+        # one evicted to make room
+        await self._enforce_limits(keep=session_id)
+        return entry
+
+    def _open(self, session_id: str) -> LanguageModelSession:
+        if session_id in self.store:
+            session = LanguageModelSession.from_transcript(
+                self.store.get(session_id), model=self.model, tools=self.tools
+            )
+            self._stats.restored += 1
+        else:
+            session = LanguageModelSession(
+                instructions=self.instructions, model=self.model, tools=self.tools
+            )
+            self._stats.created += 1
+        return session
+
+    async def _evict(self, session_id: str, entry: _Entry):
+        transcript = await entry.session.transcript.to_dict()
+        self.store.add(session_id, transcript)
+        del self._live[session_id]
+        self._stats.evicted += 1
+
+    async def _enforce_limits(self, keep: Optional[str] = None) -> int:
+        now = time.monotonic()
+        expired = [
+            session_id
+            for session_id, entry in self._live.items()
+            if session_id != keep
+            and not self._busy(entry)
+            and (
+                (self.idle_timeout is not None and now - entry.last_used >= self.idle_timeout)
+                or (self.max_age is not None and now - entry.created >= self.max_age)
+            )
+        ]
+        for session_id in expired:
+            await self._evict(session_id, self._live[session_id])
+
+        evicted = len(expired)
+        if self.max_sessions is not None and len(self._live) > self.max_sessions:
+            for session_id, entry in list(self._live.items()):
+                if len(self._live) <= self.max_sessions:
+                    break
+                if session_id != keep and not self._busy(entry):
+                    await self._evict(session_id, entry)
+                    evicted += 1
+        return evicted
+
+    async def _sweep_forever(self):
+        while True:
+            await asyncio.sleep(self.sweep_interval)
+            await self.sweep()
@@ -0,0 +1,141 @@
+# For licensing see accompanying LICENSE file.
+# Copyright (C) 2026 Apple Inc. All Rights Reserved.
+
+"""
+Typed stream events.
+
+:meth:`LanguageModelSession.stream_events() <apple_fm_sdk.LanguageModelSession.stream_events>`
+reports what happens during a streamed response as a sequence of events: new
+text, the start and end of every tool call, and a final completion event with
+timing metrics. All events are produced by the native layer and delivered
+through a single callback, in the order they happened.
+"""
+
+import json
+from dataclasses import dataclass, field
+from typing import Any, Dict, Optional, Union
+
+# Mirrors FMStreamEventType in FoundationModels.h
+_TEXT_DELTA = 0
+_TEXT_REPLACED = 1
+_TOOL_CALL_STARTED = 2
+_TOOL_CALL_FINISHED = 3
+_COMPLETED = 4
+
+
+@dataclass(frozen=True)
+class TextDelta:
+    """Text generated since the previous text event.
+
+    :param text: The new text. If ``replaces`` is True, the full response text so far.
+    :param replaces: True if the model revised text it had already produced, in
+        which case ``text`` replaces everything received before instead of
+        extending it.
+    """
+
+    text: str
+    replaces: bool = False
+
+
+@dataclass(frozen=True)
+class ToolCallStarted:
+    """The model invoked a tool.
+
+    :param name: The tool's name
+    :param arguments: The arguments the model generated, decoded from JSON
+    :param call_id: Identifies the call; matches the ``call_id`` of its
+        :class:`ToolCallFinished` event
+    """
+
+    name: str
+    arguments: Dict[str, Any] = field(default_factory=dict)
+    call_id: int = 0
+
+
+@dataclass(frozen=True)
+class ToolCallFinished:
+    """A tool call returned, failed, timed out, or was cancelled.
+
+    :param name: The tool's name
+    :param duration: Seconds from dispatching the call to recording its result,
+        measured natively
+    :param call_id: Identifies the call; matches its :class:`ToolCallStarted` event
+    :param outcome: One of ``"success"``, ``"error"``, ``"timeout"`` or ``"cancelled"``
+    """
+
+    name: str
+    duration: float
+    call_id: int = 0
+    outcome: str = "success"
+
+
+@dataclass(frozen=True)
+class StreamMetrics:
+    """Timing of a completed stream.
+
+    :param duration: Seconds from the start of the stream to its completion
+    :param time_to_first_text: Seconds until the first text arrived, or None if
+        the response was empty
+    :param snapshots: Number of snapshots the model produced
+    :param tool_calls: Number of tool calls that finished during the stream
+    :param tool_seconds: Total time spent in those tool calls
+    """
+
+    duration: float
+    time_to_first_text: Optional[float] = None
+    snapshots: int = 0
+    tool_calls: int = 0
+    tool_seconds: float = 0.0
+
+
+@dataclass(frozen=True)
+class Completed:
+    """The last event of a successful stream.
+
+    :param text: The complete response text
+    :param metrics: Timing of the stream
+    :param stopped: True if the response was cut short by a stop sequence
+    """
+
+    text: str
+    metrics: StreamMetrics
+    stopped: bool = False
+
+
+StreamEvent = Union[TextDelta, ToolCallStarted, ToolCallFinished, Completed]
+
+
+def _event_from_native(event_type: int, payload: str) -> StreamEvent:
+    """Build the event for a payload delivered by the native event callback."""
+    if event_type == _TEXT_DELTA:
+        return TextDelta(payload)
+    if event_type == _TEXT_REPLACED:
+        return TextDelta(payload, replaces=True)
+
+    data = json.loads(payload)
+    if event_type == _TOOL_CALL_STARTED:
+        return ToolCallStarted(
+            name=data["name"],
+            arguments=data.get("arguments") or {},
+            call_id=data["callId"],
+        )
+    if event_type == _TOOL_CALL_FINISHED:
+        return ToolCallFinished(
+            name=data["name"],
+            duration=data["durationSeconds"],
+            call_id=data["callId"],
+            outcome=data["outcome"],
+        )
+    if event_type == _COMPLETED:
+        return Completed(
+            text=data["text"],
+            metrics=StreamMetrics(
+                duration=data["durationSeconds"],
+                time_to_first_text=data.get("timeToFirstTextSeconds"),
+                snapshots=data["snapshots"],
+                tool_calls=data["toolCalls"],
+                tool_seconds=data["toolSeconds"],
+            ),
+            stopped=data.get("stopped", False),
+        )
+    raise ValueError(f"Unknown stream event type: {event_type}")
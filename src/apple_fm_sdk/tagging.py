@@ -0,0 +1,383 @@
+# For licensing see accompanying LICENSE file.
+# Copyright (C) 2026 Apple Inc. All Rights Reserved.
+
+"""
+High-throughput content tagging.
+
+This module tags large numbers of short texts with the content-tagging model.
+The schema describing the tags is built once per run rather than once per
+text, each text is tagged on a fresh session so that no context accumulates,
+and a fixed number of workers pull texts from the input as they become free.
+
+The main components are:
+
+* :func:`tag_many` - Tag an iterable of texts, streaming the results
+* :class:`TaggingRun` - The async iterator returned by :func:`tag_many`
+* :class:`TagResult` - The tags found for one text
+* :class:`TaggingStats` - Counters and throughput of a run
+
+Example:
+    Tagging support tickets with a fixed label set::
+
+        import apple_fm_sdk as fm
+
+        run = fm.tagging.tag_many(
+            tickets,
+            labels=["billing", "bug", "feature request", "account"],
+        )
+        async for result in run:
+            print(result.index, result.tags)
+        print(f"{run.stats.items_per_second:.1f} tickets/s")
+"""
+
+import asyncio
+from dataclasses import dataclass
+from typing import (
+    Any,
+    AsyncIterator,
+    Callable,
+    Iterable,
+    List,
+    Optional,
+    Type,
+    Union,
+)
+
+from .core import SystemLanguageModel, SystemLanguageModelUseCase
+from .errors import FoundationModelsError
+from .generable import GeneratedContent, Generable
+from .generable_utils import generable
+from .generation_guide import GenerationGuide, guide
+from .generation_schema import GenerationSchema
+from .session import LanguageModelSession
+
+DEFAULT_INSTRUCTIONS = "Tag the text you are given. Only use tags that clearly apply."
+
+# Texts each worker may read ahead of the consumer, so that a slow consumer or
+# a slow text at the head of an ordered run cannot buffer the whole input
+_READ_AHEAD_PER_WORKER = 4
+
+TaggingPrompt = Union[str, Callable[[str], str]]
+
+
+@dataclass(frozen=True)
+class TagResult:
+    """The outcome of tagging one text.
+
+    :ivar index: Position of the text in the input
+    :vartype index: int
+    :ivar text: The text that was tagged
+    :vartype text: str
+    :ivar tags: The labels chosen for the text when tagging with ``labels``,
+        otherwise None
+    :vartype tags: Optional[List[str]]
+    :ivar value: The generated value when tagging with ``schema``: an instance
+        of the Generable type, or a GeneratedContent for a GenerationSchema.
+        For ``labels`` this is the list of tags.
+    :vartype value: Any
+    :ivar error: The error the model raised for this text, if any. Failed texts
+        do not stop the run.
+    :vartype error: Optional[FoundationModelsError]
+    """
+
+    index: int
+    text: str
+    tags: Optional[List[str]] = None
+    value: Any = None
+    error: Optional[FoundationModelsError] = None
+
+
+@dataclass
+class TaggingStats:
+    """Counters and throughput of a tagging run, updated as results arrive.
+
+    :ivar completed: Number of texts tagged successfully
+    :vartype completed: int
+    :ivar failed: Number of texts the model failed to tag
+    :vartype failed: int
+    :ivar characters: Total length of the texts processed so far
+    :vartype characters: int
+    :ivar elapsed: Seconds since the run started
+    :vartype elapsed: float
+    """
+
+    completed: int = 0
+    failed: int = 0
+    characters: int = 0
+    elapsed: float = 0.0
+
+    @property
+    def processed(self) -> int:
+        """Number of texts processed, successfully or not."""
+        return self.completed + self.failed
+
+    @property
+    def items_per_second(self) -> float:
+        """Texts processed per second of wall-clock time."""
+        return self.processed / self.elapsed if self.elapsed > 0 else 0.0
+
+    @property
+    def characters_per_second(self) -> float:
+        """Characters of input processed per second of wall-clock time."""
+        return self.characters / self.elapsed if self.elapsed > 0 else 0.0
+
+
+def label_schema(labels: List[str], *, max_tags: Optional[int] = None) -> GenerationSchema:
+    """Build the schema that restricts a response to a set of labels.
+
+    :param labels: The labels the model may choose from
+    :type labels: List[str]
+    :param max_tags: Maximum number of labels per text. Unlimited if None.
+    :type max_tags: Optional[int]
+    :return: A schema with a single ``tags`` property, a list of labels
+    :rtype: GenerationSchema
+    :raises ValueError: If ``labels`` is empty, contains duplicates or
+        non-strings, or ``max_tags`` is not positive
+    """
+    if not labels:
+        raise ValueError("labels must not be empty")
+    if not all(isinstance(label, str) for label in labels):
+        raise ValueError("labels must be strings")
+    if len(set(labels)) != len(labels):
+        raise ValueError("labels must be unique")
+    if max_tags is not None and max_tags <= 0:
+        raise ValueError("max_tags must be a positive integer")
+
+    @generable("Tags that apply to a text")
+    class Tags:
+        tags: List[str] = guide(
+            "The labels that apply to the text",
+            element=GenerationGuide.anyOf(list(labels)),
+            max_items=max_tags,
+        )
+
+    return Tags.generation_schema()
+
+
+def _format_prompt(template: TaggingPrompt, text: str) -> str:
+    if callable(template):
+        return template(text)
+    return template.replace("{text}", text)
+
+
+class TaggingRun:
+    """Async iterator over the results of :func:`tag_many`.
+
+    Iterating starts the run. Stopping iteration early cancels the texts still
+    being tagged. :attr:`stats` is updated as each result arrives and can be
+    read during or after the run.
+
+    :ivar stats: Counters and throughput of the run
+    :vartype stats: TaggingStats
+    """
+
+    def __init__(
+        self,
+        texts: Iterable[str],
+        *,
+        schema: GenerationSchema,
+        convert: Callable[[GeneratedContent], Any],
+        labels_mode: bool,
+        prompt: TaggingPrompt,
+        instructions: Optional[str],
+        model: SystemLanguageModel,
+        concurrency: int,
+        ordered: bool,
+    ):
+        self._texts = texts
+        self._schema = schema
+        self._convert = convert
+        self._labels_mode = labels_mode
+        self._prompt = prompt
+        self._instructions = instructions
+        self._model = model
+        self._concurrency = concurrency
+        self._ordered = ordered
+        self._started = False
+        self.stats = TaggingStats()
+
+    def __aiter__(self) -> AsyncIterator[TagResult]:
+        if self._started:
+            raise RuntimeError("A TaggingRun can only be iterated once")
+        self._started = True
+        return self._run()
+
+    async def _tag(self, index: int, text: str) -> TagResult:
+        # A fresh session per text keeps every request at the same, minimal context
+        session = LanguageModelSession(instructions=self._instructions, model=self._model)
+        try:
+            content = await session.respond(
+                _format_prompt(self._prompt, text), schema=self._schema
+            )
+        except FoundationModelsError as error:
+            return TagResult(index, text, error=error)
+        value = self._convert(content)
+        return TagResult(index, text, value if self._labels_mode else None, value)
+
+    async def _run(self) -> AsyncIterator[TagResult]:
+        loop = asyncio.get_running_loop()
+        started = loop.time()
+        items = enumerate(self._texts)
+        results: "asyncio.Queue[Any]" = asyncio.Queue()
+        # A text holds a place in the window from when it is read until its
+        # result is yielded, which bounds both the queue and the reorder buffer
+        window = asyncio.Semaphore(self._concurrency * _READ_AHEAD_PER_WORKER)
+
+        async def worker():
+            try:
+                while True:
+                    await window.acquire()
+                    # The workers share one iterator, so each text is read exactly once
+                    item = next(items, None)
+                    if item is None:
+                        window.release()
+                        return
+                    results.put_nowait(await self._tag(*item))
+            except Exception as error:
+                results.put_nowait(error)
+            finally:
+                results.put_nowait(None)
+
+        workers = [asyncio.ensure_future(worker()) for _ in range(self._concurrency)]
+        reorder: dict = {}
+        next_index = 0
+        running = len(workers)
+        try:
+            while running:
+                result = await results.get()
+                if result is None:
+                    running -= 1
+                    continue
+                if isinstance(result, Exception):
+                    raise result
+
+                stats = self.stats
+                if result.error is None:
+                    stats.completed += 1
+                else:
+                    stats.failed += 1
+                stats.characters += len(result.text)
+                stats.elapsed = loop.time() - started
+
+                if not self._ordered:
+                    window.release()
+                    yield result
+                    continue
+                reorder[result.index] = result
+                while next_index in reorder:
+                    window.release()
+                    yield reorder.pop(next_index)
+                    next_index += 1
+        finally:
+            # Stop outstanding work if tagging failed or the consumer stopped early
+            for task in workers:
+                task.cancel()
+            await asyncio.gather(*workers, return_exceptions=True)
+            self.stats.elapsed = loop.time() - started
+
+
+def tag_many(
+    texts: Iterable[str],
+    *,
+    labels: Optional[List[str]] = None,
+    schema: Optional[Union[Type[Generable], GenerationSchema]] = None,
+    max_tags: Optional[int] = None,
+    prompt: TaggingPrompt = "{text}",
+    instructions: Optional[str] = DEFAULT_INSTRUCTIONS,
+    model: Optional[SystemLanguageModel] = None,
+    concurrency: int = 4,
+    ordered: bool = True,
+) -> TaggingRun:
+    """Tag many texts with the content-tagging model.
+
+    Exactly one of ``labels`` and ``schema`` must be given. With ``labels``,
+    the model chooses from a fixed label set and each result's ``tags`` lists
+    the chosen labels. With ``schema``, each result's ``value`` holds whatever
+    the schema describes.
+
+    The schema is built once for the whole run. ``concurrency`` workers pull
+    texts from ``texts`` as they become free, so the input may be a generator
+    of any length, and each text is tagged on a fresh session. At most four
+    texts per worker are read ahead of the results yielded so far, so a slow
+    consumer, or in an ordered run a slow text, pauses reading from ``texts``
+    rather than buffering it.
+
+    :param texts: The texts to tag
+    :type texts: Iterable[str]
+    :param labels: The labels the model may choose from
+    :type labels: Optional[List[str]]
+    :param schema: A Generable type or GenerationSchema describing the tags
+    :type schema: Optional[Union[Type[Generable], GenerationSchema]]
+    :param max_tags: Maximum number of labels per text, with ``labels``
+    :type max_tags: Optional[int]
+    :param prompt: Prompt for each text. Either a string containing ``{text}``,
+        or a callable that takes the text and returns the prompt.
+    :type prompt: Union[str, Callable[[str], str]]
+    :param instructions: Instructions for every session
+    :type instructions: Optional[str]
+    :param model: Model to tag with. Defaults to a system model created with
+        :attr:`SystemLanguageModelUseCase.CONTENT_TAGGING`.
+    :type model: Optional[SystemLanguageModel]
+    :param concurrency: Number of texts tagged at the same time
+    :type concurrency: int
+    :param ordered: Yield results in input order if True, or as soon as each
+        one finishes if False
+    :type ordered: bool
+    :return: An async iterator of :class:`TagResult`, one per text
+    :rtype: TaggingRun
+    :raises ValueError: If neither or both of ``labels`` and ``schema`` are
+        given, or ``concurrency`` is not positive
+
+    Example:
+        ::
+
+            import apple_fm_sdk as fm
+
+            @fm.generable("Topics and sentiment of a review")
+            class ReviewTags:
+                topics: list[str] = fm.guide("Topics mentioned", max_items=3)
+                sentiment: str = fm.guide("Sentiment", anyOf=["positive", "neutral", "negative"])
+
+            async for result in fm.tagging.tag_many(reviews, schema=ReviewTags, ordered=False):
+                if result.error is None:
+                    print(result.index, result.value.sentiment)
+    """
+    if (labels is None) == (schema is None):
+        raise ValueError("Exactly one of 'labels' and 'schema' must be provided")
+    if concurrency <= 0:
+        raise ValueError("concurrency must be a positive integer")
+
+    if labels is not None:
+        compiled = label_schema(labels, max_tags=max_tags)
+
+        def convert(content: GeneratedContent) -> Any:
+            return content.value(for_property="tags") or []
+
+    elif isinstance(schema, GenerationSchema):
+        compiled = schema
+
+        def convert(content: GeneratedContent) -> Any:
+            return content
+
+    else:
+        if not isinstance(schema, Generable):
+            raise ValueError(
+                f"{schema.__name__} is not a Generable type. Use @generable decorator."
+            )
+        compiled = schema.generation_schema()
+        convert = schema._from_generated_content
+
+    if model is None:
+        model = SystemLanguageModel(use_case=SystemLanguageModelUseCase.CONTENT_TAGGING)
+
+    return TaggingRun(
+        texts,
+        schema=compiled,
+        convert=convert,
+        labels_mode=labels is not None,
+        prompt=prompt,
+        instructions=instructions,
+        model=model,
+        concurrency=concurrency,
+        ordered=ordered,
+    )
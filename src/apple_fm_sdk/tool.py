@@ -2,13 +2,18 @@
 # Copyright (C) 2026 Apple Inc. All Rights Reserved.
 
 import asyncio
+import functools
 import threading
 import logging
 from .generation_schema import GenerationSchema
 from .generable import GeneratedContent
+from .generable_utils import _content_converter
 from .c_helpers import _ManagedObject, _get_error_string
+from .tool_stats import ToolStats, _register_tool
+from .scheduler import _exempt
 import ctypes
 from abc import ABC, abstractmethod
+from typing import Any, Callable, List, Optional, Sequence, Type, get_type_hints
 from .errors import _status_code_to_exception
 
 logger = logging.getLogger(__name__)
@@ -40,7 +45,9 @@ class Tool(_ManagedObject, ABC):
 
     Tools use an async callback system that:
 
-    - Automatically handles argument parsing from GeneratedContent
+    - Automatically handles argument parsing from GeneratedContent, or decodes
+      arguments straight into a ``@generable`` class when ``call()`` is
+      annotated with one
     - Executes your ``call()`` method in the appropriate async context
     - Manages threading and event loops transparently
     - Returns results or errors back to the model
@@ -60,7 +67,55 @@ class Tool(_ManagedObject, ABC):
     - The model receives error messages and can adapt its response
     - Tools should raise descriptive exceptions for better model understanding
 
+    **Timeouts and Cancellation:**
+
+    Set the ``timeout`` class attribute (in seconds) to bound how long a single
+    call may run. The timeout is enforced natively: a call that has not
+    returned in time fails with an error, and the session is not left waiting
+    on it. When a call times out, or the request that triggered it is
+    cancelled, the running ``call()`` coroutine is cancelled as well, so tools
+    should let :class:`asyncio.CancelledError` propagate.
+
+    **Batched Calls:**
+
+    When the model makes several calls to the same tool in one step, each call
+    normally runs its own ``call()`` coroutine. A tool that can answer many
+    calls more cheaply at once, for example with a single database query,
+    overrides :meth:`call_batch`. Calls made within ``batch_window`` seconds
+    of each other, up to ``max_batch_size``, are then delivered together in
+    one native callback, and their results are returned together.
+
+    **Typed Arguments:**
+
+    When the ``args`` parameter of ``call()`` is annotated with a ``@generable``
+    class, the tool does not need an ``arguments_schema`` property: the schema is
+    taken from that class, and each call's arguments are decoded directly into an
+    instance of it by a converter that is compiled once per class. When ``args``
+    is annotated as ``GeneratedContent`` (or not annotated), ``call()`` receives
+    the raw ``GeneratedContent`` as before.
+
     Examples:
+        Tool with typed arguments::
+
+            import apple_fm_sdk as fm
+
+            @fm.generable("Calculator parameters")
+            class CalculatorParams:
+                operation: str = fm.guide("The operation to perform")
+                a: float = fm.guide("First number")
+                b: float = fm.guide("Second number")
+
+            class CalculatorTool(fm.Tool):
+                name = "calculator"
+                description = "Performs basic arithmetic operations"
+
+                async def call(self, args: CalculatorParams) -> str:
+                    if args.operation == "add":
+                        return str(args.a + args.b)
+                    if args.operation == "multiply":
+                        return str(args.a * args.b)
+                    raise ValueError(f"Unknown operation: {args.operation}")
+
         Simple calculator tool::
 
             import apple_fm_sdk as fm
@@ -158,6 +213,12 @@ class Tool(_ManagedObject, ABC):
     Attributes:
         name: The tool's name (must be set by subclass)
         description: Human-readable description of what the tool does (must be set by subclass)
+        timeout: Maximum duration of a single call in seconds, or ``None`` (the
+            default) for no limit
+        batch_window: For tools that override :meth:`call_batch`, how long in
+            seconds the first call of a batch waits for more calls
+        max_batch_size: For tools that override :meth:`call_batch`, the most
+            calls delivered in one batch
 
     Note:
         - Tool names should be descriptive and follow snake_case convention
@@ -174,9 +235,11 @@ class Tool(_ManagedObject, ABC):
 
     name: str
     description: str
+    timeout: Optional[float] = None
+    batch_window: float = 0.005
+    max_batch_size: int = 32
 
     @property
-    @abstractmethod
     def arguments_schema(self) -> GenerationSchema:
         """Define the schema for tool arguments.
 
@@ -184,8 +247,15 @@ class Tool(_ManagedObject, ABC):
         and types of arguments the tool expects. The model uses this schema to
         generate properly formatted arguments when invoking the tool.
 
+        Subclasses whose ``call()`` takes a typed ``@generable`` argument get
+        this property for free, built once per subclass and shared by its
+        instances; all others must override it. A tool reads this property
+        once, when it is created.
+
         :return: Schema defining the tool's expected arguments
         :rtype: GenerationSchema
+        :raises TypeError: If not overridden and ``call()`` is not annotated
+            with a ``@generable`` class
 
         Example:
             ::
@@ -201,7 +271,20 @@ class Tool(_ManagedObject, ABC):
                 def arguments_schema(self) -> fm.GenerationSchema:
                     return SearchParams.generation_schema()
         """
-        pass
+        tool_class = type(self)
+        # Read through __dict__ so that each subclass builds its own schema. Two
+        # threads may both build it on first use; either schema is equivalent.
+        schema = tool_class.__dict__.get("_default_arguments_schema")
+        if schema is None:
+            arguments_type = _typed_arguments_class(tool_class)
+            if arguments_type is None:
+                raise TypeError(
+                    "Tool subclass must override 'arguments_schema' or annotate the "
+                    "'args' parameter of 'call' with a @generable class."
+                )
+            schema = arguments_type.generation_schema()
+            tool_class._default_arguments_schema = schema
+        return schema
 
     @abstractmethod
     async def call(self, args: GeneratedContent) -> str:
@@ -209,10 +292,12 @@ class Tool(_ManagedObject, ABC):
 
         This async method is invoked when the model decides to use the tool.
         The arguments are automatically parsed according to the ``arguments_schema``
-        and provided as a GeneratedContent object.
+        and provided as a GeneratedContent object, or as an instance of the
+        ``@generable`` class that ``args`` is annotated with.
 
         :param args: Parsed arguments as GeneratedContent. Access values via ``args.value``
-            which contains a dictionary matching your schema structure.
+            which contains a dictionary matching your schema structure. If ``args`` is
+            annotated with a ``@generable`` class, an instance of that class instead.
         :type args: GeneratedContent
         :return: The tool's result as a string. This result is provided back to the
             model to inform its continued generation.
@@ -242,13 +327,60 @@ class Tool(_ManagedObject, ABC):
         """
         pass
 
+    async def call_batch(self, args: Sequence[GeneratedContent]) -> List[Any]:
+        """Execute several calls at once.
+
+        Override this method to handle the calls of a batch together. Tools
+        that do not override it receive each call in :meth:`call`.
+
+        :param args: The arguments of each call in the batch, decoded as for
+            :meth:`call`
+        :type args: Sequence[GeneratedContent]
+        :return: One result per call, in the order of ``args``. A result that
+            is an exception instance is reported to the model as that call's
+            error; other results are converted to strings.
+        :rtype: list
+        :raises Exception: Any exception raised is reported as the error of
+            every call in the batch
+
+        Example:
+            ::
+
+                class UserLookupTool(fm.Tool):
+                    name = "lookup_user"
+                    description = "Looks up a user by ID"
+
+                    async def call(self, args: UserParams) -> str:
+                        return (await self.call_batch([args]))[0]
+
+                    async def call_batch(self, args: list[UserParams]) -> list:
+                        rows = await db.fetch_users([a.user_id for a in args])
+                        return [rows.get(a.user_id, KeyError(a.user_id)) for a in args]
+        """
+        return await asyncio.gather(
+            *(self._async_callable(arguments) for arguments in args),
+            return_exceptions=True,
+        )
+
     def __init__(self):
+        # Build the schema once: it is verified here and kept alive below until
+        # FMBridgedToolCreate has retained it
+        self._arguments_schema = self.arguments_schema
+
         # Verify the subclass implementation
         self._verify_subclass_()
 
         # Store the async callable
         self._async_callable = self.call
-        self._pending_calls = {}  # Maps call_id to future
+
+        # Precompile the argument decoder once for typed tools
+        arguments_type = _typed_arguments_class(type(self))
+        self._decode_arguments: Optional[Callable[[dict], object]] = (
+            _content_converter(arguments_type) if arguments_type is not None else None
+        )
+        # Maps call_id to (loop, task) once the call's coroutine is running, or to
+        # None while it is still being scheduled
+        self._pending_calls = {}
         self._call_lock = threading.Lock()
 
         # Create the C callback function type matching the bindings
@@ -257,6 +389,27 @@ class Tool(_ManagedObject, ABC):
             ctypes.c_void_p, lib.FMGeneratedContentRef, ctypes.c_uint
         )
 
+        def _schedule(run):
+            # Tool calls run on behalf of a request that is already admitted by
+            # the scheduler, so requests they make are not queued again
+            run = functools.partial(_exempt, run)
+            # Try to get the current running loop, or create a new one
+            try:
+                loop = asyncio.get_running_loop()  # noqa: F841 this unused variable is needed to check if a loop is running
+                asyncio.create_task(run())
+            except RuntimeError:
+                # No running loop - create a new thread with event loop
+                def _run_in_thread():
+                    loop = asyncio.new_event_loop()
+                    asyncio.set_event_loop(loop)
+                    try:
+                        loop.run_until_complete(run())
+                    finally:
+                        loop.close()
+
+                thread = threading.Thread(target=_run_in_thread, daemon=True)
+                thread.start()
+
         # Create the actual callback function
         def _c_callback_impl(content_ref, call_id):
             """C callback that gets invoked when the tool is called."""
@@ -266,11 +419,29 @@ class Tool(_ManagedObject, ABC):
                 # so we don't need to manually retain it here
                 generated_content = GeneratedContent(_ptr=content_ref)
 
+                with self._call_lock:
+                    self._pending_calls[call_id] = None
+
                 # Run the async callable in a new task
                 async def _run_async_callable():
+                    with self._call_lock:
+                        if call_id not in self._pending_calls:
+                            # Timed out or cancelled before the coroutine started
+                            return
+                        self._pending_calls[call_id] = (
+                            asyncio.get_running_loop(),
+                            asyncio.current_task(),
+                        )
                     try:
+                        # Decode typed arguments; decoding errors are reported like call errors
+                        args = (
+                            generated_content
+                            if self._decode_arguments is None
+                            else self._decode_arguments(generated_content._content_dict)
+                        )
+
                         # Call the tool subclass's async function
-                        result = await self._async_callable(generated_content)
+                        result = await self._async_callable(args)
 
                         # Convert result to string if needed
                         if not isinstance(result, str):
@@ -280,44 +451,125 @@ class Tool(_ManagedObject, ABC):
                         result_bytes = result.encode("utf-8")
                         lib.FMBridgedToolFinishCall(self._ptr, call_id, result_bytes)
 
+                    except asyncio.CancelledError:
+                        with self._call_lock:
+                            cancelled_natively = call_id not in self._pending_calls
+                        if cancelled_natively:
+                            # The call has already been failed on the Swift side
+                            return
+                        # Cancelled from Python, for example by loop shutdown; release the
+                        # waiting Swift call before propagating
+                        lib.FMBridgedToolFailCall(
+                            self._ptr, call_id, b"Tool error: call was cancelled"
+                        )
+                        raise
+
                     except Exception as e:
                         # On error, finish with error message
                         error_msg = f"Tool error: {str(e)}"
                         error_bytes = error_msg.encode("utf-8")
-                        lib.FMBridgedToolFinishCall(self._ptr, call_id, error_bytes)
+                        lib.FMBridgedToolFailCall(self._ptr, call_id, error_bytes)
 
-                # Schedule the async callable
-                # Try to get the current running loop, or create a new one
-                try:
-                    loop = asyncio.get_running_loop()  # noqa: F841 this unused variable is needed to check if a loop is running
-                    asyncio.create_task(_run_async_callable())
-                except RuntimeError:
-                    # No running loop - create a new thread with event loop
-                    def _run_in_thread():
-                        loop = asyncio.new_event_loop()
-                        asyncio.set_event_loop(loop)
-                        try:
-                            loop.run_until_complete(_run_async_callable())
-                        finally:
-                            loop.close()
-
-                    thread = threading.Thread(target=_run_in_thread, daemon=True)
-                    thread.start()
+                    finally:
+                        with self._call_lock:
+                            self._pending_calls.pop(call_id, None)
+
+                _schedule(_run_async_callable)
 
             except Exception as e:
                 # Catch-all error handler
                 error_msg = f"Callback error: {str(e)}"
                 error_bytes = error_msg.encode("utf-8")
                 try:
-                    lib.FMBridgedToolFinishCall(self._ptr, call_id, error_bytes)
+                    lib.FMBridgedToolFailCall(self._ptr, call_id, error_bytes)
                 except Exception:
                     raise
 
+        # Invoked by Swift with every call of a batch, for tools that override call_batch
+        def _c_batch_callback_impl(content_refs, call_ids, count):
+            contents = [GeneratedContent(_ptr=content_refs[i]) for i in range(count)]
+            ids = [call_ids[i] for i in range(count)]
+            with self._call_lock:
+                for call_id in ids:
+                    self._pending_calls[call_id] = None
+
+            async def _run_batch():
+                running = (asyncio.get_running_loop(), asyncio.current_task())
+                with self._call_lock:
+                    # Calls that timed out or were cancelled before the coroutine started
+                    live = [i for i, call_id in enumerate(ids) if call_id in self._pending_calls]
+                    for i in live:
+                        self._pending_calls[ids[i]] = running
+                if not live:
+                    return
+                try:
+                    args = [
+                        contents[i]
+                        if self._decode_arguments is None
+                        else self._decode_arguments(contents[i]._content_dict)
+                        for i in live
+                    ]
+                    results = await self.call_batch(args)
+                    if len(results) != len(live):
+                        raise ValueError(
+                            f"call_batch returned {len(results)} results for {len(live)} calls"
+                        )
+                    self._finish_calls([ids[i] for i in live], results)
+
+                except asyncio.CancelledError:
+                    with self._call_lock:
+                        remaining = [ids[i] for i in live if ids[i] in self._pending_calls]
+                    if not remaining:
+                        # Every call has already been failed on the Swift side
+                        return
+                    error = RuntimeError("call was cancelled")
+                    self._finish_calls(remaining, [error] * len(remaining))
+                    raise
+
+                except Exception as e:
+                    self._finish_calls([ids[i] for i in live], [e] * len(live))
+
+                finally:
+                    with self._call_lock:
+                        for i in live:
+                            self._pending_calls.pop(ids[i], None)
+
+            try:
+                _schedule(_run_batch)
+            except Exception as e:
+                self._finish_calls(ids, [e] * count)
+
+        # Invoked by Swift when a call times out or its calling task is cancelled
+        def _c_cancel_impl(call_id):
+            with self._call_lock:
+                running = self._pending_calls.pop(call_id, None)
+                # A batch keeps running while any of its other calls is pending
+                if running is not None and any(
+                    other is running for other in self._pending_calls.values()
+                ):
+                    running = None
+            if running is not None:
+                loop, task = running
+                try:
+                    loop.call_soon_threadsafe(task.cancel)
+                except RuntimeError:
+                    # The loop has already closed, so the task is done
+                    pass
+
         # Wrap the callback implementation with the callback type
         _c_callback = CallbackType(_c_callback_impl)
-
-        # Store the callback to prevent garbage collection
+        _c_cancel = ctypes.CFUNCTYPE(ctypes.c_void_p, ctypes.c_uint)(_c_cancel_impl)
+        _c_batch_callback = ctypes.CFUNCTYPE(
+            ctypes.c_void_p,
+            ctypes.POINTER(lib.FMGeneratedContentRef),
+            ctypes.POINTER(ctypes.c_uint),
+            ctypes.c_size_t,
+        )(_c_batch_callback_impl)
+
+        # Store the callbacks to prevent garbage collection
         self._c_callback = _c_callback
+        self._c_cancel = _c_cancel
+        self._c_batch_callback = _c_batch_callback
 
         # Initialize _ptr to None before calling super().__init__() to avoid AttributeError in __del__
         self._ptr = None
@@ -326,22 +578,44 @@ class Tool(_ManagedObject, ABC):
         name_bytes = self.name.encode("utf-8")
         description_bytes = self.description.encode("utf-8")
 
-        # Store the schema to keep it alive (prevents deallocation before FMBridgedToolCreate completes)
-        # This is necessary because arguments_schema is a property that returns a new object each time
-        self._arguments_schema = self.arguments_schema
+        if self.timeout is not None and not self.timeout > 0:
+            raise ValueError(
+                f"Tool timeout must be a positive number of seconds, got {self.timeout!r}"
+            )
 
         # Prepare error handling parameters
         error_code = ctypes.c_int()
         error_description = ctypes.POINTER(ctypes.c_char)()
 
-        ptr = lib.FMBridgedToolCreate(
-            name_bytes,
-            description_bytes,
-            self._arguments_schema._ptr,
-            self._c_callback,
-            ctypes.byref(error_code),
-            ctypes.byref(error_description),
-        )
+        if self.batched:
+            if not self.batch_window >= 0 or not self.max_batch_size > 0:
+                raise ValueError(
+                    "Tool batch_window must be non-negative and max_batch_size positive, "
+                    f"got {self.batch_window!r} and {self.max_batch_size!r}"
+                )
+            ptr = lib.FMBridgedToolCreateBatched(
+                name_bytes,
+                description_bytes,
+                self._arguments_schema._ptr,
+                self._c_batch_callback,
+                self._c_cancel,
+                float(self.timeout or 0),
+                float(self.batch_window),
+                int(self.max_batch_size),
+                ctypes.byref(error_code),
+                ctypes.byref(error_description),
+            )
+        else:
+            ptr = lib.FMBridgedToolCreateWithTimeout(
+                name_bytes,
+                description_bytes,
+                self._arguments_schema._ptr,
+                self._c_callback,
+                self._c_cancel,
+                float(self.timeout or 0),
+                ctypes.byref(error_code),
+                ctypes.byref(error_description),
+            )
 
         # Check for errors
         if not ptr:
@@ -352,13 +626,78 @@ class Tool(_ManagedObject, ABC):
             raise _status_code_to_exception(err_code or error_code.value, error_msg)
 
         super().__init__(ptr)
+        _register_tool(self)
+
+    @property
+    def batched(self) -> bool:
+        """Whether calls are delivered in batches, because the tool overrides :meth:`call_batch`.
+
+        :rtype: bool
+        """
+        return type(self).call_batch is not Tool.call_batch
+
+    def _finish_calls(self, call_ids: List[int], results: Sequence[Any]) -> None:
+        """Return the results of several calls to the native side at once."""
+        count = len(call_ids)
+        outputs = []
+        failed = []
+        for result in results:
+            if isinstance(result, asyncio.CancelledError):
+                result = RuntimeError("call was cancelled")
+            if isinstance(result, BaseException):
+                outputs.append(f"Tool error: {result}".encode("utf-8"))
+                failed.append(True)
+            else:
+                outputs.append((result if isinstance(result, str) else str(result)).encode("utf-8"))
+                failed.append(False)
+        lib.FMBridgedToolFinishCalls(
+            self._ptr,
+            (ctypes.c_uint * count)(*call_ids),
+            (ctypes.c_char_p * count)(*outputs),
+            (ctypes.c_bool * count)(*failed),
+            count,
+        )
+
+    def stats(self) -> ToolStats:
+        """Return a snapshot of this tool's call telemetry.
+
+        The native bridge timestamps each call when it is dispatched to the tool
+        and when it finishes, and counts errors, timeouts, cancellations and
+        calls currently in flight.
+
+        :return: The tool's counters and latency histogram
+        :rtype: ToolStats
+
+        Example:
+            ::
+
+                stats = weather_tool.stats()
+                print(f"{stats.calls} calls, {stats.in_flight} in flight")
+                print(f"p50 {stats.percentile(50):.3f}s, p99 {stats.percentile(99):.3f}s")
+
+        See Also:
+            :func:`~apple_fm_sdk.tool_stats.tool_stats` for the stats of all live tools
+        """
+        json_cstr = lib.FMBridgedToolGetStatsJSONString(self._ptr)
+        if not json_cstr or (hasattr(json_cstr, "data") and json_cstr.data is None):
+            return ToolStats(name=self.name)
+        # The return value is wrapped in a String object by ctypes
+        # The String wrapper handles memory, so we don't need to manually free
+        return ToolStats._from_json(self.name, str(json_cstr))
+
+    def reset_stats(self) -> None:
+        """Reset this tool's counters and latency histogram.
+
+        Calls in flight at the time of the reset are still counted when they finish.
+        """
+        lib.FMBridgedToolResetStats(self._ptr)
 
     def _verify_subclass_(self):
         assert hasattr(self, "name"), "Tool subclass must have a 'name' property."
         assert hasattr(self, "description"), (
             "Tool subclass must have a 'description' property."
         )
-        assert hasattr(self, "arguments_schema"), (
+        assert hasattr(type(self), "arguments_schema"), (
             "Tool subclass must have an 'arguments_schema' property."
         )
         assert hasattr(self, "call"), "Tool subclass must implement the 'call' method."
@@ -366,9 +705,43 @@ class Tool(_ManagedObject, ABC):
             raise TypeError("Tool name must be a string.")
         if not isinstance(self.description, str):
             raise TypeError("Tool description must be a string.")
-        if not isinstance(self.arguments_schema, GenerationSchema):
+        if not isinstance(self._arguments_schema, GenerationSchema):
             raise TypeError(
                 "Tool arguments_schema must be a GenerationSchema instance."
             )
         if not asyncio.iscoroutinefunction(self.call):
             raise TypeError("Tool call method must be an async function.")
+
+
+def _typed_arguments_class(tool_class: Type[Tool]) -> Optional[Type]:
+    """Return the @generable class that ``tool_class.call`` takes, if any.
+
+    :param tool_class: A Tool subclass
+    :type tool_class: Type[Tool]
+    :return: The class the ``args`` parameter of ``call`` is annotated with, or
+        None if it is not annotated with a @generable class
+    :rtype: Optional[Type]
+
+    .. note::
+        The result is resolved on first use and cached on ``tool_class``, so
+        annotations are inspected once per subclass rather than per instance.
+    """
+    if "_arguments_class" not in tool_class.__dict__:
+        tool_class._arguments_class = _resolve_arguments_class(tool_class)
+    return tool_class.__dict__["_arguments_class"]
+
+
+def _resolve_arguments_class(tool_class: Type[Tool]) -> Optional[Type]:
+    try:
+        hints = get_type_hints(tool_class.call)
+    except Exception as e:
+        # Unresolvable annotations fall back to passing GeneratedContent
+        logger.debug(f"Could not resolve annotations of {tool_class.__name__}.call: {e}")
+        return None
+    hints.pop("return", None)
+    if len(hints) != 1:
+        return None
+    (arguments_type,) = hints.values()
+    if getattr(arguments_type, "_generable", False) is True:
+        return arguments_type
+    return None
@@ -0,0 +1,193 @@
+# For licensing see accompanying LICENSE file.
+# Copyright (C) 2026 Apple Inc. All Rights Reserved.
+
+"""
+Tool-call telemetry.
+
+The native bridge timestamps every tool call when it is dispatched to Python and
+when its result comes back, and keeps per-tool counters and a latency histogram.
+This module exposes those numbers as :class:`ToolStats` snapshots, either for a
+single tool through :meth:`Tool.stats() <apple_fm_sdk.tool.Tool.stats>` or for
+every live tool through :func:`tool_stats`.
+"""
+
+import json
+import math
+import threading
+import weakref
+from dataclasses import dataclass
+from typing import TYPE_CHECKING, Dict, Optional, Tuple
+
+if TYPE_CHECKING:
+    from .tool import Tool
+
+_SUB_BUCKETS = 8
+
+
+def _bucket_upper_bound(lower: int) -> int:
+    """Return the exclusive upper bound of the histogram bucket starting at ``lower``."""
+    if lower < _SUB_BUCKETS:
+        return lower + 1
+    # Buckets in [2^m, 2^(m+1)) are 2^m / _SUB_BUCKETS wide
+    magnitude = lower.bit_length() - 1
+    return lower + (1 << magnitude) // _SUB_BUCKETS
+
+
+@dataclass(frozen=True)
+class ToolStats:
+    """A snapshot of the call telemetry of one tool, or of all tools sharing a name.
+
+    Latencies are measured natively, from the moment a call is handed to the
+    Python tool until its result (or timeout, or cancellation) is recorded, so
+    they include event-loop scheduling but not model generation time.
+
+    The histogram is log-linear in the style of HdrHistogram: each power-of-two
+    range of microseconds is split into eight buckets, so percentiles are
+    accurate to within 12.5%.
+
+    :param name: The tool's name
+    :param calls: Number of finished calls, of any outcome
+    :param errors: Calls whose ``call()`` raised an exception
+    :param timeouts: Calls failed because they exceeded the tool's ``timeout``
+    :param cancellations: Calls cancelled because their request was cancelled
+    :param in_flight: Calls dispatched but not yet finished
+    :param total_seconds: Sum of the latencies of all finished calls
+    :param max_seconds: Latency of the slowest finished call
+    :param buckets: Non-empty histogram buckets as ``(lower_bound_us, count)`` pairs
+    """
+
+    name: str
+    calls: int = 0
+    errors: int = 0
+    timeouts: int = 0
+    cancellations: int = 0
+    in_flight: int = 0
+    total_seconds: float = 0.0
+    max_seconds: float = 0.0
+    buckets: Tuple[Tuple[int, int], ...] = ()
+
+    @classmethod
+    def _from_json(cls, name: str, json_str: str) -> "ToolStats":
+        data = json.loads(json_str)
+        return cls(
+            name=name,
+            calls=data["calls"],
+            errors=data["errors"],
+            timeouts=data["timeouts"],
+            cancellations=data["cancellations"],
+            in_flight=data["inFlight"],
+            total_seconds=data["totalMicros"] / 1e6,
+            max_seconds=data["maxMicros"] / 1e6,
+            buckets=tuple((lower, count) for lower, count in data["buckets"]),
+        )
+
+    @property
+    def mean_seconds(self) -> float:
+        """Mean latency of finished calls, or 0.0 if there are none."""
+        return self.total_seconds / self.calls if self.calls else 0.0
+
+    def percentile(self, p: float) -> float:
+        """Estimate a latency percentile in seconds.
+
+        The estimate is the midpoint of the histogram bucket containing the
+        requested rank, capped at the slowest recorded call.
+
+        :param p: The percentile, between 0 and 100
+        :type p: float
+        :return: The estimated latency in seconds, or 0.0 if no calls finished
+        :rtype: float
+        :raises ValueError: If ``p`` is outside [0, 100]
+        """
+        if not 0 <= p <= 100:
+            raise ValueError(f"Percentile must be between 0 and 100, got {p}")
+        total = sum(count for _, count in self.buckets)
+        if total == 0:
+            return 0.0
+        rank = max(1, math.ceil(p * total / 100))
+        seen = 0
+        for lower, count in self.buckets:
+            seen += count
+            if seen >= rank:
+                midpoint = (lower + _bucket_upper_bound(lower)) / 2
+                return min(midpoint / 1e6, self.max_seconds)
+        return self.max_seconds
+
+    def merge(self, other: "ToolStats") -> "ToolStats":
+        """Combine two snapshots, for example of two instances of the same tool.
+
+        :param other: The snapshot to add to this one
+        :type other: ToolStats
+        :return: A snapshot with summed counters and histograms, named after this one
+        :rtype: ToolStats
+        """
+        merged: Dict[int, int] = dict(self.buckets)
+        for lower, count in other.buckets:
+            merged[lower] = merged.get(lower, 0) + count
+        return ToolStats(
+            name=self.name,
+            calls=self.calls + other.calls,
+            errors=self.errors + other.errors,
+            timeouts=self.timeouts + other.timeouts,
+            cancellations=self.cancellations + other.cancellations,
+            in_flight=self.in_flight + other.in_flight,
+            total_seconds=self.total_seconds + other.total_seconds,
+            max_seconds=max(self.max_seconds, other.max_seconds),
+            buckets=tuple(sorted(merged.items())),
+        )
+
+
+# Every live Tool instance, so stats can be gathered without holding tools alive
+_registry: "weakref.WeakSet[Tool]" = weakref.WeakSet()
+_registry_lock = threading.Lock()
+
+
+def _register_tool(tool: "Tool") -> None:
+    with _registry_lock:
+        _registry.add(tool)
+
+
+def tool_stats(name: Optional[str] = None) -> Dict[str, ToolStats]:
+    """Return call telemetry for every live tool, keyed by tool name.
+
+    Instances that share a name are merged into one entry. Tools that have been
+    garbage collected no longer contribute.
+
+    :param name: If given, only report tools with this name
+    :type name: Optional[str]
+    :return: A mapping from tool name to its merged :class:`ToolStats`
+    :rtype: Dict[str, ToolStats]
+
+    Example:
+        ::
+
+            import apple_fm_sdk as fm
+
+            for name, stats in fm.tool_stats().items():
+                print(
+                    f"{name}: {stats.calls} calls, {stats.errors} errors, "
+                    f"p99 {stats.percentile(99) * 1000:.1f} ms"
+                )
+    """
+    with _registry_lock:
+        tools = list(_registry)
+    result: Dict[str, ToolStats] = {}
+    for tool in tools:
+        if name is not None and tool.name != name:
+            continue
+        stats = tool.stats()
+        result[tool.name] = (
+            result[tool.name].merge(stats) if tool.name in result else stats
+        )
+    return result
+
+
+def reset_tool_stats() -> None:
+    """Reset the counters and histograms of every live tool.
+
+    Calls that are in flight at the time of the reset are still counted when
+    they finish.
+    """
+    with _registry_lock:
+        tools = list(_registry)
+    for tool in tools:
+        tool.reset_stats()
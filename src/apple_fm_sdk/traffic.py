@@ -0,0 +1,629 @@
+# For licensing see accompanying LICENSE file.
+# Copyright (C) 2026 Apple Inc. All Rights Reserved.
+
+"""
+Record and replay of native model traffic.
+
+:func:`record_traffic` captures every request that crosses the C boundary
+(text and structured responses, streams, pipelined turns and tool calls) into a
+compact trace file: the prompt, the schema, the snapshot sequence with relative
+timings, tool arguments and outputs, and the final status code.
+
+:func:`replay_traffic` serves a trace back through the same C functions, with
+the original timing or as fast as possible, so the Python layers above them
+(sessions, pipelines, tools, your own post-processing) run unchanged. Replay is
+implemented in Python and does not need the native library, so a trace
+recorded on a Mac can drive tests and benchmarks on a Linux CI machine: set
+``APPLE_FM_SDK_REPLAY`` to the trace path before importing ``apple_fm_sdk``.
+
+Trace format:
+    A trace is a JSON Lines file, gzip-compressed when its name ends in
+    ``.gz``. The first line is a header; every other line is one request::
+
+        {"format": "apple-fm-sdk-trace", "version": 1}
+        {"prompt": "...", "schema": null, "status": 0, "output": "...",
+         "elapsed": 0.82, "snapshots": [[0.31, "The"], [0.35, "The cat"]],
+         "tools": [{"at": 0.1, "name": "getWeather", "arguments": {...},
+                    "output": "...", "failed": false, "elapsed": 0.02}]}
+
+    ``snapshots`` is only present for streamed requests. ``schema`` is None for
+    text requests, ``"schema:<name>"`` for a :class:`GenerationSchema` and
+    ``"json:<canonical JSON>"`` for a JSON schema. Failed requests have a
+    non-zero ``status`` and an ``error`` description instead of ``output``.
+"""
+
+import contextlib
+import ctypes
+import gzip
+import json
+import os
+import threading
+import time
+from typing import Any, Callable, Dict, Iterator, List, Optional
+
+_TRACE_FORMAT = "apple-fm-sdk-trace"
+_TRACE_VERSION = 1
+
+# Unpatched functions the recorder uses to inspect schemas, content and tool calls
+_RECORDER_HELPERS = (
+    "FMGenerationSchemaGetJSONString",
+    "FMGeneratedContentGetJSONString",
+    "FMBridgedToolGetCallSession",
+)
+
+# Response callbacks handed to native code while recording, one per callback
+# type. A ctypes thunk must outlive every native call into it, and requests may
+# still call back after the recording ends, so they are kept for the life of
+# the process. Each dispatches to the handler of its request in _handlers.
+_dispatchers: Dict[Any, Any] = {}
+
+# Recorder callback handlers by the user info of their request, which the
+# native layer passes back with every callback
+_handlers_lock = threading.Lock()
+_handlers: Dict[int, Callable] = {}
+
+# The recorder or replay backend currently patched into the bindings
+_active_lock = threading.Lock()
+_active: Optional[str] = None
+
+
+def _open_trace(path: "os.PathLike[str] | str", mode: str):
+    path = os.fspath(path)
+    if path.endswith(".gz"):
+        return gzip.open(path, mode + "t", encoding="utf-8")
+    return open(path, mode, encoding="utf-8")
+
+
+def _load_trace(path: "os.PathLike[str] | str") -> List[Dict[str, Any]]:
+    """Read the request records of a trace file."""
+    with _open_trace(path, "r") as f:
+        lines = [line for line in f if line.strip()]
+    if not lines:
+        raise ValueError(f"Empty traffic trace: {os.fspath(path)}")
+    header = json.loads(lines[0])
+    if header.get("format") != _TRACE_FORMAT:
+        raise ValueError(f"Not a traffic trace: {os.fspath(path)}")
+    if header.get("version") != _TRACE_VERSION:
+        raise ValueError(f"Unsupported traffic trace version: {header.get('version')}")
+    return [json.loads(line) for line in lines[1:]]
+
+
+def _decode(data: bytes) -> str:
+    return data.decode("utf-8", errors="replace")
+
+
+def _json_schema_key(schema_json: bytes) -> str:
+    canonical = json.dumps(json.loads(schema_json), sort_keys=True, separators=(",", ":"))
+    return "json:" + canonical
+
+
+def _schema_key_from_json(schema_json: str) -> str:
+    """Key a GenerationSchema by the name it was created with."""
+    data = json.loads(schema_json)
+    title = data.get("title") if isinstance(data, dict) else None
+    if title:
+        return "schema:" + title
+    return "json:" + json.dumps(data, sort_keys=True, separators=(",", ":"))
+
+
+def _dispatch(*args):
+    # The user info, which identifies the request, is the last argument
+    user_info = args[-1]
+    if isinstance(user_info, ctypes.c_void_p):
+        user_info = user_info.value
+    with _handlers_lock:
+        handler = _handlers.get(int(user_info or 0))
+    if handler is not None:
+        return handler(*args)
+
+
+def _dispatcher(callback_type):
+    """The dispatching callback of ``callback_type``, created on first use."""
+    with _handlers_lock:
+        if callback_type not in _dispatchers:
+            _dispatchers[callback_type] = callback_type(_dispatch)
+        return _dispatchers[callback_type]
+
+
+@contextlib.contextmanager
+def _patched_bindings(owner: str, replacements: Dict[str, Any]) -> Iterator[Dict[str, Any]]:
+    """Swap functions of the bindings module, restoring them on exit."""
+    global _active
+    from . import _ctypes_bindings as lib
+
+    with _active_lock:
+        if _active is not None:
+            raise RuntimeError(f"Cannot start {owner} while {_active} is active")
+        _active = owner
+    originals = {name: getattr(lib, name) for name in replacements}
+    try:
+        for name, function in replacements.items():
+            setattr(lib, name, function)
+        yield originals
+    finally:
+        for name, function in originals.items():
+            setattr(lib, name, function)
+        with _active_lock:
+            _active = None
+
+
+class TrafficRecorder:
+    """Writes the requests crossing the C boundary to a trace file.
+
+    Created by :func:`record_traffic`; not meant to be instantiated directly.
+
+    :ivar records_written: Number of requests written so far
+    :vartype records_written: int
+    """
+
+    def __init__(self, file, lib):
+        self._file = file
+        self._lib = lib
+        self._originals = {
+            name: getattr(lib, name)
+            for name in (*self._replacements(), *_RECORDER_HELPERS)
+        }
+        self._lock = threading.Lock()
+        self._session_tools: Dict[int, set] = {}
+        self._streams: Dict[int, tuple] = {}
+        self._tool_names: Dict[int, str] = {}
+        self._active: Dict[int, List[Dict[str, Any]]] = {}
+        self._tool_calls: Dict[tuple, Dict[str, Any]] = {}
+        self._response_callback = _dispatcher(lib.FMLanguageModelSessionResponseCallback)
+        self._structured_callback = _dispatcher(lib.FMLanguageModelSessionStructuredResponseCallback)
+        self._event_callback = _dispatcher(lib.FMLanguageModelSessionStreamEventCallback)
+        self._turn_callback = _dispatcher(lib.FMLanguageModelSessionTurnCallback)
+        self.records_written = 0
+
+    # MARK: Helpers
+
+    @staticmethod
+    def _addr(ptr) -> int:
+        if isinstance(ptr, ctypes.c_void_p):
+            return ptr.value or 0
+        return int(ptr or 0)
+
+    @staticmethod
+    def _keep_with(owner, callback):
+        """Keep a tool's wrapper alive exactly as long as the tool's own callback."""
+        owner._recorded_by = callback
+        return callback
+
+    def _handle(self, user_info, handler: Callable) -> None:
+        """Route the callbacks of the request with ``user_info`` to ``handler``."""
+        with _handlers_lock:
+            _handlers[self._addr(user_info)] = handler
+
+    def _done(self, user_info) -> None:
+        """Drop the handler after the request's final callback."""
+        with _handlers_lock:
+            _handlers.pop(self._addr(user_info), None)
+
+    def _schema_key(self, schema_ptr) -> str:
+        error_code = ctypes.c_int32()
+        error_description = ctypes.POINTER(ctypes.c_char)()
+        json_str = self._originals["FMGenerationSchemaGetJSONString"](
+            schema_ptr, ctypes.byref(error_code), ctypes.byref(error_description)
+        )
+        return _schema_key_from_json(str(json_str))
+
+    def _content_json(self, content_ptr) -> Any:
+        json_str = self._originals["FMGeneratedContentGetJSONString"](content_ptr)
+        return json.loads(str(json_str))
+
+    def _begin(self, session_ptr, prompt: bytes, schema: Optional[str]) -> Dict[str, Any]:
+        record = {
+            "prompt": _decode(prompt),
+            "schema": schema,
+            "tools": [],
+            "_start": time.monotonic(),
+        }
+        with self._lock:
+            self._active.setdefault(self._addr(session_ptr), []).append(record)
+        record["_session"] = self._addr(session_ptr)
+        return record
+
+    def _finish(self, record, status: int, output=None, error: Optional[str] = None):
+        with self._lock:
+            # Detach first, so tool calls can no longer be attached to the record
+            active = self._active.get(record["_session"], [])
+            active[:] = [other for other in active if other is not record]
+        record["elapsed"] = time.monotonic() - record.pop("_start")
+        del record["_session"]
+        record["status"] = status
+        if status:
+            record["error"] = error or ""
+        else:
+            record["output"] = output
+        for call in record["tools"]:
+            call.pop("_dispatched", None)
+        if not record["tools"]:
+            del record["tools"]
+        line = json.dumps(record, separators=(",", ":"))
+        with self._lock:
+            self._file.write(line + "\n")
+            self.records_written += 1
+
+    # MARK: Sessions and tools
+
+    def _track_session(self, ptr, tools, tool_count) -> None:
+        tool_addrs = {self._addr(tools[i]) for i in range(tool_count)} if tools else set()
+        with self._lock:
+            self._session_tools[self._addr(ptr)] = tool_addrs
+
+    def _create_session(self, model, instructions, tools, tool_count):
+        ptr = self._originals["FMLanguageModelSessionCreateFromSystemLanguageModel"](
+            model, instructions, tools, tool_count
+        )
+        self._track_session(ptr, tools, tool_count)
+        return ptr
+
+    def _create_session_from_transcript(self, model, transcript, length, tools, tool_count, code, desc):
+        ptr = self._originals["FMLanguageModelSessionCreateFromTranscriptJSON"](
+            model, transcript, length, tools, tool_count, code, desc
+        )
+        if ptr:
+            self._track_session(ptr, tools, tool_count)
+        return ptr
+
+    def _create_tool(self, name, description, parameters, callable_, cancel, timeout, code, desc):
+        tool_addr = [0]
+
+        def record_call(content_ptr, call_id):
+            try:
+                self._tool_call_started(tool_addr[0], call_id, content_ptr)
+            except Exception:
+                pass  # Recording must never break the call itself
+            return callable_(content_ptr, call_id)
+
+        wrapper = self._keep_with(callable_, type(callable_)(record_call))
+        ptr = self._originals["FMBridgedToolCreateWithTimeout"](
+            name, description, parameters, wrapper, cancel, timeout, code, desc
+        )
+        if ptr:
+            tool_addr[0] = self._addr(ptr)
+            with self._lock:
+                self._tool_names[tool_addr[0]] = _decode(name)
+        return ptr
+
+    def _create_batched_tool(
+        self, name, description, parameters, callable_, cancel, timeout, window, size, code, desc
+    ):
+        tool_addr = [0]
+
+        def record_calls(content_ptrs, call_ids, count):
+            try:
+                for i in range(count):
+                    self._tool_call_started(tool_addr[0], call_ids[i], content_ptrs[i])
+            except Exception:
+                pass  # Recording must never break the calls themselves
+            return callable_(content_ptrs, call_ids, count)
+
+        wrapper = self._keep_with(callable_, type(callable_)(record_calls))
+        ptr = self._originals["FMBridgedToolCreateBatched"](
+            name, description, parameters, wrapper, cancel, timeout, window, size, code, desc
+        )
+        if ptr:
+            tool_addr[0] = self._addr(ptr)
+            with self._lock:
+                self._tool_names[tool_addr[0]] = _decode(name)
+        return ptr
+
+    def _tool_call_started(self, tool: int, call_id: int, content_ptr):
+        arguments = self._content_json(content_ptr)
+        # Sessions can share a tool, so the native layer says which one made the call
+        session = self._addr(self._originals["FMBridgedToolGetCallSession"](tool, call_id))
+        now = time.monotonic()
+        with self._lock:
+            if session:
+                records = self._active.get(session, [])[:1]
+            else:
+                # Not made by a request: record it only if a single request can own it
+                records = [
+                    record
+                    for owner, tools in self._session_tools.items()
+                    if tool in tools
+                    for record in self._active.get(owner, [])
+                ]
+            if len(records) != 1:
+                return
+            record = records[0]
+            call = {
+                "at": now - record["_start"],
+                "name": self._tool_names.get(tool, ""),
+                "arguments": arguments,
+                "_dispatched": now,
+            }
+            record["tools"].append(call)
+            self._tool_calls[(tool, call_id)] = call
+
+    def _tool_call_finished(self, tool, call_id, output, failed: bool):
+        with self._lock:
+            call = self._tool_calls.pop((self._addr(tool), call_id), None)
+        if call is None:
+            return
+        now = time.monotonic()
+        call["output"] = _decode(output if isinstance(output, bytes) else bytes(output))
+        call["failed"] = failed
+        call["elapsed"] = now - call.pop("_dispatched", now)
+
+    def _finish_call(self, tool, call_id, output):
+        self._tool_call_finished(tool, call_id, output, failed=False)
+        return self._originals["FMBridgedToolFinishCall"](tool, call_id, output)
+
+    def _fail_call(self, tool, call_id, output):
+        self._tool_call_finished(tool, call_id, output, failed=True)
+        return self._originals["FMBridgedToolFailCall"](tool, call_id, output)
+
+    def _finish_calls(self, tool, call_ids, outputs, failed, count):
+        for i in range(count):
+            if outputs[i] is not None:
+                self._tool_call_finished(tool, call_ids[i], outputs[i], failed=bool(failed and failed[i]))
+        return self._originals["FMBridgedToolFinishCalls"](tool, call_ids, outputs, failed, count)
+
+    # MARK: Requests
+
+    def _respond(self, session, prompt, length, user_info, callback):
+        record = self._begin(session, ctypes.string_at(prompt, length), None)
+
+        def on_response(status, content, content_length, info):
+            self._done(info)
+            text = bytes(content[:content_length].data) if content and content_length else b""
+            self._finish(record, status, _decode(text), _decode(text))
+            return callback(status, content, content_length, info)
+
+        self._handle(user_info, on_response)
+        return self._originals["FMLanguageModelSessionRespondBytes"](
+            session, prompt, length, user_info, self._response_callback
+        )
+
+    def _handle_structured(self, record, user_info, callback) -> None:
+        def on_response(status, content_ptr, info):
+            self._done(info)
+            if status == 0 and content_ptr:
+                self._finish(record, status, self._content_json(content_ptr))
+            else:
+                # The structured callback carries the description in the content object
+                error = None
+                if content_ptr:
+                    try:
+                        error = str(self._content_json(content_ptr))
+                    except Exception:
+                        error = None
+                self._finish(record, status, error=error)
+            return callback(status, content_ptr, info)
+
+        self._handle(user_info, on_response)
+
+    def _respond_with_schema(self, session, prompt, length, schema, user_info, callback):
+        record = self._begin(session, ctypes.string_at(prompt, length), self._schema_key(schema))
+        self._handle_structured(record, user_info, callback)
+        return self._originals["FMLanguageModelSessionRespondBytesWithSchema"](
+            session, prompt, length, schema, user_info, self._structured_callback
+        )
+
+    def _respond_with_json_schema(self, session, prompt, length, schema_json, user_info, callback):
+        key = _json_schema_key(schema_json if isinstance(schema_json, bytes) else bytes(schema_json))
+        record = self._begin(session, ctypes.string_at(prompt, length), key)
+        self._handle_structured(record, user_info, callback)
+        return self._originals["FMLanguageModelSessionRespondBytesWithSchemaFromJSON"](
+            session, prompt, length, schema_json, user_info, self._structured_callback
+        )
+
+    def _stream(self, session, prompt, length):
+        ptr = self._originals["FMLanguageModelSessionStreamResponseBytes"](session, prompt, length)
+        with self._lock:
+            self._streams[self._addr(ptr)] = (session, ctypes.string_at(prompt, length))
+        return ptr
+
+    def _begin_stream(self, stream):
+        with self._lock:
+            session, prompt = self._streams.pop(self._addr(stream), (None, b""))
+        record = self._begin(session, prompt, None)
+        record["snapshots"] = []
+        return record
+
+    def _iterate(self, stream, user_info, callback):
+        record = self._begin_stream(stream)
+
+        def on_snapshot(status, content, content_length, info):
+            if status != 0:
+                self._done(info)
+                text = bytes(content[:content_length].data) if content and content_length else b""
+                self._finish(record, status, error=_decode(text))
+            elif content and content_length:
+                text = _decode(bytes(content[:content_length].data))
+                record["snapshots"].append([time.monotonic() - record["_start"], text])
+            else:
+                self._done(info)
+                snapshots = record["snapshots"]
+                self._finish(record, 0, snapshots[-1][1] if snapshots else "")
+            return callback(status, content, content_length, info)
+
+        self._handle(user_info, on_snapshot)
+        return self._originals["FMLanguageModelSessionResponseStreamIterate"](
+            stream, user_info, self._response_callback
+        )
+
+    def _iterate_events(self, stream, tools, tool_count, user_info, callback):
+        record = self._begin_stream(stream)
+        text = [""]
+
+        def on_event(status, event_type, payload, payload_length, info):
+            data = _decode(bytes(payload[:payload_length].data)) if payload and payload_length else ""
+            if event_type == 4:
+                self._done(info)  # Completion, with or without an error, is always last
+            if status != 0:
+                self._finish(record, status, error=data)
+            elif event_type in (0, 1):
+                text[0] = text[0] + data if event_type == 0 else data
+                record["snapshots"].append([time.monotonic() - record["_start"], text[0]])
+            elif event_type == 4:
+                self._finish(record, 0, text[0])
+            return callback(status, event_type, payload, payload_length, info)
+
+        self._handle(user_info, on_event)
+        return self._originals["FMLanguageModelSessionResponseStreamIterateEvents"](
+            stream, tools, tool_count, user_info, self._event_callback
+        )
+
+    def _enqueue(self, session, prompts, lengths, schemas, count, user_info, callback):
+        turns = [
+            (
+                ctypes.string_at(prompts[i], lengths[i]),
+                self._schema_key(schemas[i]) if schemas and schemas[i] else None,
+            )
+            for i in range(count)
+        ]
+        # Turns run back to back, so each is recorded from the end of the previous one
+        current = [self._begin(session, *turns[0])] if count else []
+
+        def on_turn(status, turn_index, content, content_length, structured_ptr, info):
+            if status != 0 or turn_index + 1 >= count:
+                self._done(info)
+            record = current[0]
+            text = _decode(bytes(content[:content_length].data)) if content and content_length else ""
+            if status != 0:
+                self._finish(record, status, error=text)
+            elif structured_ptr:
+                self._finish(record, 0, self._content_json(structured_ptr))
+            else:
+                self._finish(record, 0, text)
+            if status == 0 and turn_index + 1 < count:
+                current[0] = self._begin(session, *turns[turn_index + 1])
+            return callback(status, turn_index, content, content_length, structured_ptr, info)
+
+        self._handle(user_info, on_turn)
+        return self._originals["FMLanguageModelSessionEnqueue"](
+            session, prompts, lengths, schemas, count, user_info, self._turn_callback
+        )
+
+    def _replacements(self) -> Dict[str, Any]:
+        return {
+            "FMLanguageModelSessionCreateFromSystemLanguageModel": self._create_session,
+            "FMLanguageModelSessionCreateFromTranscriptJSON": self._create_session_from_transcript,
+            "FMBridgedToolCreateWithTimeout": self._create_tool,
+            "FMBridgedToolFinishCall": self._finish_call,
+            "FMBridgedToolFailCall": self._fail_call,
+            "FMBridgedToolCreateBatched": self._create_batched_tool,
+            "FMBridgedToolFinishCalls": self._finish_calls,
+            "FMLanguageModelSessionRespondBytes": self._respond,
+            "FMLanguageModelSessionRespondBytesWithSchema": self._respond_with_schema,
+            "FMLanguageModelSessionRespondBytesWithSchemaFromJSON": self._respond_with_json_schema,
+            "FMLanguageModelSessionStreamResponseBytes": self._stream,
+            "FMLanguageModelSessionResponseStreamIterate": self._iterate,
+            "FMLanguageModelSessionResponseStreamIterateEvents": self._iterate_events,
+            "FMLanguageModelSessionEnqueue": self._enqueue,
+        }
+
+
+@contextlib.contextmanager
+def record_traffic(path: "os.PathLike[str] | str") -> Iterator[TrafficRecorder]:
+    """Record every model request made inside the block to a trace file.
+
+    Requests are recorded at the C boundary, so everything above it (sessions,
+    streams, pipelines, tools) is captured without changes to your code. Use
+    :func:`replay_traffic` to serve the trace back later.
+
+    Tool calls are recorded for tools and sessions created inside the block,
+    including sessions restored with
+    :meth:`~apple_fm_sdk.LanguageModelSession.from_transcript`. Each call is
+    attributed to the request that made it, even when sessions share a tool.
+    Requests still running when the block exits are not written.
+
+    :param path: Where to write the trace. Names ending in ``.gz`` are
+        gzip-compressed.
+    :type path: Union[str, os.PathLike]
+    :yields: The recorder, whose ``records_written`` counts the requests written
+    :ytype: TrafficRecorder
+    :raises RuntimeError: If another recording or replay is already active
+
+    Example:
+        ::
+
+            import apple_fm_sdk as fm
+
+            with fm.record_traffic("traffic.jsonl.gz") as recorder:
+                session = fm.LanguageModelSession()
+                await session.respond("Summarize the release notes.")
+                async for chunk in session.stream_response("Write a haiku."):
+                    pass
+            print(f"Recorded {recorder.records_written} requests")
+    """
+    from . import _ctypes_bindings as lib
+
+    with _open_trace(path, "w") as trace_file:
+        header = {"format": _TRACE_FORMAT, "version": _TRACE_VERSION}
+        trace_file.write(json.dumps(header) + "\n")
+        recorder = TrafficRecorder(trace_file, lib)
+        with _patched_bindings("traffic recording", recorder._replacements()):
+            try:
+                yield recorder
+            finally:
+                with recorder._lock:
+                    # Requests still running finish without being recorded
+                    recorder._file = _DiscardFile()
+
+
+class _DiscardFile:
+    def write(self, data):
+        pass
+
+
+@contextlib.contextmanager
+def replay_traffic(
+    path: "os.PathLike[str] | str", speed: float = 1.0
+) -> Iterator[None]:
+    """Serve model requests made inside the block from a recorded trace.
+
+    Each request is matched to a recorded one by its prompt and schema. Requests
+    with the same prompt and schema are served in the order they were recorded.
+    Once they run out, the last one is served again. A request with no recorded
+    match fails with :class:`~apple_fm_sdk.FoundationModelsError`.
+
+    Recorded tool calls are replayed against the session's tools with the
+    recorded arguments, so tool code runs as it did when the trace was made.
+
+    Create the sessions and tools you replay against inside the block, and only
+    use them there. Objects created before it still belong to the native library.
+
+    To replay without the native library, for example on Linux, set the
+    ``APPLE_FM_SDK_REPLAY`` environment variable to the trace path (and
+    optionally ``APPLE_FM_SDK_REPLAY_SPEED``) before importing the package.
+
+    :param path: A trace written by :func:`record_traffic`
+    :type path: Union[str, os.PathLike]
+    :param speed: Playback speed relative to the recording. ``1.0`` reproduces
+        the original timing, ``2.0`` plays twice as fast, and ``0`` serves every
+        request as fast as possible.
+    :type speed: float
+    :raises ValueError: If ``speed`` is negative or the file is not a trace
+    :raises RuntimeError: If another recording or replay is already active
+
+    Example:
+        ::
+
+            import apple_fm_sdk as fm
+
+            with fm.replay_traffic("traffic.jsonl.gz", speed=0):
+                session = fm.LanguageModelSession()
+                summary = await session.respond("Summarize the release notes.")
+    """
+    from . import _ctypes_bindings as lib
+    from . import _replay_bindings
+    from .c_helpers import _drain_releases
+
+    backend = _replay_bindings._ReplayBackend(_load_trace(path), speed)
+    patched = False
+    try:
+        with _patched_bindings("traffic replay", backend.functions()) as originals:
+            patched = True
+            backend.originals = originals
+            try:
+                yield
+            finally:
+                _drain_releases()
+    finally:
+        if patched:
+            # Replay objects still alive are released after the natives are back
+            _replay_bindings._guard_memory_functions(lib)
@@ -1,11 +1,21 @@
 # For licensing see accompanying LICENSE file.
 # Copyright (C) 2026 Apple Inc. All Rights Reserved.
 
+import asyncio
+import io
+import os
 import json
 import ctypes
+from typing import BinaryIO, TextIO, Union
 
 from apple_fm_sdk.errors import _status_code_to_exception
-from apple_fm_sdk.c_helpers import _get_error_string
+from apple_fm_sdk.transcript_entries import TranscriptEntries
+from apple_fm_sdk.c_helpers import (
+    _get_error_string,
+    _register_handle,
+    _unregister_handle,
+    _safe_from_handle,
+)
 
 
 try:
@@ -16,6 +26,33 @@ except ImportError:
     )
 
 
+class _JSONLSink:
+    """Adapts a Python file object to the native JSONL write callback."""
+
+    def __init__(self, file):
+        self.file = file
+        self.text = isinstance(file, io.TextIOBase)
+        self.error = None
+
+    def write(self, line: bytes):
+        self.file.write(line.decode("utf-8") if self.text else line)
+
+
+@lib.FMTranscriptWriteCallback
+def _transcript_write_callback(data, length, sink_handle):
+    """Receives one encoded transcript line from the native exporter."""
+    sink = _safe_from_handle(sink_handle)
+    if sink is None:
+        return False
+    try:
+        # The buffer is not NUL-terminated and only valid for this call
+        sink.write(ctypes.string_at(data.raw, length))
+        return True
+    except BaseException as e:
+        sink.error = e
+        return False
+
+
 class Transcript:
     """Represents a foundation model session's transcript.
 
@@ -137,7 +174,9 @@ class Transcript:
     Note:
         - The transcript object shares the session's internal pointer
         - Transcripts are read-only; you cannot modify session history
-        - Large sessions may result in large transcript dictionaries
+        - Large sessions may result in large transcript dictionaries; use
+          :meth:`export_jsonl` to archive them without materializing the whole
+          transcript
         - The transcript format follows the Foundation Models Swift framework structure
         - Accessing the transcript does not affect the session state
 
@@ -200,6 +239,63 @@ class Transcript:
             - The returned dictionary is a snapshot; it won't update automatically
             - Call this function again to get an updated transcript after new interactions
         """
+        result = json.loads(self._get_json_bytes())
+        return result
+
+    async def entries(self) -> TranscriptEntries:
+        """Get the current transcript as typed, lazily decoded entries.
+
+        The native layer returns the transcript JSON together with the byte
+        range, ``role``, ``id`` and tool names of each entry, so no entry is
+        decoded up front. Each entry decodes its own part of the buffer only
+        when a field other than ``role``, ``id`` or ``tool_names`` is read,
+        which makes filtering large transcripts by role or tool name cheaper
+        than :meth:`to_dict`.
+
+        :return: The indexed entries
+        :rtype: TranscriptEntries
+        :raises GenerationError: If fetching the transcript fails due to an internal error
+
+        Example:
+            ::
+
+                import apple_fm_sdk as fm
+
+                session = fm.LanguageModelSession(tools=[WeatherTool()])
+                await session.respond("What's the weather in Cupertino?")
+
+                entries = await session.transcript.entries()
+                for output in entries.filter(tool_name="getWeather", role="tool"):
+                    print(output.text)
+
+        Note:
+            - Like :meth:`to_dict`, the result is a snapshot
+        """
+        error_code = ctypes.c_int32()
+        error_description = ctypes.POINTER(ctypes.c_char)()
+        index = ctypes.POINTER(ctypes.c_char)()
+        jsn_string = lib.FMLanguageModelSessionGetTranscriptJSONStringWithIndex(
+            self.session_ptr,
+            ctypes.byref(index),
+            ctypes.byref(error_code),
+            ctypes.byref(error_description),
+        )
+        # Each read of .data copies the buffer, so read it once
+        buffer = jsn_string.data if jsn_string is not None else None
+        if buffer is None:
+            err_code, err_desc = _get_error_string(error_code, error_description)
+            error_msg = "Failed to fetch session transcript"
+            if err_desc:
+                error_msg = error_msg + ": " + err_desc
+            raise _status_code_to_exception(err_code or error_code.value, error_msg)
+
+        try:
+            items = json.loads(ctypes.string_at(index))
+        finally:
+            lib.FMFreeString(index)
+        return TranscriptEntries._from_index(buffer, items)
+
+    def _get_json_bytes(self) -> bytes:
         error_code = ctypes.c_int32()  # C error status code
         error_description = ctypes.POINTER(
             ctypes.c_char
@@ -219,9 +315,109 @@ class Transcript:
                 error_msg = error_msg + ": " + err_desc
             raise _status_code_to_exception(err_code or error_code.value, error_msg)
 
-        # Successfully got the JSON string, parse it and free the C string
+        # Successfully got the JSON string
         # The return value is wrapped in a String object by ctypes
         # The String wrapper handles memory, so we don't need to manually free
-        json_str = str(jsn_string)
-        result = json.loads(json_str)
-        return result
+        return jsn_string.data
+
+    async def export_jsonl(
+        self, path_or_file: Union[str, "os.PathLike[str]", BinaryIO, TextIO]
+    ) -> int:
+        """Write the transcript as newline-delimited JSON, one entry per line.
+
+        Unlike :meth:`to_dict`, the transcript is never materialized as a
+        whole. The native layer walks the session's entries and encodes and
+        writes them one at a time, so memory use is bounded by the largest
+        single entry. Each line is one object from the ``entries`` list
+        described above.
+
+        When given a path, the file is created (or truncated) and written
+        directly by the native layer through its file descriptor. When given a
+        file object, each line is passed to its ``write`` method; both binary
+        and text mode files are supported.
+
+        :param path_or_file: Destination path, or a writable file object
+        :type path_or_file: Union[str, os.PathLike, BinaryIO, TextIO]
+        :return: Number of entries written
+        :rtype: int
+        :raises GenerationError: If encoding or writing the transcript fails
+        :raises OSError: If the destination file cannot be opened
+
+        Example:
+            ::
+
+                import apple_fm_sdk as fm
+
+                session = fm.LanguageModelSession()
+                await session.respond("Hello!")
+
+                count = await session.transcript.export_jsonl("session.jsonl")
+                print(f"Archived {count} entries")
+
+                # Entries can be read back one line at a time
+                with open("session.jsonl") as f:
+                    for line in f:
+                        entry = json.loads(line)
+                        print(entry["role"])
+
+        Note:
+            - Encoding and writing run in a worker thread, so the event loop
+              keeps running during the export. A file object's ``write``
+              method is called from that thread.
+            - If writing fails part-way through, the entries written so far are
+              left in the destination
+            - Exceptions raised by a file object's ``write`` method are
+              re-raised unchanged
+        """
+        if isinstance(path_or_file, (str, bytes, os.PathLike)):
+            return await asyncio.to_thread(self._export_jsonl_to_path, path_or_file)
+        return await asyncio.to_thread(self._export_jsonl_to_file, path_or_file)
+
+    def _export_jsonl_to_path(self, path) -> int:
+        with open(path, "wb") as f:
+            return self._export_jsonl_to_fd(f.fileno())
+
+    def _export_jsonl_to_fd(self, fd: int) -> int:
+        error_code = ctypes.c_int32()
+        error_description = ctypes.POINTER(ctypes.c_char)()
+        count = lib.FMLanguageModelSessionExportTranscriptJSONLToFileDescriptor(
+            self.session_ptr,
+            fd,
+            ctypes.byref(error_code),
+            ctypes.byref(error_description),
+        )
+        if count < 0:
+            self._raise_export_error(error_code, error_description)
+        return count
+
+    def _export_jsonl_to_file(self, file) -> int:
+        sink = _JSONLSink(file)
+        sink_handle = _register_handle(sink)
+        error_code = ctypes.c_int32()
+        error_description = ctypes.POINTER(ctypes.c_char)()
+        try:
+            count = lib.FMLanguageModelSessionExportTranscriptJSONL(
+                self.session_ptr,
+                sink_handle,
+                _transcript_write_callback,
+                ctypes.byref(error_code),
+                ctypes.byref(error_description),
+            )
+        finally:
+            _unregister_handle(sink_handle)
+        if sink.error is not None:
+            # Free the native abort description and surface the file object's
+            # own exception instead
+            _get_error_string(error_code, error_description)
+            raise sink.error
+        if count < 0:
+            self._raise_export_error(error_code, error_description)
+        return count
+
+    @staticmethod
+    def _raise_export_error(error_code, error_description):
+        err_code, err_desc = _get_error_string(error_code, error_description)
+        error_msg = "Failed to export session transcript"
+        if err_desc:
+            error_msg = error_msg + ": " + err_desc
+        raise _status_code_to_exception(err_code or error_code.value, error_msg)
@@ -0,0 +1,494 @@
+# For licensing see accompanying LICENSE file.
+# Copyright (C) 2026 Apple Inc. All Rights Reserved.
+
+"""
+Content-addressed storage for many transcripts.
+
+Sessions usually begin with the same instructions entry and tool definitions,
+so archiving each transcript on its own stores those entries over and over. A
+:class:`TranscriptArchive` stores every distinct entry once, keyed by the
+SHA-256 of its canonical JSON, and stores each transcript as a list of
+references to those entries. Entry and content ``id`` fields are unique per
+session and are kept with the references rather than hashed, so identical
+entries from different sessions share one stored copy.
+
+The archive is a single append-only file. Entries and transcripts are written
+as records, each compressed on its own, and an index of record offsets is
+written when the archive is closed. Reading a transcript seeks directly to
+its records, so any session can be read without scanning the file. If the
+archive was not closed cleanly, the index is rebuilt from the records.
+
+Example:
+    ::
+
+        import apple_fm_sdk as fm
+
+        with fm.TranscriptArchive("sessions.fmta", "a") as archive:
+            archive.add(session_id, await session.transcript.to_dict())
+
+        with fm.TranscriptArchive("sessions.fmta") as archive:
+            transcript = archive.get(session_id)
+            print(archive.stats())
+"""
+
+import hashlib
+import json
+import os
+import struct
+import threading
+import zlib
+from collections import OrderedDict
+from dataclasses import dataclass
+from typing import Any, Dict, Iterator, List, Optional, Tuple, Union
+
+_MAGIC = b"FMTARCH1"
+_TRAILER_MAGIC = b"FMTAIDX1"
+
+# kind, codec, payload length
+_RECORD_HEADER = struct.Struct("<BBI")
+# index record offset, trailer magic
+_TRAILER = struct.Struct("<Q8s")
+
+_KIND_ENTRY = ord("E")
+_KIND_TRANSCRIPT = ord("T")
+_KIND_INDEX = ord("I")
+
+_CODEC_NONE = 0
+_CODEC_ZLIB = 1
+
+_DIGEST_SIZE = hashlib.sha256().digest_size
+_BLOB_CACHE_SIZE = 256
+
+
+@dataclass(frozen=True)
+class ArchiveStats:
+    """Counts and sizes of a transcript archive.
+
+    :ivar sessions: Number of transcripts in the archive
+    :vartype sessions: int
+    :ivar entries: Number of entries across all transcripts
+    :vartype entries: int
+    :ivar unique_entries: Number of distinct entries actually stored
+    :vartype unique_entries: int
+    :ivar stored_bytes: Bytes used by entry and transcript records, including
+        replaced transcripts
+    :vartype stored_bytes: int
+    """
+
+    sessions: int
+    entries: int
+    unique_entries: int
+    stored_bytes: int
+
+    @property
+    def deduplication_ratio(self) -> float:
+        """Entries referenced per entry stored. Higher means more sharing."""
+        return self.entries / self.unique_entries if self.unique_entries else 1.0
+
+
+def _canonical(value: Any) -> bytes:
+    return json.dumps(
+        value, sort_keys=True, separators=(",", ":"), ensure_ascii=False
+    ).encode("utf-8")
+
+
+def _split_ids(entry: Dict[str, Any]) -> Tuple[Dict[str, Any], list]:
+    """Separate the per-session ids from an entry's shareable content.
+
+    Returns the entry without ids and a reference tail of the form
+    ``[entry_id, [content_id, ...]]``, where a missing id is None.
+    """
+    body = dict(entry)
+    entry_id = body.pop("id", None)
+    content_ids = None
+    contents = body.get("contents")
+    if isinstance(contents, list):
+        stripped = []
+        content_ids = []
+        for content in contents:
+            if isinstance(content, dict):
+                content = dict(content)
+                content_ids.append(content.pop("id", None))
+            else:
+                content_ids.append(None)
+            stripped.append(content)
+        body["contents"] = stripped
+    return body, [entry_id, content_ids]
+
+
+def _join_ids(body: Dict[str, Any], entry_id, content_ids) -> Dict[str, Any]:
+    if entry_id is not None:
+        body["id"] = entry_id
+    if content_ids is not None:
+        for content, content_id in zip(body["contents"], content_ids):
+            if content_id is not None:
+                content["id"] = content_id
+    return body
+
+
+class TranscriptArchive:
+    """A file of transcripts that stores each distinct entry once.
+
+    Transcripts are added as the dictionaries returned by
+    :meth:`Transcript.to_dict` and read back in the same shape. Adding a
+    session id that is already in the archive replaces its transcript.
+
+    :param path: Path of the archive file
+    :type path: Union[str, os.PathLike]
+    :param mode: ``"r"`` to read an existing archive, ``"a"`` to read and
+        append, creating the file if needed, or ``"w"`` to start a new archive
+    :type mode: str
+    :param compression: ``"zlib"`` to compress each record, or None to store
+        records uncompressed
+    :type compression: Optional[str]
+    :param compresslevel: zlib compression level, 0-9
+    :type compresslevel: int
+    :raises ValueError: If ``mode`` or ``compression`` is invalid, or the file
+        is not a transcript archive
+    :raises OSError: If the file cannot be opened
+
+    Example:
+        ::
+
+            import apple_fm_sdk as fm
+
+            with fm.TranscriptArchive("sessions.fmta", "a") as archive:
+                for session_id, session in sessions.items():
+                    archive.add(session_id, await session.transcript.to_dict())
+
+            with fm.TranscriptArchive("sessions.fmta") as archive:
+                for session_id in archive:
+                    entries = archive.get(session_id)["transcript"]["entries"]
+                    print(session_id, len(entries))
+
+    Note:
+        - Only one process should write to an archive at a time
+        - A replaced transcript stays in the file until the archive is
+          rewritten with :meth:`copy_to`
+    """
+
+    def __init__(
+        self,
+        path: Union[str, "os.PathLike[str]"],
+        mode: str = "r",
+        *,
+        compression: Optional[str] = "zlib",
+        compresslevel: int = 6,
+    ):
+        if mode not in ("r", "a", "w"):
+            raise ValueError(f"Invalid mode {mode!r}, expected 'r', 'a' or 'w'")
+        if compression not in ("zlib", None):
+            raise ValueError(f"Unsupported compression {compression!r}")
+
+        self.path = os.fspath(path)
+        self.mode = mode
+        self._codec = _CODEC_ZLIB if compression == "zlib" else _CODEC_NONE
+        self._compresslevel = compresslevel
+        self._lock = threading.Lock()
+        # digest -> offset of the entry record
+        self._blobs: Dict[bytes, int] = {}
+        # session id -> (offset of the transcript record, number of entries)
+        self._sessions: Dict[str, Tuple[int, int]] = {}
+        self._blob_cache: "OrderedDict[int, bytes]" = OrderedDict()
+        self._dirty = False
+        # Whether the file may hold an index or a partial record past _end
+        self._stale_tail = False
+
+        if mode == "w" or (mode == "a" and not os.path.exists(self.path)):
+            self._file = open(self.path, "w+b")
+            self._file.write(_MAGIC)
+            self._end = len(_MAGIC)
+            self._dirty = True
+            return
+
+        self._file = open(self.path, "rb" if mode == "r" else "r+b")
+        try:
+            if self._file.read(len(_MAGIC)) != _MAGIC:
+                raise ValueError(f"{self.path} is not a transcript archive")
+            if not self._load_index():
+                self._scan()
+        except BaseException:
+            self._file.close()
+            raise
+
+    def __enter__(self) -> "TranscriptArchive":
+        return self
+
+    def __exit__(self, exc_type, exc, tb):
+        self.close()
+
+    def __len__(self) -> int:
+        return len(self._sessions)
+
+    def __contains__(self, session_id: object) -> bool:
+        return session_id in self._sessions
+
+    def __iter__(self) -> Iterator[str]:
+        return iter(list(self._sessions))
+
+    def session_ids(self) -> List[str]:
+        """Get the ids of all transcripts, in the order they were last added.
+
+        :return: The session ids
+        :rtype: List[str]
+        """
+        return list(self._sessions)
+
+    def add(self, session_id: str, transcript: Dict[str, Any]) -> int:
+        """Add a transcript to the archive.
+
+        Entries already in the archive are not written again.
+
+        :param session_id: Key to store the transcript under
+        :type session_id: str
+        :param transcript: A transcript as returned by :meth:`Transcript.to_dict`
+        :type transcript: dict
+        :return: Number of entries that were new to the archive
+        :rtype: int
+        :raises ValueError: If the archive was opened for reading, or
+            ``transcript`` has no ``transcript.entries`` list
+        """
+        if self.mode == "r":
+            raise ValueError("Archive is opened for reading")
+        if not isinstance(session_id, str):
+            raise ValueError("session_id must be a string")
+        try:
+            entries = transcript["transcript"]["entries"]
+        except (KeyError, TypeError):
+            entries = None
+        if not isinstance(entries, list):
+            raise ValueError("transcript must contain a 'transcript.entries' list")
+
+        # Everything but the entries list is kept with the transcript record
+        envelope = dict(transcript)
+        envelope["transcript"] = {
+            key: value
+            for key, value in transcript["transcript"].items()
+            if key != "entries"
+        }
+
+        prepared = []
+        for entry in entries:
+            body, ids = _split_ids(entry)
+            encoded = _canonical(body)
+            prepared.append((hashlib.sha256(encoded).digest(), encoded, ids))
+
+        with self._lock:
+            self._check_open()
+            added = 0
+            refs = []
+            for digest, encoded, ids in prepared:
+                if digest not in self._blobs:
+                    self._blobs[digest] = self._append(_KIND_ENTRY, encoded, digest)
+                    added += 1
+                refs.append([digest.hex()] + ids)
+            record = _canonical(
+                {"session": session_id, "envelope": envelope, "entries": refs}
+            )
+            self._sessions.pop(session_id, None)
+            self._sessions[session_id] = (
+                self._append(_KIND_TRANSCRIPT, record),
+                len(refs),
+            )
+        return added
+
+    def get(self, session_id: str) -> Dict[str, Any]:
+        """Read a transcript back from the archive.
+
+        :param session_id: Key the transcript was stored under
+        :type session_id: str
+        :return: The transcript, in the shape returned by :meth:`Transcript.to_dict`
+        :rtype: dict
+        :raises KeyError: If no transcript is stored under ``session_id``
+        """
+        with self._lock:
+            self._check_open()
+            offset, _ = self._sessions[session_id]
+            _, record = self._read_record(offset)
+            data = json.loads(record)
+            entries = []
+            for digest_hex, entry_id, content_ids in data["entries"]:
+                body = json.loads(self._read_blob(bytes.fromhex(digest_hex)))
+                entries.append(_join_ids(body, entry_id, content_ids))
+
+        transcript = data["envelope"]
+        transcript["transcript"]["entries"] = entries
+        return transcript
+
+    def stats(self) -> ArchiveStats:
+        """Get the counts and sizes of the archive.
+
+        :return: The archive statistics
+        :rtype: ArchiveStats
+        """
+        with self._lock:
+            return ArchiveStats(
+                sessions=len(self._sessions),
+                entries=sum(count for _, count in self._sessions.values()),
+                unique_entries=len(self._blobs),
+                stored_bytes=self._end - len(_MAGIC),
+            )
+
+    def copy_to(
+        self, path: Union[str, "os.PathLike[str]"], **kwargs: Any
+    ) -> "TranscriptArchive":
+        """Write the live transcripts to a new archive, dropping replaced ones.
+
+        :param path: Path of the new archive, which is overwritten
+        :type path: Union[str, os.PathLike]
+        :param kwargs: Options for the new archive, as for :class:`TranscriptArchive`
+        :return: The new archive, open for adding more transcripts
+        :rtype: TranscriptArchive
+        """
+        target = TranscriptArchive(path, "w", **kwargs)
+        try:
+            for session_id in self.session_ids():
+                target.add(session_id, self.get(session_id))
+            target.flush()
+        except BaseException:
+            target.close()
+            raise
+        return target
+
+    def flush(self):
+        """Write the index so the archive can be opened without a scan.
+
+        Called automatically by :meth:`close`.
+        """
+        with self._lock:
+            self._check_open()
+            self._write_index()
+
+    def close(self):
+        """Write the index if anything was added, and close the file."""
+        with self._lock:
+            if self._file is None:
+                return
+            try:
+                self._write_index()
+            finally:
+                self._file.close()
+                self._file = None
+
+    def _check_open(self):
+        if self._file is None:
+            raise ValueError("Archive is closed")
+
+    def _encode(self, payload: bytes) -> bytes:
+        if self._codec == _CODEC_ZLIB:
+            return zlib.compress(payload, self._compresslevel)
+        return payload
+
+    def _append(self, kind: int, payload: bytes, prefix: bytes = b"") -> int:
+        data = prefix + self._encode(payload)
+        offset = self._end
+        if self._stale_tail:
+            # Drop the old index first so a crash cannot leave it looking valid
+            self._file.truncate(offset)
+            self._stale_tail = False
+        self._file.seek(offset)
+        self._file.write(_RECORD_HEADER.pack(kind, self._codec, len(data)))
+        self._file.write(data)
+        self._end = self._file.tell()
+        self._dirty = True
+        return offset
+
+    def _read_record(self, offset: int) -> Tuple[int, bytes]:
+        self._file.seek(offset)
+        kind, codec, length = _RECORD_HEADER.unpack(
+            self._file.read(_RECORD_HEADER.size)
+        )
+        data = self._file.read(length)
+        if kind == _KIND_ENTRY:
+            data = data[_DIGEST_SIZE:]
+        if codec == _CODEC_ZLIB:
+            data = zlib.decompress(data)
+        return kind, data
+
+    def _read_blob(self, digest: bytes) -> bytes:
+        offset = self._blobs[digest]
+        cached = self._blob_cache.get(offset)
+        if cached is not None:
+            self._blob_cache.move_to_end(offset)
+            return cached
+        _, data = self._read_record(offset)
+        self._blob_cache[offset] = data
+        if len(self._blob_cache) > _BLOB_CACHE_SIZE:
+            self._blob_cache.popitem(last=False)
+        return data
+
+    def _write_index(self):
+        if self.mode == "r" or not self._dirty:
+            return
+        index = _canonical(
+            {
+                "blobs": [[digest.hex(), offset] for digest, offset in self._blobs.items()],
+                "sessions": [
+                    [session_id, offset, count]
+                    for session_id, (offset, count) in self._sessions.items()
+                ],
+            }
+        )
+        index_offset = self._end
+        self._append(_KIND_INDEX, index)
+        self._file.write(_TRAILER.pack(index_offset, _TRAILER_MAGIC))
+        self._file.truncate()
+        self._file.flush()
+        # The next append replaces the index and trailer
+        self._end = index_offset
+        self._dirty = False
+        self._stale_tail = True
+
+    def _load_index(self) -> bool:
+        self._file.seek(0, os.SEEK_END)
+        size = self._file.tell()
+        if size < len(_MAGIC) + _TRAILER.size:
+            return False
+        self._file.seek(size - _TRAILER.size)
+        index_offset, magic = _TRAILER.unpack(self._file.read(_TRAILER.size))
+        if magic != _TRAILER_MAGIC or index_offset >= size:
+            return False
+        try:
+            kind, data = self._read_record(index_offset)
+            if kind != _KIND_INDEX:
+                return False
+            index = json.loads(data)
+        except (struct.error, zlib.error, ValueError):
+            return False
+        self._blobs = {bytes.fromhex(digest): offset for digest, offset in index["blobs"]}
+        self._sessions = {
+            session_id: (offset, count) for session_id, offset, count in index["sessions"]
+        }
+        self._end = index_offset
+        self._stale_tail = True
+        return True
+
+    def _scan(self):
+        """Rebuild the index from the records after an unclean close."""
+        self._file.seek(0, os.SEEK_END)
+        size = self._file.tell()
+        offset = len(_MAGIC)
+        while offset + _RECORD_HEADER.size <= size:
+            self._file.seek(offset)
+            kind, _, length = _RECORD_HEADER.unpack(
+                self._file.read(_RECORD_HEADER.size)
+            )
+            end = offset + _RECORD_HEADER.size + length
+            if end > size:
+                break
+            if kind == _KIND_ENTRY:
+                self._blobs.setdefault(self._file.read(_DIGEST_SIZE), offset)
+            elif kind == _KIND_TRANSCRIPT:
+                try:
+                    data = json.loads(self._read_record(offset)[1])
+                except (zlib.error, ValueError):
+                    break
+                self._sessions.pop(data["session"], None)
+                self._sessions[data["session"]] = (offset, len(data["entries"]))
+            elif kind != _KIND_INDEX:
+                break
+            offset = end
+        # A partial record at the end is dropped by the next append
+        self._end = offset
+        self._dirty = self.mode != "r"
+        self._stale_tail = True
@@ -0,0 +1,395 @@
+# For licensing see accompanying LICENSE file.
+# Copyright (C) 2026 Apple Inc. All Rights Reserved.
+
+"""
+Typed, lazily decoded views over transcript JSON.
+
+A :class:`TranscriptEntries` keeps, for each entry, its ``role``, ``id`` and
+tool names, and exposes the entry as a small :class:`TranscriptEntry`
+subclass with ``__slots__``. The native layer indexes the transcript JSON,
+reporting the byte range of each entry along with those fields, whether the
+transcript was fetched from a session with :meth:`Transcript.entries` or
+loaded from a buffer or file. An entry decodes its own slice of the buffer the
+first time a field outside the index is read, so filtering a large exported
+transcript only allocates the entries it returns.
+
+Both the envelope format produced by ``JSONEncoder().encode(transcript)`` in
+Swift and :meth:`Transcript.to_dict` and the one-entry-per-line format written
+by :meth:`Transcript.export_jsonl` are supported.
+
+Example:
+    ::
+
+        import apple_fm_sdk as fm
+
+        entries = fm.TranscriptEntries.load("session.jsonl")
+
+        for entry in entries.filter(role="user"):
+            print(entry.text)
+
+        for call in entries.filter(tool_name="getWeather"):
+            if isinstance(call, fm.ToolCallsEntry):
+                print(call.tool_calls)
+"""
+
+import ctypes
+import json
+import os
+from typing import (
+    Any,
+    Dict,
+    Iterator,
+    List,
+    Optional,
+    Sequence,
+    Tuple,
+    Type,
+    Union,
+    overload,
+)
+
+from . import _ctypes_bindings as lib
+from .c_helpers import _borrowed_bytes, _get_error_string
+
+
+def _text_of(contents: List[Dict[str, Any]]) -> str:
+    parts = []
+    for content in contents:
+        if content.get("type") == "text":
+            parts.append(content.get("text", ""))
+        elif content.get("type") == "structure":
+            structure = content.get("structure", {})
+            parts.append(json.dumps(structure.get("content", {})))
+    return " ".join(parts)
+
+
+class ToolCall:
+    """A single tool invocation requested by the model.
+
+    :param name: Name of the tool being called
+    :type name: str
+    :param arguments: Arguments as generated by the model. The Swift framework
+        encodes these as a JSON string.
+    :type arguments: Any
+    :param id: Identifier linking the call to its :class:`ToolOutputEntry`
+    :type id: str
+    """
+
+    __slots__ = ("name", "arguments", "id")
+
+    def __init__(self, name: str, arguments: Any, id: str):
+        self.name = name
+        self.arguments = arguments
+        self.id = id
+
+    def parsed_arguments(self) -> Any:
+        """Decode the arguments when they were encoded as a JSON string.
+
+        :return: The decoded arguments
+        :rtype: Any
+        """
+        if isinstance(self.arguments, str):
+            return json.loads(self.arguments)
+        return self.arguments
+
+    def __repr__(self) -> str:
+        return f"ToolCall(name={self.name!r}, id={self.id!r})"
+
+
+class TranscriptEntry:
+    """Base class for a single entry in a transcript.
+
+    ``role``, ``id`` and ``tool_names`` are read from the index built when the
+    transcript was loaded. Every other field decodes the entry's slice of the
+    underlying buffer on first access; the decoded object is then cached on
+    the entry.
+
+    Do not create entries directly; obtain them from :class:`TranscriptEntries`.
+    """
+
+    __slots__ = ("_entries", "_index", "_data")
+
+    def __init__(self, entries: "TranscriptEntries", index: int):
+        self._entries = entries
+        self._index = index
+        self._data: Optional[Dict[str, Any]] = None
+
+    @property
+    def role(self) -> str:
+        """The JSON role: ``instructions``, ``user``, ``response`` or ``tool``."""
+        return self._entries._roles[self._index]
+
+    @property
+    def id(self) -> str:
+        """The entry's unique identifier."""
+        return self._entries._ids[self._index]
+
+    @property
+    def tool_names(self) -> Tuple[str, ...]:
+        """Tool names referenced by this entry, without decoding it."""
+        return tuple(self._entries._tool_names[self._index])
+
+    def to_dict(self) -> Dict[str, Any]:
+        """Decode and return the entry as a dictionary.
+
+        :return: The entry in the same form as one element of
+            ``to_dict()["transcript"]["entries"]``
+        :rtype: Dict[str, Any]
+        """
+        if self._data is None:
+            self._data = json.loads(self._entries._raw(self._index))
+        return self._data
+
+    @property
+    def contents(self) -> List[Dict[str, Any]]:
+        """The entry's content segments."""
+        return self.to_dict().get("contents", [])
+
+    @property
+    def text(self) -> str:
+        """Text of all content segments, with structured content as JSON."""
+        return _text_of(self.contents)
+
+    def __repr__(self) -> str:
+        return f"{type(self).__name__}(id={self.id!r})"
+
+
+class InstructionsEntry(TranscriptEntry):
+    """Instructions given to the session, including tool definitions."""
+
+    __slots__ = ()
+
+    @property
+    def tools(self) -> List[Dict[str, Any]]:
+        """Tool definitions available to the model."""
+        return self.to_dict().get("tools", [])
+
+
+class PromptEntry(TranscriptEntry):
+    """A prompt sent to the model (JSON role ``user``)."""
+
+    __slots__ = ()
+
+    @property
+    def options(self) -> Dict[str, Any]:
+        """Generation options used for the request."""
+        return self.to_dict().get("options", {})
+
+    @property
+    def response_format(self) -> Optional[Dict[str, Any]]:
+        """The structured output schema requested, if any."""
+        return self.to_dict().get("responseFormat")
+
+
+class ResponseEntry(TranscriptEntry):
+    """Content generated by the model."""
+
+    __slots__ = ()
+
+    @property
+    def assets(self) -> List[str]:
+        """Model asset identifiers used to produce the response."""
+        return self.to_dict().get("assets", [])
+
+
+class ToolCallsEntry(TranscriptEntry):
+    """Tool invocations requested by the model (JSON role ``response``)."""
+
+    __slots__ = ()
+
+    @property
+    def tool_calls(self) -> List[ToolCall]:
+        """The tool calls, in the order the model made them."""
+        return [
+            ToolCall(call.get("name"), call.get("arguments"), call.get("id"))
+            for call in self.to_dict().get("toolCalls", [])
+        ]
+
+
+class ToolOutputEntry(TranscriptEntry):
+    """The result of a tool call (JSON role ``tool``)."""
+
+    __slots__ = ()
+
+    @property
+    def tool_name(self) -> Optional[str]:
+        """Name of the tool that produced the output, without decoding."""
+        names = self.tool_names
+        return names[0] if names else None
+
+    @property
+    def tool_call_id(self) -> Optional[str]:
+        """Identifier of the :class:`ToolCall` this output answers."""
+        return self.to_dict().get("toolCallID")
+
+
+_CLASS_FOR_ROLE: Dict[str, Type[TranscriptEntry]] = {
+    "instructions": InstructionsEntry,
+    "user": PromptEntry,
+    "response": ResponseEntry,
+    "tool": ToolOutputEntry,
+}
+
+
+class TranscriptEntries(Sequence[TranscriptEntry]):
+    """An indexed, read-only sequence of typed transcript entries.
+
+    Each entry's ``role``, ``id`` and tool names are held in an index, so
+    filtering by role or tool name never touches the entries' other fields.
+    Entries share the raw transcript buffer and are decoded individually on
+    first use.
+
+    :param data: The transcript JSON
+    :type data: Union[bytes, str]
+    :param jsonl: ``True`` if ``data`` holds one entry per line, as written by
+        :meth:`~apple_fm_sdk.transcript.Transcript.export_jsonl`; ``False`` if
+        it holds a full transcript object with ``transcript.entries``
+    :type jsonl: bool
+    :raises ValueError: If the buffer is not a transcript
+
+    Example:
+        ::
+
+            import apple_fm_sdk as fm
+
+            session = fm.LanguageModelSession()
+            await session.respond("Hello!")
+
+            entries = await session.transcript.entries()
+            for entry in entries:
+                if isinstance(entry, fm.ResponseEntry):
+                    print(entry.text)
+    """
+
+    __slots__ = ("_buffer", "_starts", "_ends", "_roles", "_ids", "_tool_names")
+
+    def __init__(self, data: Union[bytes, str], *, jsonl: bool = False):
+        if not isinstance(data, bytes):
+            # Entries slice the buffer, so keep an immutable copy
+            data = data.encode("utf-8") if isinstance(data, str) else bytes(data)
+        error_code = ctypes.c_int32()
+        error_description = ctypes.POINTER(ctypes.c_char)()
+        index = ctypes.POINTER(ctypes.c_char)()
+        with _borrowed_bytes(data) as (pointer, length):
+            count = lib.FMTranscriptIndexJSON(
+                pointer,
+                length,
+                jsonl,
+                ctypes.byref(index),
+                ctypes.byref(error_code),
+                ctypes.byref(error_description),
+            )
+        if count < 0:
+            _, description = _get_error_string(error_code, error_description)
+            raise ValueError(description or "Buffer is not a transcript")
+        try:
+            items = json.loads(ctypes.string_at(index))
+        finally:
+            lib.FMFreeString(index)
+        self._set_index(data, items)
+
+    @classmethod
+    def _from_index(cls, buffer: bytes, index: Sequence[list]) -> "TranscriptEntries":
+        """Wrap a transcript buffer indexed by the native layer.
+
+        :param buffer: The transcript JSON
+        :param index: ``[start, end, role, id, tool_names]`` for each entry,
+            where ``start`` and ``end`` are byte offsets into ``buffer``
+        """
+        entries = cls.__new__(cls)
+        entries._set_index(buffer, index)
+        return entries
+
+    def _set_index(self, buffer: bytes, index: Sequence[list]) -> None:
+        # One tuple per column: starts, ends, roles, ids and tool names
+        columns = tuple(zip(*index)) if index else ((),) * 5
+        self._starts, self._ends, self._roles, self._ids, self._tool_names = columns
+        self._buffer = buffer
+
+    @classmethod
+    def load(cls, path: Union[str, "os.PathLike[str]"]) -> "TranscriptEntries":
+        """Load a transcript file.
+
+        Files ending in ``.jsonl`` or ``.ndjson`` are read as one entry per
+        line; anything else as a full transcript object.
+
+        :param path: Path to the transcript file
+        :type path: Union[str, os.PathLike]
+        :return: The indexed entries
+        :rtype: TranscriptEntries
+        """
+        with open(path, "rb") as f:
+            data = f.read()
+        jsonl = os.fspath(path).endswith((".jsonl", ".ndjson"))
+        return cls(data, jsonl=jsonl)
+
+    def _raw(self, index: int) -> bytes:
+        return self._buffer[self._starts[index] : self._ends[index]]
+
+    def _make(self, index: int) -> TranscriptEntry:
+        role = self._roles[index]
+        if role == "response" and self._tool_names[index]:
+            cls: Type[TranscriptEntry] = ToolCallsEntry
+        else:
+            cls = _CLASS_FOR_ROLE.get(role, TranscriptEntry)
+        return cls(self, index)
+
+    def __len__(self) -> int:
+        return len(self._roles)
+
+    @overload
+    def __getitem__(self, index: int) -> TranscriptEntry: ...
+
+    @overload
+    def __getitem__(self, index: slice) -> List[TranscriptEntry]: ...
+
+    def __getitem__(self, index):
+        if isinstance(index, slice):
+            return [self._make(i) for i in range(*index.indices(len(self)))]
+        if index < 0:
+            index += len(self)
+        if not 0 <= index < len(self):
+            raise IndexError("transcript entry index out of range")
+        return self._make(index)
+
+    def __iter__(self) -> Iterator[TranscriptEntry]:
+        for index in range(len(self)):
+            yield self._make(index)
+
+    def filter(
+        self,
+        *,
+        role: Optional[str] = None,
+        tool_name: Optional[str] = None,
+        entry_type: Optional[Type[TranscriptEntry]] = None,
+    ) -> Iterator[TranscriptEntry]:
+        """Iterate over entries matching all of the given criteria.
+
+        Matching uses the index only; entries are not decoded.
+
+        :param role: JSON role to match: ``instructions``, ``user``,
+            ``response`` or ``tool``
+        :type role: Optional[str]
+        :param tool_name: Match tool call entries that call this tool and tool
+            output entries produced by it
+        :type tool_name: Optional[str]
+        :param entry_type: Match only entries of this class, for example
+            :class:`ToolCallsEntry`
+        :type entry_type: Optional[Type[TranscriptEntry]]
+        :return: Iterator over matching entries, in transcript order
+        :rtype: Iterator[TranscriptEntry]
+        """
+        roles = self._roles
+        tool_names = self._tool_names
+        for index in range(len(self)):
+            if role is not None and roles[index] != role:
+                continue
+            if tool_name is not None and tool_name not in tool_names[index]:
+                continue
+            entry = self._make(index)
+            if entry_type is not None and not isinstance(entry, entry_type):
+                continue
+            yield entry
+
+    def __repr__(self) -> str:
+        return f"TranscriptEntries({len(self)} entries)"
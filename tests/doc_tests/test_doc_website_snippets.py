@@ -651,6 +651,38 @@ async def test_streaming_with_context(model):
     print("✅ Streaming with context - PASSED")
 
 
+@pytest.mark.asyncio
+async def test_streaming_events(model):
+    """
+    Test from: docs/source/streaming.rst
+    Section: Streaming Events
+    """
+    print("\n=== Testing Streaming Events ===")
+
+    ##############################################################################
+    # From: docs/source/streaming.rst
+    # Section: Streaming Events
+    import apple_fm_sdk as fm
+
+    session = fm.LanguageModelSession()
+
+    async for event in session.stream_events("Tell me a short story"):
+        if isinstance(event, fm.TextDelta):
+            print(event.text, end="", flush=True)
+        elif isinstance(event, fm.ToolCallStarted):
+            print(f"\n[calling {event.name} with {event.arguments}]")
+        elif isinstance(event, fm.ToolCallFinished):
+            print(f"\n[{event.name} took {event.duration:.2f} s]")
+        elif isinstance(event, fm.Completed):
+            metrics = event.metrics
+            print(f"\nFirst text after {metrics.time_to_first_text or 0:.2f} s")
+            print(f"Finished after {metrics.duration:.2f} s")
+
+    ##############################################################################
+
+    print("✅ Streaming events - PASSED")
+
+
 # =============================================================================
 # TOOLS TESTS (from docs/source/tools.rst)
 # =============================================================================
@@ -696,6 +728,40 @@ async def test_tools_basic_tool_definition():
     print("✅ Basic tool definition - PASSED")
 
 
+@pytest.mark.asyncio
+async def test_tools_typed_arguments():
+    """
+    Test from: docs/source/tools.rst
+    Section: Creating a Tool - Typed arguments
+    """
+    print("\n=== Testing Typed Tool Arguments ===")
+
+    ##############################################################################
+    # From: docs/source/tools.rst
+    # Section: Typed arguments
+    import apple_fm_sdk as fm
+
+    @fm.generable("Weather query parameters")
+    class WeatherQuery:
+        location: str = fm.guide("City name")
+        units: str = fm.guide("Temperature units", anyOf=["celsius", "fahrenheit"])
+
+    class TypedWeatherTool(fm.Tool):
+        name = "WeatherTool"
+        description = "Provides weather information for a given location and units."
+
+        async def call(self, args: WeatherQuery) -> str:
+            temp = 72 if args.units == "fahrenheit" else 22
+            return f"The weather in {args.location} is {temp}°{args.units[0].upper()}"
+
+    ##############################################################################
+
+    tool = TypedWeatherTool()
+    result = await tool.call(WeatherQuery(location="Paris", units="celsius"))
+    assert "Paris" in result
+    print("✅ Typed tool arguments - PASSED")
+
+
 @pytest.mark.asyncio
 async def test_tools_using_with_sessions():
     """
@@ -799,6 +865,42 @@ async def test_tools_error_handling():
     print("✅ Tools error handling - PASSED")
 
 
+@pytest.mark.asyncio
+async def test_tools_timeouts():
+    """
+    Test from: docs/source/tools.rst
+    Section: Timeouts
+    """
+    print("\n=== Testing Tool Timeouts ===")
+
+    ##############################################################################
+    # From: docs/source/tools.rst
+    # Section: Timeouts
+    import asyncio
+    import apple_fm_sdk as fm
+
+    @fm.generable("Server status query")
+    class StatusQuery:
+        server: str = fm.guide("Server name")
+
+    class ServerStatusTool(fm.Tool):
+        name = "ServerStatusTool"
+        description = "Checks whether a server is up."
+        timeout = 5.0
+
+        async def call(self, args: StatusQuery) -> str:
+            await asyncio.sleep(0.1)  # Simulate a network request
+            return f"{args.server} is up"
+
+    ##############################################################################
+
+    tool = ServerStatusTool()
+    assert tool.timeout == 5.0
+    result = await tool.call(StatusQuery(server="db-1"))
+    assert result == "db-1 is up"
+    print("✅ Tool timeouts - PASSED")
+
+
 # =============================================================================
 # EVALUATION TESTS (from docs/source/evaluation.rst)
 # =============================================================================
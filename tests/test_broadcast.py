@@ -0,0 +1,89 @@
+# For licensing see accompanying LICENSE file.
+# Copyright (C) 2026 Apple Inc. All Rights Reserved.
+
+"""
+Test fan-out of one streamed response in apple_fm_sdk.broadcast.
+"""
+
+import asyncio
+
+import apple_fm_sdk as fm
+import pytest
+
+
+@pytest.mark.asyncio
+async def test_broadcast_subscribers(model):
+    """Test that fast, slow and late subscribers share one generation."""
+    print("\n=== Testing BroadcastStream Subscribers ===")
+
+    session = fm.LanguageModelSession(model=model)
+    entries_before = len((await session.transcript.to_dict())["transcript"]["entries"])
+
+    broadcast = session.broadcast_response("Write a short story about a lighthouse keeper.")
+    received = {}
+
+    async def follow(name, subscription, delay=0.0):
+        snapshots = []
+        async for text in subscription:
+            snapshots.append(text)
+            await asyncio.sleep(delay)
+        received[name] = (subscription, snapshots)
+
+    async def join_late():
+        while broadcast.snapshots < 2 and not broadcast.done:
+            await asyncio.sleep(0.001)
+        await follow("late", broadcast.subscribe())
+
+    await asyncio.gather(
+        follow("fast", broadcast.subscribe()),
+        follow("slow", broadcast.subscribe(), delay=0.05),
+        join_late(),
+    )
+    final = await broadcast.result()
+    assert final and broadcast.done
+    print(f"✓ {broadcast.snapshots} snapshots: {final[:50]}...")
+
+    for name, (subscription, snapshots) in received.items():
+        assert snapshots[-1] == final, f"{name} did not reach the final text"
+        assert subscription.position == broadcast.snapshots
+        assert subscription.received == len(snapshots)
+        print(f"✓ {name}: {subscription.received} received, {subscription.skipped} skipped")
+    assert received["late"][0].received <= broadcast.snapshots - 1
+    assert received["slow"][0].received <= received["fast"][0].received
+
+    entries = (await session.transcript.to_dict())["transcript"]["entries"]
+    assert len(entries) == entries_before + 2
+    print("✓ The response was generated once")
+
+    after = [text async for text in broadcast.subscribe()]
+    assert after == [final]
+    print("✓ Subscribing after the end yields the final text once")
+
+
+@pytest.mark.asyncio
+async def test_broadcast_close(model):
+    """Test that closing a broadcast stream ends every subscription."""
+    print("\n=== Testing BroadcastStream Close ===")
+
+    session = fm.LanguageModelSession(model=model)
+
+    async with session.broadcast_response("Count from 1 to 100.") as broadcast:
+        subscription = broadcast.subscribe()
+        first = await subscription.__anext__()
+        await broadcast.aclose()
+        remaining = [text async for text in subscription]
+    assert broadcast.done
+    assert len(remaining) <= 1
+    assert (await broadcast.result()).startswith(first[:1])
+    print(f"✓ Closed after {broadcast.snapshots} snapshots")
+
+    for _ in range(50):
+        if not session.is_responding:
+            break
+        await asyncio.sleep(0.1)
+    assert not session.is_responding
+    print("✓ Generation stopped")
+
+    stopped = session.broadcast_response("Count from 1 to 30, one number per line.", stop=["\n"])
+    assert "\n" not in await stopped.result()
+    print("✓ Stop sequences apply to broadcast streams")
@@ -0,0 +1,111 @@
+# For licensing see accompanying LICENSE file.
+# Copyright (C) 2026 Apple Inc. All Rights Reserved.
+
+"""
+Thread-safety stress tests for the Python/native bridge.
+
+These tests drive sessions, streams, tools and the bridge's shared state from
+many OS threads at once. They pass on regular CPython, but are meant to be run
+on a free-threaded build, where the GIL no longer serializes the bridge:
+
+    python3.13t -m pytest tests/test_free_threading.py -s
+"""
+
+import asyncio
+import gc
+import sys
+import threading
+from concurrent.futures import ThreadPoolExecutor
+
+import apple_fm_sdk as fm
+from apple_fm_sdk import c_helpers
+from tester_tools.tester_tools import SimpleCalculatorTool
+
+NUM_THREADS = 8
+
+
+def _gil_enabled() -> bool:
+    return getattr(sys, "_is_gil_enabled", lambda: True)()
+
+
+def _run_threads(target, count=NUM_THREADS):
+    """Run ``target(index)`` on ``count`` threads released at the same moment."""
+    barrier = threading.Barrier(count)
+
+    def run(index):
+        barrier.wait()
+        return target(index)
+
+    with ThreadPoolExecutor(max_workers=count) as executor:
+        return list(executor.map(run, range(count)))
+
+
+def test_shared_bridge_state_hammering():
+    """Hammer handle registration, IDs, deferred releases and stream completion."""
+    print("\n=== Testing Shared Bridge State Across Threads ===")
+    print(f"GIL enabled: {_gil_enabled()}")
+
+    def work(index):
+        ids = []
+        for i in range(500):
+            handle = c_helpers._register_handle(object())
+            assert c_helpers._safe_from_handle(handle) is not None
+            c_helpers._unregister_handle(handle)
+
+            content = fm.GeneratedContent(content_dict={"thread": index, "i": i})
+            ids.append(content.id)
+            del content
+        return ids
+
+    all_ids = [gid for ids in _run_threads(work) for gid in ids]
+    assert len(set(all_ids)) == len(all_ids), "GenerationIDs must be unique"
+    print(f"✓ {len(all_ids)} unique GenerationIDs across {NUM_THREADS} threads")
+
+    gc.collect()
+    c_helpers._drain_releases()
+    assert not c_helpers._pending_releases
+    print("✓ Deferred releases drained")
+
+    # Native and Python threads racing to end a stream: exactly one error wins
+    for _ in range(50):
+        callback = c_helpers.StreamingCallback()
+        errors = [fm.FoundationModelsError(f"error {i}") for i in range(NUM_THREADS)]
+        _run_threads(lambda i: callback._finish(errors[i]))
+        assert callback.error in errors
+        assert callback.queue.get_nowait() is None and callback.queue.empty()
+    print("✓ Concurrent stream completion records a single error")
+
+
+def test_concurrent_sessions_streams_and_tools(model):
+    """Run sessions, streams and a shared tool on one event loop per thread."""
+    print("\n=== Testing Concurrent Sessions, Streams and Tools ===")
+    print(f"GIL enabled: {_gil_enabled()}")
+
+    handles_before = len(c_helpers._active_handles)
+    shared_tool = SimpleCalculatorTool()
+
+    async def worker(index):
+        session = fm.LanguageModelSession(
+            instructions="You are a helpful assistant with access to tools.",
+            model=model,
+            tools=[shared_tool],
+        )
+        response = await session.respond(f"Use the calculator to add {index} and 1.")
+        chunks = [chunk async for chunk in session.stream_response("Say hello.")]
+        events = [event async for event in session.stream_events("Say goodbye.")]
+        assert isinstance(events[-1], fm.Completed)
+        return response, chunks[-1] if chunks else "", events[-1].text
+
+    results = _run_threads(lambda index: asyncio.run(worker(index)))
+    assert len(results) == NUM_THREADS
+    for response, streamed, evented in results:
+        assert isinstance(response, str) and isinstance(streamed, str)
+        assert isinstance(evented, str)
+    print(f"✓ {NUM_THREADS} threads each completed respond, stream and events")
+
+    stats = shared_tool.stats()
+    assert stats.in_flight == 0, "Shared tool has calls left in flight"
+    print(f"✓ Shared tool finished cleanly: {stats.calls} calls")
+
+    assert len(c_helpers._active_handles) == handles_before, "Leaked callback handles"
+    print("✓ No callback handles leaked")
@@ -7,6 +7,8 @@ Test Foundation Models Generable protocol behavior
 
 import apple_fm_sdk as fm
 import pytest
+from typing import List, Optional, Union
+from apple_fm_sdk import generable_utils, generation_schema
 
 
 def test_direct_subclass_raises_error():
@@ -66,3 +68,85 @@ def test_error_message_content():
     assert "@fm.generable()" in error_message or "decorator" in error_message
 
     print(f"✓ Error message is helpful: '{error_message}'")
+
+
+@fm.generable("A leaf")
+class Leaf:
+    text: str
+
+
+@fm.generable("A left branch")
+class LeftBranch:
+    leaf: Leaf
+
+
+@fm.generable("A right branch")
+class RightBranch:
+    leaves: List[Leaf]
+
+
+@fm.generable("A tree whose branches share a leaf type")
+class Tree:
+    left: LeftBranch
+    right: Optional[RightBranch]
+    either: Union[LeftBranch, RightBranch]
+
+
+def _nested_chain(depth: int):
+    """Build ``depth`` generable classes, each holding the previous one."""
+    levels = [fm.generable("Level 0")(type("Level0", (), {"__annotations__": {"value": str}}))]
+    for i in range(1, depth):
+        annotations = {"child": levels[-1], "siblings": List[levels[-1]]}
+        levels.append(fm.generable(f"Level {i}")(type(f"Level{i}", (), {"__annotations__": annotations})))
+    return levels
+
+
+def test_schema_graph_builds_each_class_once(monkeypatch):
+    """Test that nested generables are built once per schema and shared."""
+    print("\n=== Testing Schema Graph Construction ===")
+
+    built = []
+    original_build = generable_utils._SchemaGraphBuilder._build
+
+    def counting_build(self, cls_inner, description):
+        built.append(cls_inner.__name__)
+        return original_build(self, cls_inner, description)
+
+    monkeypatch.setattr(generable_utils._SchemaGraphBuilder, "_build", counting_build)
+
+    schema = Tree.generation_schema()
+    assert sorted(built) == ["Leaf", "LeftBranch", "RightBranch", "Tree"]
+    names = [nested.type_class.__name__ for nested in schema.dynamic_nested_types]
+    assert sorted(names) == ["Leaf", "LeftBranch", "RightBranch"]
+    print(f"✓ Diamond schema built each class once and references {names}")
+
+    # Every type argument of a union is referenced, and shared nodes are reused
+    left = next(n for n in schema.dynamic_nested_types if n.type_class is LeftBranch)
+    right = next(n for n in schema.dynamic_nested_types if n.type_class is RightBranch)
+    assert left.dynamic_nested_types[0] is right.dynamic_nested_types[0]
+    print("✓ Leaf schema is shared by both branches")
+
+    built.clear()
+    registered = []
+    add_reference = generation_schema.lib.FMGenerationSchemaAddReferenceSchema
+
+    def counting_add_reference(schema_ptr, reference_ptr):
+        registered.append(reference_ptr)
+        return add_reference(schema_ptr, reference_ptr)
+
+    monkeypatch.setattr(
+        generation_schema.lib, "FMGenerationSchemaAddReferenceSchema", counting_add_reference
+    )
+    levels = _nested_chain(10)
+    deep = levels[-1].generation_schema()
+    assert len(built) == 10, f"Expected 10 builds, got {len(built)}"
+    assert len(deep.dynamic_nested_types) == 9
+    assert {n.type_class.__name__ for n in deep.dynamic_nested_types} == {
+        f"Level{i}" for i in range(9)
+    }
+    print("✓ 10-level schema built with one visit per level")
+
+    # Levels 1 to 8 register their child; only the root registers all 9 levels
+    assert len(registered) == 8 + 9, f"Expected 17 registrations, got {len(registered)}"
+    assert [len(level.dynamic_nested_types) for level in deep.dynamic_nested_types] == [1] * 8 + [0]
+    print(f"✓ {len(registered)} native reference registrations for 10 levels")
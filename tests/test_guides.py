@@ -9,6 +9,7 @@ import apple_fm_sdk as fm
 from typing import List
 import pytest
 import re
+import json
 
 
 # Test class for anyOf guide
@@ -101,6 +102,13 @@ class ProductRegexGuide:
     product_code: str = fm.guide("Product code", regex=r"\d+")
 
 
+# Regex guide whose alternatives overlap: the first alternative matches a
+# prefix of values that only the second matches in full
+@fm.generable("Product with an overlapping regex")
+class ProductOverlappingRegex:
+    code: str = fm.guide("Product code", regex=r"\d+|\d+-\d+")
+
+
 # Test class combining multiple guide types
 @fm.generable("Product with combined constraints")
 class ProductCombinedGuides:
@@ -809,3 +817,67 @@ async def test_unsupported_guide_on_arrays(model):
                 generating=test_class,
             )
         print(f"✓ {description}: Correctly threw UnsupportedGuide error")
+
+
+def test_validate_many():
+    """Test checking stored documents against schema guides outside generation."""
+    print("\n=== Testing GenerationSchema.validate_many ===")
+
+    schema = ProductCombinedGuides.generation_schema()
+    valid = {
+        "name": "Lamp",
+        "category": "electronics",
+        "price": 25.0,
+        "features": ["dimmable", "LED", "USB"],
+        "rating": 4.5,
+        "tags": ["home"],
+    }
+    invalid = {
+        "name": "Lamp",
+        "category": "toys",
+        "price": 5.0,
+        "features": ["dimmable"],
+        "rating": 4.5,
+        "tags": [],
+    }
+    missing = {"name": "Lamp"}
+
+    results = schema.validate_many([valid, json.dumps(invalid), missing, b"{not json"])
+    assert len(results) == 4
+    assert results[0] == []
+    print("✓ Valid document has no violations")
+
+    guides = {(v.path, v.guide) for v in results[1]}
+    assert guides == {
+        ("category", "anyOf"),
+        ("price", "minimum"),
+        ("features", "count"),
+        ("tags", "minItems"),
+    }, f"Unexpected violations: {results[1]}"
+    print(f"✓ Invalid document: {sorted(guides)}")
+
+    assert {v.guide for v in results[2]} == {"required"}
+    assert len(results[2]) == 5
+    print("✓ Missing properties are reported as required")
+
+    assert [v.guide for v in results[3]] == ["json"]
+    print("✓ Malformed JSON is reported")
+
+    element_schema = ProductElementGuide.generation_schema()
+    violations = element_schema.validate(
+        {"ratings": [1, 7], "prices": [1.5, 0.0], "categories": ["tech", "garden"]}
+    )
+    assert {v.path for v in violations} == {"ratings[1]", "prices[1]", "categories[1]"}
+    print("✓ Element guides are checked per item")
+
+    # Regex guides match like generation: the whole value, with any alternative.
+    # A search anchored at the start would stop at "12" and reject "12-34".
+    regex_schema = ProductOverlappingRegex.generation_schema()
+    results = regex_schema.validate_many([{"code": "12"}, {"code": "12-34"}, {"code": "12-"}])
+    assert results[0] == [] and results[1] == [], f"Unexpected violations: {results}"
+    assert [(v.path, v.guide) for v in results[2]] == [("code", "regex")]
+    print("✓ Regex guides match the whole value with any alternative")
+
+    many = schema.validate_many(valid for _ in range(10000))
+    assert len(many) == 10000 and not any(many)
+    print("✓ Validated 10000 documents across native batches")
@@ -14,7 +14,11 @@ This test suite provides comprehensive coverage of:
 """
 
 import asyncio
+import collections
 import gc
+import json
+import os
+import uuid
 import weakref
 import apple_fm_sdk as fm
 import pytest
@@ -167,6 +171,197 @@ async def test_generated_content_deallocation():
     print("✓ GeneratedContent properly deallocated")
 
 
+def test_hot_objects_have_no_instance_dict():
+    """Verify frequently created objects are slotted and IDs are counter based."""
+    print("\n=== Testing __slots__ and GenerationID ===")
+
+    @fm.generable("A pet")
+    class Pet:
+        name: str
+
+    content = fm.GeneratedContent(content_dict={"name": "Rex"})
+    partial = Pet.PartiallyGenerated._from_generated_content(content)
+    objects = [
+        content,
+        content.id,
+        partial,
+        fm.GenerationGuide.anyOf(["a", "b"]),
+        fm.generation_property.Property(name="name", type_class=str),
+    ]
+    for obj in objects:
+        assert not hasattr(obj, "__dict__"), f"{type(obj).__name__} has a __dict__"
+    print("✓ Hot objects have no __dict__")
+
+    assert partial.name == "Rex" and partial.id == content.id
+    print("✓ PartiallyGenerated decodes from GeneratedContent")
+
+    first, second = fm.GenerationID(), fm.GenerationID()
+    assert first != second and first == first
+    assert len({first, second}) == 2
+    assert uuid.UUID(str(first)) != uuid.UUID(str(second))
+    print(f"✓ GenerationID formats as UUID: {first}")
+
+
+@pytest.mark.skipif(not hasattr(os, "fork"), reason="Requires os.fork")
+def test_generation_id_after_fork():
+    """Verify that GenerationIDs stay distinct and stable across a fork."""
+    print("\n=== Testing GenerationID After Fork ===")
+
+    before = fm.GenerationID()
+    text_before = str(before)
+    read_end, write_end = os.pipe()
+    pid = os.fork()
+    if pid == 0:
+        # Child: report the old ID's text and whether a new ID collides with it
+        try:
+            after = fm.GenerationID()
+            report = {
+                "before": str(before),
+                "after": str(after),
+                "equal": after == before,
+                "same_hash": hash(after) == hash(before),
+            }
+            os.write(write_end, json.dumps(report).encode("utf-8"))
+        finally:
+            os._exit(0)
+    os.close(write_end)
+    with os.fdopen(read_end) as f:
+        report = json.loads(f.read())
+    os.waitpid(pid, 0)
+
+    assert report["before"] == text_before
+    print("✓ IDs created before the fork keep their UUID in the child")
+    assert report["after"] != text_before
+    assert not report["equal"] and not report["same_hash"]
+    assert report["after"] not in {str(fm.GenerationID()) for _ in range(10)}
+    print("✓ IDs created in the child never match IDs from the parent")
+
+
+@pytest.mark.asyncio
+async def test_deferred_release_and_scope():
+    """Verify batched release of collected objects and fm.scope()."""
+    print("\n=== Testing Deferred Release and Scope ===")
+    from apple_fm_sdk import c_helpers
+
+    # Collected objects are queued and released in bulk by the background thread
+    contents = [fm.GeneratedContent(content_dict={"i": i}) for i in range(100)]
+    del contents
+    gc.collect()
+    for _ in range(100):
+        if not c_helpers._pending_releases:
+            break
+        await asyncio.sleep(0.01)
+    assert not c_helpers._pending_releases, "Deferred releases were not drained"
+    print("✓ Collected objects released in bulk")
+
+    released = []
+    original_release = c_helpers._release_many
+
+    def recording_release(ptrs):
+        released.append(list(ptrs))
+        original_release(ptrs)
+
+    c_helpers._release_many = recording_release
+    try:
+        kept = fm.GeneratedContent(content_dict={"kept": True})
+        with fm.scope():
+            outer = [fm.GeneratedContent(content_dict={"outer": i}) for i in range(10)]
+            outer_ptrs = [content._ptr for content in outer]
+            with fm.scope():
+                inner = fm.GeneratedContent(content_dict={"inner": 2})
+                inner_ptr = inner._ptr
+                weak_inner = weakref.ref(inner)
+                del inner
+            assert weak_inner() is None and [inner_ptr] in released
+            print("✓ Inner scope released its object on exit")
+
+            # Unused objects stay alive, and unreleased, until their scope exits
+            del outer
+            released.clear()
+            escaped = fm.GeneratedContent(content_dict={"escaped": 3})
+            assert not any(ptr in batch for batch in released for ptr in outer_ptrs)
+        assert any(set(outer_ptrs) <= set(batch) for batch in released)
+        print("✓ Outer scope released its unused objects in one call")
+    finally:
+        c_helpers._release_many = original_release
+
+    # Objects still referenced after a scope are left valid
+    assert escaped._ptr and escaped.value(int, for_property="escaped") == 3
+    assert kept._ptr and kept.value(bool, for_property="kept") is True
+    print("✓ Objects referenced after the scope stay valid")
+
+    with fm.scope():
+        schema = fm.GenerationSchema(type_class=object, description="Cached", properties=[])
+        content = fm.GeneratedContent(content_dict={"inside": True})
+    assert schema._ptr and content._ptr
+    assert content.value(bool, for_property="inside") is True
+    print("✓ A schema cached outside the scope survives it")
+
+    # Escaped objects are released once, when collected
+    weak_escaped = weakref.ref(escaped)
+    del escaped, content, schema
+    gc.collect()
+    assert weak_escaped() is None
+    print("✓ Scoped objects deallocate cleanly")
+
+    # Tasks started inside a scope own what they create
+    created = asyncio.Event()
+
+    async def make():
+        content = fm.GeneratedContent(content_dict={"task": 3})
+        created.set()
+        await asyncio.sleep(0.01)
+        return content
+
+    with fm.scope():
+        task = asyncio.create_task(make())
+        await created.wait()
+    from_task = await task
+    assert from_task._ptr and from_task.value(int, for_property="task") == 3
+    print("✓ Objects created by tasks started in a scope outlive it")
+
+
+def test_concurrent_release_draining():
+    """Verify that overlapping drains release every queued pointer exactly once."""
+    print("\n=== Testing Concurrent Release Draining ===")
+    from apple_fm_sdk import c_helpers
+
+    released = []
+
+    class RacingDeque(collections.deque):
+        """Runs a second drain inside the first pop, like a drainer on another thread."""
+
+        racing = True
+
+        def popleft(self):
+            if RacingDeque.racing:
+                RacingDeque.racing = False
+                c_helpers._drain_releases()
+            return super().popleft()
+
+    c_helpers._drain_releases()
+    original_release, original_pending = c_helpers._release_many, c_helpers._pending_releases
+    c_helpers._release_many = released.extend
+    queued = list(range(1, 101))
+    try:
+        c_helpers._pending_releases = RacingDeque(queued)
+        c_helpers._drain_releases()
+        assert sorted(released) == queued
+        print("✓ Overlapping drains release every pointer once")
+
+        released.clear()
+        RacingDeque.racing = True
+        c_helpers._pending_releases = RacingDeque(queued)
+        with fm.scope():
+            # Only the scope references the content, so it is released on exit
+            ptr = fm.GeneratedContent(content_dict={"scoped": True})._ptr
+        assert sorted(released) == sorted(queued + [ptr])
+        print("✓ A scope exit racing another drain releases its objects")
+    finally:
+        c_helpers._release_many = original_release
+        c_helpers._pending_releases = original_pending
+
+
 @pytest.mark.asyncio
 async def test_tool_deallocation():
     """Verify that Tool objects are deallocated."""
@@ -0,0 +1,170 @@
+# For licensing see accompanying LICENSE file.
+# Copyright (C) 2026 Apple Inc. All Rights Reserved.
+
+"""
+Test the map-reduce pipeline in apple_fm_sdk.pipeline.
+
+This test suite verifies:
+1. Chunking respects the token budget and preserves text
+2. map_reduce reduces a multi-chunk document to a single result
+3. map_reduce_stream reports progress for every stage
+4. Each map request runs on a new session without earlier chunks in context
+5. SessionPool hedges slow requests within its budget
+"""
+
+import apple_fm_sdk as fm
+import pytest
+
+
+def test_chunk_text_respects_budget():
+    """Test that chunk_text never exceeds the requested budget."""
+    print("\n=== Testing chunk_text - Budget ===")
+
+    paragraph = "The quick brown fox jumps over the lazy dog. " * 20
+    document = "\n\n".join([paragraph] * 10)
+    chunks = fm.chunk_text(document, max_tokens=100)
+
+    assert len(chunks) > 1, "Expected the document to be split"
+    for chunk in chunks:
+        assert fm.estimate_tokens(chunk) <= 100, f"Chunk over budget: {len(chunk)}"
+    print(f"✓ Split into {len(chunks)} chunks within budget")
+
+    # Every word survives chunking, in order
+    assert " ".join(chunks).split() == document.split()
+    print("✓ Chunks preserve the original text")
+
+
+def test_chunk_text_short_document():
+    """Test that short documents come back as a single chunk."""
+    assert fm.chunk_text("Hello world.", max_tokens=100) == ["Hello world."]
+    assert fm.chunk_text("", max_tokens=100) == []
+    with pytest.raises(ValueError):
+        fm.chunk_text("Hello", max_tokens=0)
+    print("✓ Short and empty documents handled")
+
+
+@pytest.mark.asyncio
+async def test_map_reduce_with_merge(model):
+    """Test map_reduce with a Python merge function."""
+    print("\n=== Testing map_reduce - merge ===")
+
+    document = "\n\n".join(
+        f"Section {i}: The team shipped feature {i} on schedule." for i in range(6)
+    )
+    result = await fm.map_reduce(
+        document,
+        map_prompt="Reply with one word describing this text:\n{chunk}",
+        merge=lambda parts: " | ".join(p.strip() for p in parts),
+        model=model,
+        concurrency=2,
+        chunk_tokens=20,
+    )
+
+    assert isinstance(result, str) and result, "Expected a non-empty merged result"
+    assert result.count("|") >= 1, "Expected several partials to be merged"
+    print(f"✓ Merged result: {result}")
+
+
+@pytest.mark.asyncio
+async def test_map_prompts_see_empty_transcript(model, monkeypatch):
+    """Test that each map request runs on a session of its own."""
+    print("\n=== Testing map_reduce - clean map context ===")
+
+    history = []
+    sessions = []
+    original_respond = fm.LanguageModelSession.respond
+
+    async def recording_respond(self, prompt, **kwargs):
+        entries = (await self.transcript.to_dict())["transcript"]["entries"]
+        history.append([entry["role"] for entry in entries])
+        sessions.append(self)  # Kept alive so that ids stay distinct
+        return await original_respond(self, prompt, **kwargs)
+
+    monkeypatch.setattr(fm.LanguageModelSession, "respond", recording_respond)
+
+    document = "\n\n".join(f"Chapter {i} introduces character {i}." for i in range(5))
+    await fm.map_reduce(
+        document,
+        map_prompt="Name the character in this text:\n{chunk}",
+        merge=lambda parts: parts,
+        model=model,
+        instructions="Answer briefly.",
+        concurrency=1,
+        chunk_tokens=15,
+    )
+
+    assert len(history) == len(fm.chunk_text(document, 15)) > 1
+    for roles in history:
+        assert roles == ["instructions"], roles
+    print(f"✓ {len(history)} map prompts ran on a transcript holding only instructions")
+
+    assert len({id(s) for s in sessions}) == len(history), "Expected one session per map request"
+    print("✓ Every map prompt ran on a session of its own")
+
+    # A pool, by contrast, keeps sharing its session between plain requests
+    pool = fm.SessionPool(size=1, model=model)
+    await pool.respond("Hello!")
+    await pool.respond("Hello again!")
+    assert pool.sessions_created == 1
+    print("✓ SessionPool requests reuse the session")
+
+
+@pytest.mark.asyncio
+async def test_map_reduce_stream_progress(model):
+    """Test that map_reduce_stream reports map, reduce and done events."""
+    print("\n=== Testing map_reduce_stream - progress ===")
+
+    document = "\n\n".join(f"Paragraph {i} is about topic {i}." for i in range(5))
+
+    stages = []
+    final = None
+    async for progress in fm.map_reduce_stream(
+        document,
+        map_prompt="Summarize in five words:\n{chunk}",
+        reduce_prompt="Combine these summaries into one sentence:\n{partials}",
+        model=model,
+        chunk_tokens=15,
+        fan_in=2,
+    ):
+        stages.append(progress.stage)
+        if progress.stage == "done":
+            final = progress.result
+
+    assert stages.count("map") >= 2, f"Expected several map events: {stages}"
+    assert "reduce" in stages, f"Expected reduce events: {stages}"
+    assert stages[-1] == "done"
+    assert isinstance(final, str) and final
+    print(f"✓ Stages: {stages}")
+    print(f"✓ Final: {final}")
+
+
+@pytest.mark.asyncio
+async def test_session_pool_hedging(model):
+    """Test that hedged requests race a second session within the budget."""
+    print("\n=== Testing SessionPool - hedging ===")
+
+    with pytest.raises(ValueError):
+        fm.SessionPool(size=2, hedge_budget=1.5)
+
+    # A zero budget never hedges, even with a zero hedge delay
+    pool = fm.SessionPool(size=2, model=model, hedge_budget=0.0)
+    for _ in range(3):
+        result = await pool.respond("Reply with the word 'ready'.", hedge_after=0.0)
+        assert isinstance(result, str) and result, "Expected a non-empty response"
+    assert pool.hedges_sent == 0, f"Zero budget sent {pool.hedges_sent} hedges"
+    print("✓ A zero hedge budget sends no hedges")
+
+    # Half a hedge of credit per request: every second request is hedged
+    pool = fm.SessionPool(size=2, model=model, hedge_budget=0.5)
+    result = await pool.respond("Reply with the word 'ready'.", hedge_after=0.0)
+    assert isinstance(result, str) and result, "Expected a non-empty response"
+    assert pool.hedges_sent == 0, "A new pool must not start with credit"
+    result = await pool.respond("Reply with the word 'again'.", hedge_after=0.0)
+    assert isinstance(result, str) and result, "Expected a non-empty response"
+    assert pool.hedges_sent == 1, f"Expected one hedge, got {pool.hedges_sent}"
+    print(f"✓ Hedged response: {result} (hedge won: {pool.hedges_won == 1})")
+
+    # Both sessions are back in the pool; the loser's session is replaced on reuse
+    assert pool._idle.qsize() == 2
+    assert pool.sessions_created <= 3, f"Created {pool.sessions_created} sessions"
+    print(f"✓ Pool recovered after hedging ({pool.sessions_created} sessions created)")
@@ -72,3 +72,42 @@ async def test_invalid_prompts(model):
             assert isinstance(e, fm.FoundationModelsError), (
                 f"{description}: Expected FoundationModelsError subclass, got {type(e)}"
             )
+
+
+@pytest.mark.asyncio
+async def test_bytes_like_prompts(model):
+    """Test that buffer-protocol prompts are accepted without re-encoding."""
+    import mmap
+    import tempfile
+
+    text = "What is the capital of France?"
+    prompts = [
+        (text.encode("utf-8"), "bytes"),
+        (bytearray(text.encode("utf-8")), "bytearray"),
+        (memoryview(text.encode("utf-8")), "memoryview"),
+        (memoryview(b"__" + text.encode("utf-8"))[2:], "memoryview slice"),
+        (b"Hello\x00World", "bytes with embedded null byte"),
+    ]
+
+    for prompt, description in prompts:
+        response = await fm.LanguageModelSession(model=model).respond(prompt)
+        assert isinstance(response, str), (
+            f"{description}: Expected string response, got {type(response)}"
+        )
+        print(f"✓ {description} prompt got a response")
+
+    # Memory-mapped documents are passed straight through as well
+    with tempfile.TemporaryFile() as f:
+        f.write(text.encode("utf-8"))
+        f.flush()
+        with mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ) as mm:
+            view = memoryview(mm)
+            try:
+                response = await fm.LanguageModelSession(model=model).respond(view)
+                assert isinstance(response, str)
+            finally:
+                view.release()
+    print("✓ mmap prompt got a response")
+
+    with pytest.raises(TypeError):
+        await fm.LanguageModelSession(model=model).respond(42)
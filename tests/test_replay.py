@@ -0,0 +1,157 @@
+# For licensing see accompanying LICENSE file.
+# Copyright (C) 2026 Apple Inc. All Rights Reserved.
+
+"""
+Test recording native model traffic and replaying it.
+"""
+
+import asyncio
+import io
+import json
+
+import apple_fm_sdk as fm
+import pytest
+from tester_schemas.schemas import Cat
+from tester_tools.tester_tools import SimpleCalculatorTool
+
+
+async def _conversation(model):
+    session = fm.LanguageModelSession(
+        instructions="You are a helpful assistant with access to tools.",
+        model=model,
+        tools=[SimpleCalculatorTool()],
+    )
+    text = await session.respond("Use the calculator to add 2 and 3.")
+    chunks = [chunk async for chunk in session.stream_response("Write a haiku.")]
+    cat = await session.respond("Describe a cat.", generating=Cat)
+    return text, chunks, cat.name
+
+
+@pytest.mark.asyncio
+async def test_record_and_replay(model, tmp_path):
+    """Test that a replayed conversation reproduces the recorded one."""
+    print("\n=== Testing Record and Replay ===")
+
+    trace = tmp_path / "traffic.jsonl.gz"
+    with fm.record_traffic(trace) as recorder:
+        recorded = await _conversation(model)
+    assert recorder.records_written == 3
+    print(f"✓ Recorded {recorder.records_written} requests")
+
+    with fm.replay_traffic(trace, speed=0):
+        replayed = await _conversation(model)
+    assert replayed == recorded
+    print("✓ Replayed text, stream and structured responses match")
+
+    with fm.replay_traffic(trace, speed=0):
+        session = fm.LanguageModelSession(model=model)
+        with pytest.raises(fm.FoundationModelsError):
+            await session.respond("A prompt that was never recorded.")
+    print("✓ Unrecorded prompt raises FoundationModelsError")
+
+
+@pytest.mark.asyncio
+async def test_replay_timing_and_tool_calls(tmp_path):
+    """Test that replay reproduces recorded tool calls and paces responses."""
+    print("\n=== Testing Replay Timing and Tool Calls ===")
+
+    trace = tmp_path / "traffic.jsonl"
+    record = {
+        "prompt": "Add 2 and 3.",
+        "schema": None,
+        "status": 0,
+        "output": "The answer is 5.",
+        "elapsed": 0.2,
+        "tools": [
+            {"at": 0.0, "name": "simple_calculator", "arguments": {"operation": "add", "a": 2, "b": 3}}
+        ],
+    }
+    trace.write_text(
+        json.dumps({"format": "apple-fm-sdk-trace", "version": 1})
+        + "\n"
+        + json.dumps(record)
+        + "\n"
+    )
+
+    with fm.replay_traffic(trace, speed=1.0):
+        tool = SimpleCalculatorTool()
+        session = fm.LanguageModelSession(tools=[tool])
+        loop = asyncio.get_running_loop()
+        started = loop.time()
+        response = await session.respond("Add 2 and 3.")
+        elapsed = loop.time() - started
+        assert tool.stats().calls == 1
+    assert response == "The answer is 5."
+    assert elapsed >= 0.15, f"Replay ignored recorded timing: {elapsed:.3f}s"
+    print(f"✓ Response replayed after {elapsed:.3f}s")
+    print("✓ Recorded tool call ran against the session's tool")
+
+    with pytest.raises(RuntimeError):
+        with fm.replay_traffic(trace), fm.replay_traffic(trace):
+            pass
+    print("✓ Nested replay is rejected")
+
+
+def _write_trace(path, records):
+    lines = [json.dumps({"format": "apple-fm-sdk-trace", "version": 1})]
+    lines += [json.dumps(record) for record in records]
+    path.write_text("\n".join(lines) + "\n")
+
+
+@pytest.mark.asyncio
+async def test_record_shared_tool(tmp_path):
+    """Test that each tool call is recorded once, on the request that made it."""
+    print("\n=== Testing Recording with a Shared Tool ===")
+    from apple_fm_sdk import _ctypes_bindings as lib
+    from apple_fm_sdk import traffic
+
+    def request(prompt, operation, at):
+        return {
+            "prompt": prompt,
+            "schema": None,
+            "status": 0,
+            "output": "Done.",
+            "elapsed": 0.3,
+            "tools": [
+                {"at": at, "name": "simple_calculator", "arguments": {"operation": operation, "a": 4, "b": 5}}
+            ],
+        }
+
+    source = tmp_path / "source.jsonl"
+    _write_trace(source, [request("Add 4 and 5.", "add", 0.0), request("Multiply 4 and 5.", "multiply", 0.1)])
+
+    trace = io.StringIO()
+    with fm.replay_traffic(source, speed=1.0):
+        # Record the replayed traffic, as record_traffic records native traffic
+        recorder = traffic.TrafficRecorder(trace, lib)
+        replaced = {name: getattr(lib, name) for name in recorder._replacements()}
+        dispatchers = len(traffic._dispatchers)
+        try:
+            for name, function in recorder._replacements().items():
+                setattr(lib, name, function)
+            tool = SimpleCalculatorTool()
+            first = fm.LanguageModelSession(tools=[tool])
+            # A restored session shares the tool with the first one
+            second = fm.LanguageModelSession.from_transcript(
+                await first.transcript.to_dict(), tools=[tool]
+            )
+            await asyncio.gather(
+                first.respond("Add 4 and 5."), second.respond("Multiply 4 and 5.")
+            )
+        finally:
+            for name, function in replaced.items():
+                setattr(lib, name, function)
+
+    records = {record["prompt"]: record for record in map(json.loads, trace.getvalue().splitlines())}
+    assert [call["arguments"]["operation"] for call in records["Add 4 and 5."]["tools"]] == ["add"]
+    assert [call["arguments"]["operation"] for call in records["Multiply 4 and 5."]["tools"]] == [
+        "multiply"
+    ]
+    assert records["Multiply 4 and 5."]["tools"][0]["output"] == "The result of 4 multiply 5 is 20"
+    print("✓ Concurrent calls to a shared tool are recorded once each")
+    print("✓ Tool calls on a restored session are recorded")
+
+    # Requests do not leave callback wrappers behind
+    assert len(traffic._dispatchers) == dispatchers
+    assert traffic._handlers == {}
+    print("✓ No per-request callback wrappers are kept")
@@ -0,0 +1,125 @@
+# For licensing see accompanying LICENSE file.
+# Copyright (C) 2026 Apple Inc. All Rights Reserved.
+
+"""
+Test column-oriented result storage in apple_fm_sdk.result_batch.
+"""
+
+from array import array
+from typing import List, Optional
+
+import apple_fm_sdk as fm
+import pytest
+
+
+@fm.generable("A product review")
+class Review:
+    rating: int = fm.guide("Rating out of five", range=(1, 5))
+    score: float
+    recommended: bool
+    summary: str
+    reviewer: Optional[str]
+    tags: List[str]
+
+
+def _review(i):
+    return {
+        "rating": i % 5 + 1,
+        "score": i / 4,
+        "recommended": i % 2 == 0,
+        "summary": f"Review {i} ✓",
+        "reviewer": None if i % 3 == 0 else f"user{i}",
+        "tags": [f"t{i}"] * (i % 3),
+    }
+
+
+def test_columns_from_mixed_sources():
+    """Test filling columns from GeneratedContent, instances and dictionaries."""
+    print("\n=== Testing ResultBatch Columns ===")
+
+    rows = [_review(i) for i in range(23)]
+    batch = fm.ResultBatch(Review)
+    assert batch.columns == ["rating", "score", "recommended", "summary", "reviewer", "tags"]
+
+    # Python rows first, so the native rows start part-way into a bitmap byte
+    batch.append(rows[0])
+    batch.append(Review(**rows[1]))
+    batch.append(fm.GeneratedContent(rows[2]))
+    batch.extend(fm.GeneratedContent(row) for row in rows[3:])
+    assert len(batch) == len(rows)
+    print(f"✓ Appended {len(batch)} rows")
+
+    assert batch.to_pydict() == {name: [row[name] for row in rows] for name in batch.columns}
+    assert batch.row(4) == rows[4]
+    print("✓ Columns decode to the appended values")
+
+    rating = batch.column("rating")
+    assert rating.data == array("q", [row["rating"] for row in rows])
+    assert rating.validity is None
+    assert batch.column("score").data.typecode == "d"
+    assert sum(batch.column("recommended").data) == sum(r["recommended"] for r in rows)
+    summary = batch.column("summary")
+    assert summary.offsets[-1] == len(summary.data)
+    assert summary.data[summary.offsets[5] : summary.offsets[6]].decode() == rows[5]["summary"]
+    print("✓ Raw buffers hold typed values and string offsets")
+
+    reviewer = batch.column("reviewer")
+    assert reviewer.null_count == sum(row["reviewer"] is None for row in rows)
+    assert len(reviewer.validity) == (len(rows) + 7) // 8
+    assert reviewer[0] is None and reviewer[1] == "user1"
+    print(f"✓ Validity bitmap marks {reviewer.null_count} nulls")
+
+    assert batch.nbytes > 0
+    print(f"✓ {batch.nbytes} bytes for {len(batch)} rows")
+
+
+def test_invalid_rows_are_rejected():
+    """Test that invalid rows raise and leave the batch unchanged."""
+    print("\n=== Testing ResultBatch Validation ===")
+
+    batch = fm.ResultBatch(Review.generation_schema())
+    batch.append(_review(1))
+
+    missing = _review(2)
+    del missing["summary"]
+    with pytest.raises(ValueError):
+        batch.append(missing)
+    with pytest.raises(ValueError):
+        batch.extend([fm.GeneratedContent(_review(3)), fm.GeneratedContent(missing)])
+    print("✓ Missing required properties raise ValueError")
+
+    wrong = dict(_review(4), rating=2.5)
+    with pytest.raises(ValueError):
+        batch.append(wrong)
+    with pytest.raises(fm.FoundationModelsError):
+        batch.append(fm.GeneratedContent(wrong))
+    print("✓ Values of the wrong type are rejected")
+
+    assert len(batch) == 1
+    assert all(len(batch.column(name)) == 1 for name in batch.columns)
+    print("✓ Failed appends leave every column aligned")
+
+    with pytest.raises(ValueError):
+        fm.ResultBatch(dict)
+
+
+@pytest.mark.asyncio
+async def test_batch_from_model_responses(model):
+    """Test collecting structured responses from the model into a batch."""
+    print("\n=== Testing ResultBatch with Model Responses ===")
+
+    @fm.generable("A rating of a product")
+    class Rating:
+        stars: int = fm.guide("Stars out of five", range=(1, 5))
+        summary: str
+
+    batch = fm.ResultBatch(Rating)
+    for product in ["a toaster", "a bicycle", "a novel"]:
+        session = fm.LanguageModelSession(model=model)
+        batch.append(
+            await session.respond(f"Rate {product}.", schema=Rating.generation_schema())
+        )
+
+    assert len(batch) == 3
+    assert all(1 <= stars <= 5 for stars in batch.column("stars").data)
+    print(f"✓ Stars: {batch.column('stars').to_list()}")
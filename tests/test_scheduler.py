@@ -0,0 +1,143 @@
+# For licensing see accompanying LICENSE file.
+# Copyright (C) 2026 Apple Inc. All Rights Reserved.
+
+"""
+Test fair-share admission of requests in apple_fm_sdk.scheduler.
+"""
+
+import asyncio
+import time
+
+import apple_fm_sdk as fm
+import pytest
+
+
+@pytest.mark.asyncio
+async def test_scheduler_fair_share(model):
+    """Test that an interactive tenant is not starved by a batch tenant."""
+    print("\n=== Testing FairScheduler Fair Share ===")
+
+    scheduler = fm.FairScheduler(quantum=0.001)
+    fm.set_scheduler(scheduler)
+    finished = []
+
+    async def ask(name, prompt):
+        session = fm.LanguageModelSession(model=model)
+        with fm.tenant(name):
+            await session.respond(prompt)
+        finished.append(name)
+
+    try:
+        batch = [
+            asyncio.create_task(ask("batch", f"Summarize document {i}."))
+            for i in range(6)
+        ]
+        await asyncio.sleep(0)
+        await ask("interactive", "Hello!")
+        await asyncio.gather(*batch)
+    finally:
+        fm.set_scheduler(None)
+
+    assert finished.index("interactive") <= 2, finished
+    print(f"✓ Interactive request finished at position {finished.index('interactive') + 1} of 7")
+
+    stats = scheduler.stats()
+    assert stats["batch"].requests == stats["batch"].completed == 6
+    assert stats["interactive"].requests == 1
+    assert stats["interactive"].max_wait <= stats["batch"].max_wait
+    assert stats["batch"].generation_seconds > 0
+    assert stats["batch"].waiting == stats["batch"].running == 0
+    print(
+        f"✓ Waits: interactive {stats['interactive'].max_wait * 1000:.1f} ms, "
+        f"batch up to {stats['batch'].max_wait * 1000:.1f} ms"
+    )
+
+    session = fm.LanguageModelSession(model=model)
+    chunks = [chunk async for chunk in session.stream_response("Count to 3.")]
+    assert chunks
+    assert scheduler.tenant_stats("default").requests == 0
+    print("✓ Requests are admitted directly once the scheduler is removed")
+
+
+@pytest.mark.asyncio
+async def test_scheduler_weights_and_quotas():
+    """Test weights, quotas, cancellation and nested slots."""
+    print("\n=== Testing FairScheduler Weights and Quotas ===")
+
+    scheduler = fm.FairScheduler(quantum=0.01)
+    scheduler.configure("heavy", weight=3.0)
+    order = []
+
+    async def work(name):
+        async with scheduler.slot(name):
+            order.append(name)
+            await asyncio.sleep(0.01)
+
+    await asyncio.gather(*(work(name) for name in ["light", "heavy"] * 12))
+    first = order[:12]
+    assert first.count("heavy") >= 2 * first.count("light"), order
+    print(f"✓ Weight 3 tenant got {first.count('heavy')} of the first 12 slots")
+
+    scheduler = fm.FairScheduler(quota_period=0.3)
+    scheduler.configure("limited", max_requests=2)
+    started = time.monotonic()
+    admitted = []
+
+    async def limited():
+        async with scheduler.slot("limited"):
+            admitted.append(time.monotonic() - started)
+
+    await asyncio.gather(limited(), limited(), limited())
+    assert admitted[1] < 0.2 <= admitted[2]
+    assert scheduler.tenant_stats("limited").throttled == 1
+    print(f"✓ Third request waited {admitted[2]:.2f} s for the quota")
+
+    with pytest.raises(ValueError):
+        scheduler.configure("limited", weight=0)
+
+    release = asyncio.Event()
+
+    async def hold():
+        async with scheduler.slot("a"):
+            async with scheduler.slot("a"):
+                pass
+            await release.wait()
+
+    holder = asyncio.create_task(hold())
+    await asyncio.sleep(0.01)
+    print("✓ A nested slot does not wait for itself")
+
+    waiter = asyncio.create_task(work("b"))
+    await asyncio.sleep(0.01)
+    assert scheduler.tenant_stats("b").waiting == 1
+    waiter.cancel()
+    with pytest.raises(asyncio.CancelledError):
+        await waiter
+    assert scheduler.tenant_stats("b").waiting == 0
+    print("✓ A cancelled request leaves the queue")
+
+    release.set()
+    await holder
+    assert scheduler.tenant_stats("a").requests == 1
+
+    # A task started inside a slot shares it only until the slot is released
+    started_inside = asyncio.Event()
+    parent_released = asyncio.Event()
+
+    async def spawned():
+        async with scheduler.slot("a"):
+            started_inside.set()
+        await parent_released.wait()
+        async with scheduler.slot("a"):
+            pass
+
+    async with scheduler.slot("a"):
+        child = asyncio.create_task(spawned())
+        await started_inside.wait()
+    requests = scheduler.tenant_stats("a").requests
+    parent_released.set()
+    await child
+    assert scheduler.tenant_stats("a").requests == requests + 1
+    print("✓ Work started in a slot is queued again once the slot is released")
+    await work("b")
+    assert scheduler.tenant_stats("b").completed == 1
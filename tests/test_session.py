@@ -5,6 +5,8 @@
 Tests for LanguageModelSession functionality.
 """
 
+import pytest
+
 
 def test_import_session():
     """Test that we can import LanguageModelSession and related classes."""
@@ -145,3 +147,45 @@ def test_session_initialization_options(model):
     print("✓ Created session with None tools")
 
     print("\n✓ All session initialization tests passed!")
+
+
+@pytest.mark.asyncio
+async def test_respond_many(model):
+    """Test pipelined turns with respond_many."""
+    print("\n=== Testing respond_many ===")
+
+    import apple_fm_sdk as fm
+
+    @fm.generable("A yes or no verdict")
+    class Verdict:
+        correct: bool = fm.guide("Whether the answer was correct")
+
+    session = fm.LanguageModelSession(model=model)
+    assert await session.respond_many([]) == []
+    print("✓ Empty pipeline returns no results")
+
+    answer, explanation, verdict = await session.respond_many(
+        [
+            "What is 12 plus 30? Reply with the number only.",
+            "Explain in one sentence how you got that.",
+            ("Was your first answer correct?", Verdict),
+        ]
+    )
+    assert isinstance(answer, str) and answer
+    assert isinstance(explanation, str) and explanation
+    assert isinstance(verdict, Verdict)
+    print(f"✓ Turn results: {answer!r}, {explanation!r}, {verdict}")
+
+    # Every turn was recorded in the same session, in order
+    prompts = [
+        entry.text
+        for entry in await session.transcript.entries()
+        if entry.role == "user"
+    ]
+    assert len(prompts) == 3, f"Expected 3 prompts in transcript, got {len(prompts)}"
+    assert "12 plus 30" in prompts[0]
+    print("✓ Turns recorded in the session transcript")
+
+    with pytest.raises(ValueError):
+        await session.respond_many([("Pick a number", int)])
+    print("✓ Non-generable turn types rejected")
@@ -0,0 +1,104 @@
+# For licensing see accompanying LICENSE file.
+# Copyright (C) 2026 Apple Inc. All Rights Reserved.
+
+"""
+Test restoring sessions from transcripts and the SessionManager lifecycle.
+"""
+
+import asyncio
+
+import apple_fm_sdk as fm
+import pytest
+
+
+@pytest.mark.asyncio
+async def test_session_from_transcript(model):
+    """Test that a restored session continues the saved conversation."""
+    print("\n=== Testing LanguageModelSession.from_transcript ===")
+
+    session = fm.LanguageModelSession(
+        instructions="You are a concise assistant.", model=model
+    )
+    await session.respond("My name is Robin.")
+    saved = await session.transcript.to_dict()
+
+    restored = fm.LanguageModelSession.from_transcript(saved, model=model)
+    assert await restored.transcript.to_dict() == saved
+    print("✓ Restored session starts with the saved entries")
+
+    await restored.respond("What is my name?")
+    entries = (await restored.transcript.to_dict())["transcript"]["entries"]
+    assert len(entries) == len(saved["transcript"]["entries"]) + 2
+    print(f"✓ Conversation continued to {len(entries)} entries")
+
+    with pytest.raises(fm.FoundationModelsError):
+        fm.LanguageModelSession.from_transcript(b"not a transcript")
+    print("✓ Invalid transcript raises FoundationModelsError")
+
+
+@pytest.mark.asyncio
+async def test_lru_eviction_and_restore(model):
+    """Test that the least recently used session is evicted and later restored."""
+    print("\n=== Testing SessionManager LRU Eviction ===")
+
+    manager = fm.SessionManager(
+        instructions="You are a concise assistant.", model=model, max_sessions=2
+    )
+    async with manager:
+        first = await manager.get("a")
+        await first.respond("Remember the number 7.")
+        await manager.get("b")
+        await manager.get("c")
+
+        assert "a" not in manager and len(manager) == 2
+        assert "a" in manager.store
+        print("✓ Least recently used session was evicted")
+
+        restored = await manager.get("a")
+        assert restored is not first
+        entries = (await restored.transcript.to_dict())["transcript"]["entries"]
+        assert [entry["role"] for entry in entries][-2:] == ["user", "response"]
+        assert "b" not in manager
+        print("✓ Evicted session was restored from its transcript")
+
+        async with manager.session("c") as session:
+            with pytest.raises(RuntimeError):
+                await manager.evict("c")
+            await manager.get("d")
+            await manager.get("e")
+            assert "c" in manager
+            assert await session.respond("Hello") is not None
+        print("✓ Sessions in use are not evicted")
+
+    stats = manager.stats()
+    assert stats.live == 0
+    assert stats.created == 5 and stats.restored == 1
+    print(f"✓ {stats.created} created, {stats.restored} restored, {stats.evicted} evicted")
+
+
+@pytest.mark.asyncio
+async def test_idle_and_age_eviction(model, tmp_path):
+    """Test idle and age limits, with an archive as the transcript store."""
+    print("\n=== Testing SessionManager Idle and Age Eviction ===")
+
+    with fm.TranscriptArchive(tmp_path / "sessions.fmta", "w") as archive:
+        manager = fm.SessionManager(model=model, idle_timeout=0.2, store=archive)
+        async with manager:
+            await manager.get("idle")
+            await asyncio.sleep(0.5)
+            assert "idle" not in manager
+            assert "idle" in archive
+        print("✓ Background sweep evicted the idle session")
+
+        manager = fm.SessionManager(model=model, max_age=0.1, store=archive)
+        session = await manager.get("old")
+        await asyncio.sleep(0.15)
+        assert await manager.get("old") is not session
+        assert manager.stats().restored == 1
+        assert await manager.sweep() == 0
+        await manager.close()
+        print("✓ Session past its maximum age was replaced on access")
+
+    with pytest.raises(ValueError):
+        fm.SessionManager(max_sessions=0)
+    print("✓ Invalid limits are rejected")
@@ -0,0 +1,49 @@
+# For licensing see accompanying LICENSE file.
+# Copyright (C) 2026 Apple Inc. All Rights Reserved.
+
+"""
+Test the stream latency benchmark as a gate on the streaming path.
+"""
+
+import json
+import os
+import subprocess
+import sys
+from pathlib import Path
+
+BENCHMARK = Path(__file__).resolve().parent.parent / "benchmarks" / "stream_latency.py"
+
+
+def test_stream_latency_gate(tmp_path):
+    """Test that scripted streams reach the consumer promptly and completely."""
+    print("\n=== Testing Stream Latency Benchmark ===")
+
+    results_path = tmp_path / "results.json"
+    # The benchmark serves its own trace, so it runs in a fresh interpreter
+    env = dict(os.environ, PYTHONPATH=os.pathsep.join(sys.path))
+    completed = subprocess.run(
+        [
+            sys.executable,
+            str(BENCHMARK),
+            "--rates", "100",
+            "--concurrency", "1", "4",
+            "--chunks", "20",
+            "--no-histograms",
+            "--max-lag-p99", "50",
+            "--json", str(results_path),
+        ],
+        env=env,
+        capture_output=True,
+        text=True,
+        timeout=120,
+    )
+    print(completed.stdout)
+    assert completed.returncode == 0, completed.stdout + completed.stderr
+
+    results = json.loads(results_path.read_text())["results"]
+    assert len(results) == 4
+    for result in results:
+        assert result["dropped"] == 0
+        assert result["received"] == 20 * result["concurrency"]
+        assert sum(result["lag_histogram"]) == result["received"]
+    print(f"✓ {len(results)} scenarios within the 50 ms lag gate")
@@ -5,6 +5,8 @@
 Tests for streaming response functionality.
 """
 
+import json
+
 import apple_fm_sdk as fm
 import pytest
 
@@ -40,3 +42,127 @@ async def test_streaming(model):
         f"Expected string response, got {type(full_response)}"
     )
     print("Full response:", full_response)
+
+
+@pytest.mark.asyncio
+async def test_stream_events(model):
+    """Test typed stream events for text, tool calls and completion."""
+    print("\n=== Testing Stream Events ===")
+
+    from tester_tools.tester_tools import SimpleCalculatorTool
+
+    session = fm.LanguageModelSession(
+        instructions="You are a helpful assistant with access to tools.",
+        model=model,
+        tools=[SimpleCalculatorTool()],
+    )
+
+    events = []
+    text = ""
+    async for event in session.stream_events("Use the calculator to add 10 and 5."):
+        events.append(event)
+        if isinstance(event, fm.TextDelta):
+            text = event.text if event.replaces else text + event.text
+
+    print(f"✓ Received {len(events)} events")
+    assert isinstance(events[-1], fm.Completed), "Last event should be Completed"
+    assert sum(isinstance(e, fm.Completed) for e in events) == 1
+    completed = events[-1]
+    assert completed.text == text, "Deltas should add up to the final text"
+    print(f"✓ Deltas reassemble the response: {text[:50]}...")
+
+    started = [e for e in events if isinstance(e, fm.ToolCallStarted)]
+    finished = [e for e in events if isinstance(e, fm.ToolCallFinished)]
+    assert [e.call_id for e in started] == [e.call_id for e in finished]
+    for start, finish in zip(started, finished):
+        assert start.name == finish.name == "simple_calculator"
+        assert finish.duration >= 0 and finish.outcome == "success"
+        assert events.index(start) < events.index(finish)
+    print(f"✓ {len(started)} tool call(s) reported in order")
+
+    metrics = completed.metrics
+    assert metrics.tool_calls == len(finished)
+    assert metrics.duration >= metrics.tool_seconds >= 0
+    if text:
+        assert 0 <= metrics.time_to_first_text <= metrics.duration
+    print(f"✓ Metrics: {metrics}")
+
+
+@pytest.mark.asyncio
+async def test_stream_stop_conditions(model):
+    """Test ending streams early with stop sequences and a predicate."""
+    print("\n=== Testing Stream Stop Conditions ===")
+
+    prompt = "Count from 1 to 30, one number per line."
+
+    session = fm.LanguageModelSession(model=model)
+    chunks = [c async for c in session.stream_response(prompt, stop=["\n"])]
+    assert chunks and "\n" not in chunks[-1]
+    assert not session.is_responding
+    print(f"✓ Stop sequence ended the stream at: {chunks[-1]!r}")
+
+    session = fm.LanguageModelSession(model=model)
+    chunks = [
+        c async for c in session.stream_response(prompt, until=lambda text: len(text) >= 20)
+    ]
+    assert len(chunks[-1]) >= 20
+    assert all(len(chunk) < 20 for chunk in chunks[:-1])
+    print(f"✓ Predicate ended the stream after {len(chunks)} snapshots")
+
+    session = fm.LanguageModelSession(model=model)
+    text = ""
+    async for event in session.stream_events(prompt, stop=["\n"]):
+        if isinstance(event, fm.TextDelta):
+            text = event.text if event.replaces else text + event.text
+    assert isinstance(event, fm.Completed)
+    assert event.text == text and "\n" not in text
+    print(f"✓ Stream events stopped: {event.stopped}")
+
+
+@pytest.mark.asyncio
+async def test_stream_stop_ends_generation(tmp_path):
+    """Test that a stopped stream frees its session for the next request, under replay."""
+    print("\n=== Testing Stream Stop Ends Generation ===")
+
+    # Generation would run for a second after the stop without an explicit stop
+    count = {
+        "prompt": "Count to five.",
+        "schema": None,
+        "status": 0,
+        "output": "1\n2\n3\n4\n5",
+        "elapsed": 1.0,
+        "snapshots": [[0.01 * i, "\n".join(map(str, range(1, i + 1)))] for i in range(1, 6)],
+    }
+    greeting = {"prompt": "Hello.", "schema": None, "status": 0, "output": "Hi.", "elapsed": 0.0}
+    trace = tmp_path / "traffic.jsonl"
+    trace.write_text(
+        "\n".join(
+            json.dumps(line)
+            for line in ({"format": "apple-fm-sdk-trace", "version": 1}, count, greeting)
+        )
+        + "\n"
+    )
+
+    with fm.replay_traffic(trace, speed=1.0):
+        session = fm.LanguageModelSession()
+
+        chunks = [c async for c in session.stream_response("Count to five.", stop=["\n"])]
+        assert chunks[-1] == "1"
+        assert not session.is_responding
+        assert await session.respond("Hello.") == "Hi."
+        print("✓ Stop sequence stopped generation")
+
+        chunks = [
+            c async for c in session.stream_response("Count to five.", until=lambda text: "2" in text)
+        ]
+        assert chunks[-1] == "1\n2"
+        assert not session.is_responding
+        assert await session.respond("Hello.") == "Hi."
+        print("✓ Predicate stopped generation")
+
+        async for event in session.stream_events("Count to five.", stop=["\n3"]):
+            pass
+        assert isinstance(event, fm.Completed) and event.stopped and event.text == "1\n2"
+        assert not session.is_responding
+        assert await session.respond("Hello.") == "Hi."
+        print("✓ Stream events stopped generation")
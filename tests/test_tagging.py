@@ -0,0 +1,170 @@
+# For licensing see accompanying LICENSE file.
+# Copyright (C) 2026 Apple Inc. All Rights Reserved.
+
+"""
+Test the high-throughput content tagging pipeline.
+"""
+
+import asyncio
+import itertools
+import json
+
+import apple_fm_sdk as fm
+import pytest
+
+LABELS = ["weather", "sports", "food", "technology"]
+
+TEXTS = [
+    "It is going to rain all weekend.",
+    "The home team won the final in overtime.",
+    "This ramen shop makes its own noodles.",
+    "The new phone has a faster chip.",
+    "Snow is expected in the mountains tonight.",
+    "She ran the marathon in under three hours.",
+]
+
+
+# The tags recorded for each text, in the order of TEXTS
+TOPICS = ["weather", "sports", "food", "technology", "weather", "sports"]
+SENTIMENTS = ["negative", "positive", "positive", "positive", "neutral", "positive"]
+
+
+@fm.generable("Topic and sentiment of a text")
+class TextTags:
+    topic: str = fm.guide("Main topic", anyOf=LABELS)
+    sentiment: str = fm.guide("Sentiment", anyOf=["positive", "neutral", "negative"])
+
+
+def _write_trace(path, schema, outputs, elapsed=None):
+    """Write a replay trace answering each text of TEXTS with its output."""
+    elapsed = elapsed or {}
+    records = [
+        {"prompt": text, "schema": schema, "status": 0, "output": output, "elapsed": elapsed.get(text, 0.0)}
+        for text, output in zip(TEXTS, outputs)
+    ]
+    lines = [json.dumps({"format": "apple-fm-sdk-trace", "version": 1})]
+    lines += [json.dumps(record) for record in records]
+    path.write_text("\n".join(lines) + "\n")
+
+
+@pytest.mark.asyncio
+async def test_tag_many_with_labels(tmp_path):
+    """Test tagging with a label set, in input order, under replay."""
+    print("\n=== Testing tag_many with Labels ===")
+
+    trace = tmp_path / "traffic.jsonl"
+    # Later texts finish first, so results must be reordered
+    elapsed = {text: 0.05 * (len(TEXTS) - i) for i, text in enumerate(TEXTS)}
+    _write_trace(trace, "schema:Tags", [{"tags": [topic]} for topic in TOPICS], elapsed)
+
+    with fm.replay_traffic(trace, speed=1.0):
+        run = fm.tagging.tag_many(TEXTS, labels=LABELS, max_tags=2, concurrency=3)
+        results = [result async for result in run]
+
+    assert [r.index for r in results] == list(range(len(TEXTS)))
+    assert [r.text for r in results] == TEXTS
+    assert [r.error for r in results] == [None] * len(TEXTS)
+    assert [r.tags for r in results] == [[topic] for topic in TOPICS]
+    assert all(r.value == r.tags for r in results)
+    print(f"✓ Tags in input order: {[r.tags for r in results]}")
+
+    stats = run.stats
+    assert stats.completed == len(TEXTS) and stats.failed == 0
+    assert stats.characters == sum(map(len, TEXTS))
+    assert stats.items_per_second > 0
+    print(f"✓ {stats.processed} texts at {stats.items_per_second:.1f} texts/s")
+
+
+@pytest.mark.asyncio
+async def test_tag_many_with_schema_unordered(tmp_path):
+    """Test tagging with a Generable schema, in completion order, under replay."""
+    print("\n=== Testing tag_many with a Schema ===")
+
+    trace = tmp_path / "traffic.jsonl"
+    outputs = [{"topic": t, "sentiment": s} for t, s in zip(TOPICS, SENTIMENTS)]
+    _write_trace(trace, "schema:TextTags", outputs, {TEXTS[0]: 0.2})
+
+    with fm.replay_traffic(trace, speed=1.0):
+        # A generator input is consumed lazily by the workers
+        texts = (text for text in TEXTS)
+        run = fm.tagging.tag_many(texts, schema=TextTags, ordered=False, concurrency=2)
+        results = [result async for result in run]
+
+    # The slow first text does not hold back the others
+    assert results[-1].index == 0, [r.index for r in results]
+    assert sorted(r.index for r in results) == list(range(len(TEXTS)))
+    for result in sorted(results, key=lambda r: r.index):
+        assert result.error is None, result.error
+        assert isinstance(result.value, TextTags)
+        assert result.tags is None
+        assert (result.value.topic, result.value.sentiment) == (
+            TOPICS[result.index],
+            SENTIMENTS[result.index],
+        )
+    assert run.stats.completed == len(TEXTS) and run.stats.failed == 0
+    print(f"✓ Tagged {run.stats.completed} texts, {run.stats.failed} failed")
+
+    with pytest.raises(RuntimeError):
+        async for _ in run:
+            pass
+    print("✓ A run can only be iterated once")
+
+
+@pytest.mark.asyncio
+async def test_tag_many_bounded_read_ahead(tmp_path):
+    """Test that a slow text or consumer does not buffer an endless input."""
+    print("\n=== Testing tag_many Read-Ahead ===")
+
+    trace = tmp_path / "traffic.jsonl"
+    _write_trace(trace, "schema:Tags", [{"tags": [topic]} for topic in TOPICS], {TEXTS[0]: 0.3})
+    # Only the first text is slow; replay answers its repeats with this record
+    fast = {"prompt": TEXTS[0], "schema": "schema:Tags", "status": 0, "output": {"tags": ["weather"]}}
+    with open(trace, "a") as f:
+        f.write(json.dumps(fast) + "\n")
+
+    read = 0
+
+    def endless():
+        nonlocal read
+        for text in itertools.cycle(TEXTS):
+            read += 1
+            yield text
+
+    concurrency = 2
+    limit = concurrency * 4
+    with fm.replay_traffic(trace, speed=1.0):
+        # The slow first text holds back an ordered run
+        run = fm.tagging.tag_many(endless(), labels=LABELS, concurrency=concurrency)
+        async for result in run:
+            assert result.index == 0
+            assert read <= limit + 1, f"Read {read} texts ahead of a slow text"
+            print(f"✓ Read {read} texts while the first was tagged")
+
+            # A consumer that does not ask for more also pauses reading
+            await asyncio.sleep(0.2)
+            assert read <= limit + 1, f"Read {read} texts ahead of a slow consumer"
+            print(f"✓ Read {read} texts while the consumer was busy")
+            break
+
+
+@pytest.mark.asyncio
+async def test_tag_many_early_exit_and_validation(model):
+    """Test stopping a run early and argument validation."""
+    print("\n=== Testing tag_many Early Exit and Validation ===")
+
+    run = fm.tagging.tag_many(TEXTS * 4, labels=LABELS, concurrency=2)
+    async for result in run:
+        assert result.index == 0
+        break
+    assert run.stats.processed < len(TEXTS) * 4
+    print(f"✓ Stopped after {run.stats.processed} texts")
+
+    with pytest.raises(ValueError):
+        fm.tagging.tag_many(TEXTS)
+    with pytest.raises(ValueError):
+        fm.tagging.tag_many(TEXTS, labels=LABELS, schema=TextTags)
+    with pytest.raises(ValueError):
+        fm.tagging.tag_many(TEXTS, labels=["a", "a"])
+    with pytest.raises(ValueError):
+        fm.tagging.tag_many(TEXTS, labels=LABELS, concurrency=0)
+    print("✓ Invalid arguments are rejected")
@@ -21,10 +21,13 @@ import apple_fm_sdk as fm
 import pytest
 from tester_tools.tester_tools import (
     SimpleCalculatorTool,
+    TypedCalculatorTool,
     GetUserInfoTool,
     ProcessListTool,
     ErrorRaisingTool,
     AsyncDelayTool,
+    HangingTool,
+    BatchedUserInfoTool,
     CalculatorParams,
     UserInfoParams,
 )
@@ -230,6 +233,231 @@ async def test_tool_async_behavior():
     print(f"✓ Concurrent execution completed in {elapsed:.2f}s")
 
 
+@pytest.mark.asyncio
+async def test_tool_timeout(model):
+    """Test that a tool call exceeding its timeout is failed and cancelled."""
+    print("\n=== Testing Tool Timeout ===")
+
+    # Timeouts must be positive
+    class InvalidTimeoutTool(HangingTool):
+        timeout = 0
+
+    with pytest.raises(ValueError):
+        InvalidTimeoutTool()
+    print("✓ Non-positive timeout rejected")
+
+    hanging_tool = HangingTool()
+    session = fm.LanguageModelSession(
+        instructions="You are a helpful assistant with access to tools.",
+        tools=[hanging_tool],
+    )
+
+    # The request must not hang even though the tool never returns
+    try:
+        response = await asyncio.wait_for(
+            session.respond("You MUST use the hanging tool to check server 7."),
+            timeout=60,
+        )
+        print(f"✓ Session responded after tool timeout: {response}")
+    except fm.FoundationModelsError as e:
+        print(f"✓ Session failed after tool timeout: {e}")
+
+    if hanging_tool.started.is_set():
+        # Give the cancellation a moment to reach the tool's event loop
+        for _ in range(50):
+            if hanging_tool.cancelled:
+                break
+            await asyncio.sleep(0.1)
+        assert hanging_tool.cancelled, "Timed-out tool coroutine was not cancelled"
+        print("✓ Timed-out tool coroutine was cancelled")
+    else:
+        print("✓ Model did not invoke the tool")
+
+
+def _hanging_tool_trace(path, elapsed, status=0, error=""):
+    """Write a replay trace whose only request calls ``hanging_tool`` at once."""
+    record = {
+        "prompt": "Check server 7.",
+        "schema": None,
+        "status": status,
+        "error": error,
+        "output": "Server 7 is up.",
+        "elapsed": elapsed,
+        "tools": [{"at": 0.0, "name": "hanging_tool", "arguments": {"user_id": 7}}],
+    }
+    path.write_text(
+        json.dumps({"format": "apple-fm-sdk-trace", "version": 1})
+        + "\n"
+        + json.dumps(record)
+        + "\n"
+    )
+
+
+async def _wait_for_cancel(tool, seconds=2.0):
+    """Wait for a tool's coroutine to see its cancellation and return how long it took."""
+    loop = asyncio.get_running_loop()
+    started = loop.time()
+    while not tool.cancelled and loop.time() - started < seconds:
+        await asyncio.sleep(0.01)
+    return loop.time() - started
+
+
+@pytest.mark.asyncio
+async def test_tool_timeout_replay(tmp_path):
+    """Test that a forced tool call times out natively and cancels the tool, under replay."""
+    print("\n=== Testing Tool Timeout - replay ===")
+
+    class QuickHangingTool(HangingTool):
+        timeout = 0.3
+
+    trace = tmp_path / "traffic.jsonl"
+    _hanging_tool_trace(
+        trace, elapsed=0.0, status=255, error="Tool 'hanging_tool' timed out after 0.3 seconds"
+    )
+
+    with fm.replay_traffic(trace, speed=1.0):
+        tool = QuickHangingTool()
+        session = fm.LanguageModelSession(tools=[tool])
+        loop = asyncio.get_running_loop()
+        started = loop.time()
+        with pytest.raises(fm.FoundationModelsError):
+            await session.respond("Check server 7.")
+        elapsed = loop.time() - started
+
+        assert tool.started.is_set(), "The trace did not call the tool"
+        assert tool.timeout <= elapsed < tool.timeout + 0.5, f"Timed out after {elapsed:.3f}s"
+        print(f"✓ Call timed out after {elapsed:.3f}s")
+
+        await _wait_for_cancel(tool)
+        assert tool.cancelled, "Timed-out tool coroutine did not see CancelledError"
+        print("✓ Tool coroutine saw CancelledError")
+
+        stats = tool.stats()
+        assert stats.calls == 1 and stats.timeouts == 1, stats
+        assert stats.errors == 0 and stats.cancellations == 0 and stats.in_flight == 0, stats
+        print("✓ Timeout counted in the tool's stats")
+
+
+@pytest.mark.asyncio
+async def test_tool_call_cancelled_with_request(tmp_path):
+    """Test that cancelling a request abandons its pending tool call, under replay."""
+    print("\n=== Testing Tool Call Cancellation - replay ===")
+
+    trace = tmp_path / "traffic.jsonl"
+    _hanging_tool_trace(trace, elapsed=5.0)
+
+    with fm.replay_traffic(trace, speed=1.0):
+        tool = HangingTool()
+        session = fm.LanguageModelSession(tools=[tool])
+        request = asyncio.ensure_future(session.respond("Check server 7."))
+        assert await asyncio.to_thread(tool.started.wait, 5), "The trace did not call the tool"
+
+        loop = asyncio.get_running_loop()
+        cancelled_at = loop.time()
+        request.cancel()
+        with pytest.raises(asyncio.CancelledError):
+            await request
+        await _wait_for_cancel(tool)
+        waited = loop.time() - cancelled_at
+        # Well before the tool's own one-second timeout
+        assert tool.cancelled and waited < 0.5, f"Tool still running after {waited:.3f}s"
+        print(f"✓ Pending call was abandoned and the tool cancelled after {waited:.3f}s")
+
+        stats = tool.stats()
+        assert stats.calls == 1 and stats.cancellations == 1, stats
+        assert stats.timeouts == 0 and stats.in_flight == 0, stats
+        assert not session.is_responding
+        print("✓ Cancellation counted and the session is free again")
+
+
+@pytest.mark.asyncio
+async def test_tool_stats(model):
+    """Test per-tool call telemetry and the global registry."""
+    print("\n=== Testing Tool Stats ===")
+
+    # Histogram percentiles and merging work on snapshots
+    a = fm.ToolStats(
+        name="t", calls=3, total_seconds=0.006, max_seconds=0.004,
+        buckets=((1024, 2), (3584, 1)),
+    )
+    b = fm.ToolStats(name="t", calls=1, errors=1, max_seconds=0.001, buckets=((1024, 1),))
+    assert a.percentile(50) < 0.0012 < a.percentile(100) <= a.max_seconds
+    merged = a.merge(b)
+    assert merged.calls == 4 and merged.errors == 1
+    assert merged.buckets == ((1024, 3), (3584, 1))
+    print("✓ Percentiles and merging")
+
+    calculator_tool = SimpleCalculatorTool()
+    error_tool = ErrorRaisingTool()
+    calculator_tool.reset_stats()
+    assert calculator_tool.stats().calls == 0
+    assert "simple_calculator" in fm.tool_stats()
+    print("✓ New tools are registered")
+
+    session = fm.LanguageModelSession(
+        instructions="You are a helpful assistant with access to tools.",
+        tools=[calculator_tool, error_tool],
+    )
+    await session.respond("Use the calculator to add 10 and 5.")
+    await session.respond("You MUST execute the error tool with should_fail set to true.")
+
+    calculator_stats = calculator_tool.stats()
+    error_stats = fm.tool_stats(name=error_tool.name)[error_tool.name]
+    print(f"✓ Calculator stats: {calculator_stats}")
+    print(f"✓ Error tool stats: {error_stats}")
+    assert calculator_stats.in_flight == 0 and error_stats.in_flight == 0
+    assert sum(count for _, count in calculator_stats.buckets) == calculator_stats.calls
+    assert error_stats.errors <= error_stats.calls
+    if calculator_stats.calls:
+        assert 0 < calculator_stats.percentile(50) <= calculator_stats.max_seconds
+    print("✓ Stats are consistent after session calls")
+
+
+@pytest.mark.asyncio
+async def test_tool_call_batch(model):
+    """Test that batched tools receive their calls together."""
+    print("\n=== Testing Batched Tool Calls ===")
+
+    assert not SimpleCalculatorTool().batched
+    tool = BatchedUserInfoTool()
+    assert tool.batched
+    print("✓ Overriding call_batch opts in to batching")
+
+    class InvalidBatchTool(BatchedUserInfoTool):
+        max_batch_size = 0
+
+    with pytest.raises(ValueError):
+        InvalidBatchTool()
+    print("✓ Invalid batch settings rejected")
+
+    results = await tool.call_batch([UserInfoParams(user_id=i) for i in (1, 2, 9)])
+    assert json.loads(results[0])["name"] == "Alice"
+    assert json.loads(results[1])["name"] == "Bob"
+    assert isinstance(results[2], KeyError)
+    assert tool.queries == [[1, 2, 9]]
+    print("✓ Direct call_batch answers every call with one query")
+
+    tool = BatchedUserInfoTool()
+    session = fm.LanguageModelSession(
+        instructions="You are a helpful assistant with access to tools.",
+        model=model,
+        tools=[tool],
+    )
+    finished = []
+    async for event in session.stream_events(
+        "Look up the users with IDs 1, 2 and 3 and list their names."
+    ):
+        if isinstance(event, fm.ToolCallFinished):
+            finished.append(event)
+
+    calls = sum(len(ids) for ids in tool.queries)
+    assert len(finished) == calls
+    assert all(event.outcome == "success" for event in finished)
+    stats = tool.stats()
+    assert stats.calls == calls and stats.in_flight == 0
+    print(f"✓ {calls} calls answered with {len(tool.queries)} queries")
+
+
 @pytest.mark.asyncio
 async def test_tool_parameter_validation():
     """Test tool parameter schema validation."""
@@ -308,6 +536,63 @@ async def test_tool_schema_from_generable():
     print(f"✓ Schema converts to dict: {schema_dict['title']}")
 
 
+@pytest.mark.asyncio
+async def test_tool_typed_arguments(monkeypatch):
+    """Test tools whose call() is annotated with a @generable arguments class."""
+    print("\n=== Testing Typed Tool Arguments ===")
+
+    tool = TypedCalculatorTool()
+
+    # The schema is derived from the annotation on call()
+    assert isinstance(tool.arguments_schema, fm.GenerationSchema)
+    schema_dict = tool.arguments_schema.to_dict()
+    assert set(schema_dict["properties"]) == {"operation", "a", "b"}, (
+        f"Unexpected schema properties: {schema_dict['properties']}"
+    )
+    print("✓ Schema derived from call() annotation")
+
+    # The schema is built once per subclass, however many instances are created
+    builds = []
+    build_schema = CalculatorParams.generation_schema
+
+    def counting_generation_schema(*args, **kwargs):
+        builds.append(1)
+        return build_schema(*args, **kwargs)
+
+    monkeypatch.setattr(CalculatorParams, "generation_schema", counting_generation_schema)
+
+    class CountedCalculatorTool(TypedCalculatorTool):
+        pass
+
+    tools = [CountedCalculatorTool() for _ in range(3)]
+    assert len(builds) == 1, f"Built the arguments schema {len(builds)} times"
+    assert all(t.arguments_schema is tools[0].arguments_schema for t in tools)
+    print("✓ Arguments schema built once per tool class")
+
+    # Arguments are decoded once into the annotated class
+    decoded = tool._decode_arguments({"operation": "multiply", "a": 6.0, "b": 7.0})
+    assert isinstance(decoded, CalculatorParams), f"Unexpected type: {type(decoded)}"
+    result = await tool.call(decoded)
+    assert "42" in result, f"Unexpected calculator result: {result}"
+    print(f"✓ Typed calculator tool: {result}")
+
+    # Untyped tools keep receiving GeneratedContent
+    assert SimpleCalculatorTool()._decode_arguments is None
+    print("✓ GeneratedContent tools are not decoded")
+
+    # A tool with neither a schema nor a typed call() is rejected
+    class UntypedToolWithoutSchema(fm.Tool):
+        name = "untyped_tool"
+        description = "A tool without a schema or typed arguments"
+
+        async def call(self, args) -> str:
+            return "result"
+
+    with pytest.raises(TypeError):
+        UntypedToolWithoutSchema()
+    print("✓ Tool without schema or typed arguments correctly rejected")
+
+
 @pytest.mark.asyncio
 async def test_tool_lifecycle():
     """Test tool lifecycle and cleanup."""
@@ -9,10 +9,15 @@ This test suite verifies:
 2. Transcript behavior after interactions
 3. Pointer lifetime and validity
 4. Error handling in the Swift layer
+5. Streaming JSONL export
 """
 
 import apple_fm_sdk as fm
+import asyncio
+import io
+import json
 import pytest
+import time
 import weakref
 
 
@@ -321,3 +326,71 @@ async def test_multiple_transcript_accesses():
     # All accesses should work without issues
     assert len(transcripts) == 5
     print("✓ All transcript accesses successful")
+
+
+@pytest.mark.asyncio
+async def test_export_jsonl(tmp_path):
+    """Verify export_jsonl writes one entry per line matching to_dict()."""
+    print("\n=== Testing export_jsonl ===")
+
+    model = fm.SystemLanguageModel()
+    is_available, reason = model.is_available()
+    if not is_available:
+        print(f"⚠️  Skipping test - model not available: {reason}")
+        pytest.skip("Model not available")
+
+    session = fm.LanguageModelSession(
+        instructions="You are a helpful assistant.", model=model
+    )
+    await session.respond("Hello!")
+    expected = (await session.transcript.to_dict())["transcript"]["entries"]
+    print(f"✓ Session has {len(expected)} entries")
+
+    # Path destination, written natively through a file descriptor
+    path = tmp_path / "session.jsonl"
+    count = await session.transcript.export_jsonl(path)
+    lines = path.read_text().splitlines()
+    assert count == len(expected) == len(lines)
+    assert [json.loads(line)["role"] for line in lines] == [
+        entry["role"] for entry in expected
+    ]
+    print(f"✓ Exported {count} entries to a path")
+
+    # Binary and text file objects, written through the callback
+    binary = io.BytesIO()
+    assert await session.transcript.export_jsonl(binary) == count
+    assert binary.getvalue().decode("utf-8").splitlines() == lines
+    text = io.StringIO()
+    assert await session.transcript.export_jsonl(text) == count
+    assert text.getvalue().splitlines() == lines
+    print("✓ Exported to binary and text file objects")
+
+    # Exceptions from the file object propagate unchanged
+    class FailingWriter:
+        def write(self, data):
+            raise OSError("disk full")
+
+    with pytest.raises(OSError, match="disk full"):
+        await session.transcript.export_jsonl(FailingWriter())
+    print("✓ Write errors propagate")
+
+    # The export runs off the event loop, so other tasks keep running
+    class SlowWriter:
+        def write(self, data):
+            time.sleep(0.05)
+
+    ticks = 0
+
+    async def tick():
+        nonlocal ticks
+        while True:
+            await asyncio.sleep(0.005)
+            ticks += 1
+
+    ticker = asyncio.create_task(tick())
+    try:
+        assert await session.transcript.export_jsonl(SlowWriter()) == count
+    finally:
+        ticker.cancel()
+    assert ticks >= count, f"Event loop ran only {ticks} times during the export"
+    print(f"✓ Event loop ran {ticks} times during a slow export")
@@ -0,0 +1,135 @@
+# For licensing see accompanying LICENSE file.
+# Copyright (C) 2026 Apple Inc. All Rights Reserved.
+
+"""
+Test the content-addressed transcript archive in apple_fm_sdk.transcript_archive.
+
+This test suite verifies:
+1. Transcripts round-trip to the shape returned by Transcript.to_dict
+2. Shared entries are stored once across sessions
+3. Replacing, compacting and recovering an archive that was not closed
+4. Archiving transcripts from live sessions
+"""
+
+import copy
+import json
+import uuid
+
+import apple_fm_sdk as fm
+import pytest
+
+TRANSCRIPT_FULL = "tests/tester_schemas/test_transcript_full.json"
+
+
+def _session_transcript(index):
+    """Return the sample transcript with fresh ids and a prompt of its own."""
+    with open(TRANSCRIPT_FULL) as f:
+        transcript = json.load(f)
+    for entry in transcript["transcript"]["entries"]:
+        entry["id"] = str(uuid.uuid4()).upper()
+        for content in entry.get("contents", []):
+            content["id"] = str(uuid.uuid4()).upper()
+    prompt = transcript["transcript"]["entries"][1]
+    prompt["contents"][0]["text"] = f"Recipe number {index}?"
+    return transcript
+
+
+def test_round_trip_and_deduplication(tmp_path):
+    """Verify transcripts read back unchanged and shared entries are stored once."""
+    print("\n=== Testing TranscriptArchive - Round Trip ===")
+
+    path = tmp_path / "sessions.fmta"
+    transcripts = {f"session-{i}": _session_transcript(i) for i in range(50)}
+
+    with fm.TranscriptArchive(path, "w") as archive:
+        for session_id, transcript in transcripts.items():
+            archive.add(session_id, copy.deepcopy(transcript))
+
+    with fm.TranscriptArchive(path) as archive:
+        assert archive.session_ids() == list(transcripts)
+        assert "session-7" in archive and "missing" not in archive
+        for session_id, transcript in transcripts.items():
+            assert archive.get(session_id) == transcript
+        print(f"✓ {len(archive)} transcripts read back unchanged")
+
+        stats = archive.stats()
+        # Each session adds only its prompt; the other four entries are shared
+        assert stats.entries == 50 * 5
+        assert stats.unique_entries == 4 + 50
+        print(f"✓ {stats.entries} entries stored as {stats.unique_entries}")
+
+        with pytest.raises(KeyError):
+            archive.get("missing")
+        with pytest.raises(ValueError):
+            archive.add("session-50", _session_transcript(50))
+    print("✓ Read-only archive rejects writes")
+
+    plain = tmp_path / "plain.fmta"
+    with fm.TranscriptArchive(plain, "w", compression=None) as archive:
+        for session_id, transcript in transcripts.items():
+            archive.add(session_id, transcript)
+        plain_bytes = archive.stats().stored_bytes
+    assert path.stat().st_size < plain.stat().st_size
+    print(f"✓ Compression reduced {plain_bytes} bytes to {path.stat().st_size}")
+
+
+def test_replace_compact_and_recover(tmp_path):
+    """Verify replacing sessions, compacting, and reopening after a crash."""
+    print("\n=== Testing TranscriptArchive - Replace and Recover ===")
+
+    path = tmp_path / "sessions.fmta"
+    first, second = _session_transcript(1), _session_transcript(2)
+
+    with fm.TranscriptArchive(path, "a") as archive:
+        archive.add("a", first)
+        archive.add("b", first)
+    with fm.TranscriptArchive(path, "a") as archive:
+        assert archive.add("a", second) == 1
+        assert archive.get("a") == second
+        assert archive.get("b") == first
+    print("✓ Adding an existing session id replaces its transcript")
+
+    with fm.TranscriptArchive(path) as archive:
+        compacted = archive.copy_to(tmp_path / "compacted.fmta")
+        with compacted:
+            assert compacted.session_ids() == ["b", "a"]
+            assert compacted.get("a") == second
+            assert compacted.stats().stored_bytes < archive.stats().stored_bytes
+    print("✓ copy_to drops replaced transcripts")
+
+    # Simulate a writer that stopped before writing its index
+    archive = fm.TranscriptArchive(path, "a")
+    archive.add("c", _session_transcript(3))
+    archive._file.flush()
+    with fm.TranscriptArchive(path) as recovered:
+        assert recovered.session_ids() == ["b", "a", "c"]
+        assert recovered.get("b") == first
+    archive.close()
+    print("✓ Index is rebuilt from records after an unclean close")
+
+    (tmp_path / "other.json").write_text("{}")
+    with pytest.raises(ValueError):
+        fm.TranscriptArchive(tmp_path / "other.json")
+    print("✓ Files that are not archives are rejected")
+
+
+@pytest.mark.asyncio
+async def test_archive_live_sessions(model, tmp_path):
+    """Verify transcripts from live sessions share their instructions entry."""
+    print("\n=== Testing TranscriptArchive - Live Sessions ===")
+
+    path = tmp_path / "live.fmta"
+    with fm.TranscriptArchive(path, "w") as archive:
+        for i in range(3):
+            session = fm.LanguageModelSession(
+                instructions="You are a concise assistant.", model=model
+            )
+            await session.respond(f"Say the number {i}.")
+            transcript = await session.transcript.to_dict()
+            archive.add(f"live-{i}", transcript)
+            assert archive.get(f"live-{i}") == transcript
+        stats = archive.stats()
+
+    assert stats.sessions == 3
+    assert stats.unique_entries < stats.entries
+    print(f"✓ Deduplication ratio {stats.deduplication_ratio:.2f}")
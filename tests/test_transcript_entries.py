@@ -0,0 +1,163 @@
+# For licensing see accompanying LICENSE file.
+# Copyright (C) 2026 Apple Inc. All Rights Reserved.
+
+"""
+Test the typed transcript entry views in apple_fm_sdk.transcript_entries.
+
+This test suite verifies:
+1. Entries are typed by role and decode to the same data as json.load
+2. Filtering by role and tool name
+3. JSONL input as written by Transcript.export_jsonl
+4. Entries fetched from a live session, indexed by the native layer
+5. The benchmark against Transcript.to_dict
+"""
+
+import apple_fm_sdk as fm
+import json
+import os
+import pytest
+import subprocess
+import sys
+from pathlib import Path
+
+TRANSCRIPT_FULL = "tests/tester_schemas/test_transcript_full.json"
+BENCHMARK = Path(__file__).resolve().parent.parent / "benchmarks" / "transcript_entries.py"
+
+
+def test_entry_types_and_decoding():
+    """Verify entry classes and that decoded entries match json.load."""
+    print("\n=== Testing TranscriptEntries - Types ===")
+
+    entries = fm.TranscriptEntries.load(TRANSCRIPT_FULL)
+    with open(TRANSCRIPT_FULL) as f:
+        expected = json.load(f)["transcript"]["entries"]
+
+    assert [type(entry) for entry in entries] == [
+        fm.InstructionsEntry,
+        fm.PromptEntry,
+        fm.ToolCallsEntry,
+        fm.ToolOutputEntry,
+        fm.ResponseEntry,
+    ]
+    print("✓ Entries are typed by role")
+
+    assert [entry.id for entry in entries] == [entry["id"] for entry in expected]
+    assert [entry.to_dict() for entry in entries] == expected
+    print("✓ Decoded entries match json.load")
+
+    assert entries[0].tools[0]["function"]["name"] == "searchBreadDatabaseTool"
+    assert entries[1].text == "What is a basic recipe for a brioche?"
+    assert entries[1].response_format["type"] == "jsonSchema"
+    assert entries[-1].assets
+    print("✓ Typed accessors work")
+
+    with pytest.raises(AttributeError):
+        entries[0].extra = 1
+    print("✓ Entries use __slots__")
+
+
+def test_filter_by_role_and_tool_name():
+    """Verify filtering uses roles and tool names from the index."""
+    print("\n=== Testing TranscriptEntries - Filters ===")
+
+    entries = fm.TranscriptEntries.load(TRANSCRIPT_FULL)
+
+    assert [entry.role for entry in entries.filter(role="response")] == [
+        "response",
+        "response",
+    ]
+    matches = list(entries.filter(tool_name="searchBreadDatabaseTool"))
+    assert [type(entry) for entry in matches] == [
+        fm.ToolCallsEntry,
+        fm.ToolOutputEntry,
+    ]
+    assert list(entries.filter(tool_name="missingTool")) == []
+    print("✓ Filtered by role and tool name")
+
+    call_entry, output_entry = matches
+    (call,) = call_entry.tool_calls
+    assert call.parsed_arguments() == {"searchTerm": "brioche", "limit": 1}
+    assert output_entry.tool_name == call.name
+    assert output_entry.tool_call_id == call.id
+    print("✓ Tool calls link to their outputs")
+
+    # Filtering a loaded transcript reads the index only
+    (output_again,) = entries.filter(role="tool")
+    assert output_again._data is None
+    assert output_again.to_dict() == output_entry.to_dict()
+    print("✓ Entries are decoded on access")
+
+
+def test_jsonl_input():
+    """Verify one-entry-per-line input decodes to the same entries."""
+    with open(TRANSCRIPT_FULL) as f:
+        expected = json.load(f)["transcript"]["entries"]
+    jsonl = "\n".join(json.dumps(entry) for entry in expected) + "\n"
+
+    entries = fm.TranscriptEntries(jsonl, jsonl=True)
+    assert [entry.to_dict() for entry in entries] == expected
+    print("✓ JSONL input matches")
+
+    # Swift does not escape U+2028, which must not split a line
+    line = json.dumps({"id": "a", "role": "user", "note": "\u2028"}, ensure_ascii=False)
+    entries = fm.TranscriptEntries(line + "\n", jsonl=True)
+    assert len(entries) == 1 and entries[0].to_dict()["note"] == "\u2028"
+
+    with pytest.raises(ValueError):
+        fm.TranscriptEntries('{"version": 1}')
+    with pytest.raises(ValueError):
+        fm.TranscriptEntries('{"transcript": {"entries": [{"id": "a"', jsonl=False)
+
+
+@pytest.mark.asyncio
+async def test_session_entries(model):
+    """Verify Transcript.entries() on a live session."""
+    print("\n=== Testing Transcript.entries ===")
+
+    session = fm.LanguageModelSession(
+        instructions="You are a helpful assistant.", model=model
+    )
+    await session.respond("Hello!")
+
+    entries = await session.transcript.entries()
+    expected = (await session.transcript.to_dict())["transcript"]["entries"]
+    assert [entry.role for entry in entries] == [entry["role"] for entry in expected]
+    assert isinstance(entries[0], fm.InstructionsEntry)
+    assert isinstance(entries[-1], fm.ResponseEntry) and entries[-1].text
+    print(f"✓ Got {len(entries)} typed entries")
+
+    # Entries are indexed natively; filtering decodes nothing
+    prompts = list(entries.filter(role="user"))
+    assert all(entry._data is None for entry in entries.filter(role="response"))
+    assert all(entry._data is None for entry in prompts)
+    assert [entry.id for entry in entries] == [entry["id"] for entry in expected]
+    assert [entry.to_dict() for entry in entries] == expected
+    print("✓ Filtering does not decode entries")
+
+
+def test_entries_benchmark(tmp_path):
+    """Verify entries() beats to_dict() in benchmarks/transcript_entries.py."""
+    print("\n=== Testing Transcript Entries Benchmark ===")
+
+    results_path = tmp_path / "results.json"
+    # The benchmark selects the replay backend, so it runs in a fresh interpreter
+    env = dict(os.environ, PYTHONPATH=os.pathsep.join(sys.path))
+    completed = subprocess.run(
+        [
+            sys.executable,
+            str(BENCHMARK),
+            "--entries", "2000",
+            "--repeat", "10",
+            "--json", str(results_path),
+        ],
+        env=env,
+        capture_output=True,
+        text=True,
+        timeout=120,
+    )
+    print(completed.stdout)
+    assert completed.returncode == 0, completed.stdout + completed.stderr
+
+    load = json.loads(results_path.read_text())["results"]["load"]
+    assert load["entries"]["python_ms"] < load["to_dict"]["python_ms"]
+    print("✓ entries() loads faster than to_dict()")
@@ -3,6 +3,7 @@
 
 import asyncio
 import json
+import threading
 import apple_fm_sdk as fm
 
 # =============================================================================
@@ -83,6 +84,27 @@ class SimpleCalculatorTool(fm.Tool):
         return f"The result of {a} {operation} {b} is {result}"
 
 
+class TypedCalculatorTool(fm.Tool):
+    """Calculator tool that receives its arguments as a decoded CalculatorParams."""
+
+    name = "typed_calculator"
+    description = "Perform basic arithmetic operations"
+
+    async def call(self, args: CalculatorParams) -> str:
+        operations = {
+            "add": lambda a, b: a + b,
+            "subtract": lambda a, b: a - b,
+            "multiply": lambda a, b: a * b,
+            "divide": lambda a, b: a / b if b != 0 else None,
+        }
+        if args.operation not in operations:
+            return f"Error: Unknown operation {args.operation}"
+        result = operations[args.operation](args.a, args.b)
+        if result is None:
+            return "Error: Division by zero"
+        return f"The result of {args.a} {args.operation} {args.b} is {result}"
+
+
 class GetUserInfoTool(fm.Tool):
     """Mock user info retrieval tool."""
 
@@ -195,3 +217,60 @@ class AsyncDelayTool(fm.Tool):
 
         await asyncio.sleep(delay)
         return f"After {delay}s delay: {message}"
+
+
+class HangingTool(fm.Tool):
+    """Tool that never returns on its own, used to exercise call timeouts."""
+
+    name = "hanging_tool"
+    description = "Look up the current status of a server"
+    timeout = 1.0
+
+    def __init__(self):
+        self.started = threading.Event()
+        self.cancelled = False
+        super().__init__()
+
+    @property
+    def arguments_schema(self) -> fm.GenerationSchema:
+        return UserInfoParams.generation_schema()
+
+    async def call(self, args: fm.GeneratedContent) -> str:
+        self.started.set()
+        try:
+            await asyncio.sleep(3600)
+        except asyncio.CancelledError:
+            self.cancelled = True
+            raise
+        return "Server is up"
+
+
+class BatchedUserInfoTool(fm.Tool):
+    """User lookup tool that answers a batch of calls with one query."""
+
+    name = "get_user_info"
+    description = "Get information about a user by ID"
+    batch_window = 0.05
+
+    users = {
+        1: {"name": "Alice", "role": "admin"},
+        2: {"name": "Bob", "role": "user"},
+        3: {"name": "Charlie", "role": "user"},
+    }
+
+    def __init__(self):
+        self.queries = []
+        super().__init__()
+
+    async def call(self, args: UserInfoParams) -> str:
+        return (await self.call_batch([args]))[0]
+
+    async def call_batch(self, args: list[UserInfoParams]) -> list:
+        # One "query" for every user in the batch
+        ids = [a.user_id for a in args]
+        self.queries.append(ids)
+        rows = {user_id: self.users.get(user_id) for user_id in ids}
+        return [
+            json.dumps(rows[user_id]) if rows[user_id] else KeyError(f"User {user_id} not found")
+            for user_id in ids
+        ]